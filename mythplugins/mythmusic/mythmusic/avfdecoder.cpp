@@ -19,6 +19,7 @@
 */
 
 // C++ headers
+#include <algorithm>
 #include <chrono>
 
 // QT headers
@@ -26,6 +27,7 @@
 #include <QIODevice>
 #include <QFile>
 #include <QTimer>
+#include <QThread>
 
 // Myth headers
 #include <mythconfig.h>
@@ -55,6 +57,35 @@ extern "C" {
 
 /****************************************************************************/
 
+// How much of the next track to decode while the current one is playing
+static constexpr std::chrono::milliseconds kDecodeAheadTime { 2s };
+
+/** \brief Opens the next track and decodes the start of it in the background.
+
+    Opening and probing a file over the network can take longer than the
+    audio left buffered at the end of the current track, so this is done
+    while the current track is still playing.
+ */
+class avfDecodeAhead : public MThread
+{
+  public:
+    explicit avfDecodeAhead(avfDecoder *decoder)
+        : MThread("avfDecodeAhead"), m_decoder(decoder) {}
+
+  protected:
+    void run() override // MThread
+    {
+        RunProlog();
+        m_decoder->decodeAhead();
+        RunEpilog();
+    }
+
+  private:
+    avfDecoder *m_decoder {nullptr};
+};
+
+/****************************************************************************/
+
 using ShoutCastMetaMap = QMap<QString,QString>;
 
 class ShoutCastMetaParser
@@ -244,6 +275,13 @@ avfDecoder::~avfDecoder(void)
 {
     delete m_mdataTimer;
 
+    if (m_decodeAhead)
+    {
+        m_userStop = true;
+        m_decodeAhead->wait();
+        delete m_decodeAhead;
+    }
+
     if (m_inited)
         deinit();
 
@@ -258,12 +296,55 @@ void avfDecoder::stop()
     m_userStop = true;
 }
 
+bool avfDecoder::setNext(Decoder *next)
+{
+    auto *decoder = dynamic_cast<avfDecoder*>(next);
+    if (next && !decoder)
+        return false;
+
+    QMutexLocker locker(getMutex());
+
+    if (m_handingOver || m_handedOver)
+        return false;
+
+    m_next = decoder;
+
+    if (m_next && !m_next->m_decodeAhead)
+    {
+        m_next->m_decodeAhead = new avfDecodeAhead(m_next);
+        m_next->m_decodeAhead->start();
+    }
+
+    return true;
+}
+
+void avfDecoder::stopAndDelete(void)
+{
+    stop();
+
+    // opening a remote file can't be interrupted, so rather than wait for
+    // that on the UI thread leave the decode ahead thread to finish first
+    if (m_decodeAhead && !m_decodeAhead->isFinished())
+    {
+        connect(m_decodeAhead->qthread(), &QThread::finished,
+                this, &QObject::deleteLater);
+        if (m_decodeAhead->isFinished())
+            deleteLater();
+        return;
+    }
+
+    wait();
+    delete this;
+}
+
 bool avfDecoder::initialize()
 {
     m_inited = m_userStop = m_finish = false;
     m_freq = m_bitrate = 0;
     m_stat = m_channels = 0;
     m_seekTime = -1.0;
+    m_next = nullptr;
+    m_handingOver = m_handedOver = false;
 
     // give up if we dont have an audiooutput set
     if (!output())
@@ -319,12 +400,28 @@ bool avfDecoder::initialize()
         }
     }
 
+    QString message;
+    if (!openCodec(message))
+    {
+        error(message);
+        deinit();
+        return false;
+    }
+
+    configureOutput();
+
+    m_inited = true;
+    return true;
+}
+
+/// Find the audio stream of the open input and open its codec
+bool avfDecoder::openCodec(QString &message)
+{
     // determine the stream format
     // this also populates information needed for metadata
     if (avformat_find_stream_info(m_inputContext->getContext(), nullptr) < 0)
     {
-        error("Could not determine the stream format.");
-        deinit();
+        message = "Could not determine the stream format.";
         return false;
     }
 
@@ -336,8 +433,7 @@ bool avfDecoder::initialize()
 
     if (selTrack < 0)
     {
-        error(QString("Could not find audio stream."));
-        deinit();
+        message = "Could not find audio stream.";
         return false;
     }
 
@@ -350,9 +446,8 @@ bool avfDecoder::initialize()
 
     if (avcodec_open2(m_audioDec, codec, nullptr) < 0)
     {
-        error(QString("Could not open audio codec: %1")
-            .arg(m_audioDec->codec_id));
-        deinit();
+        message = QString("Could not open audio codec: %1")
+            .arg(m_audioDec->codec_id);
         return false;
     }
 
@@ -361,32 +456,207 @@ bool avfDecoder::initialize()
 
     if (m_channels <= 0)
     {
-        error(QString("AVCodecContext tells us %1 channels are "
-                                      "available, this is bad, bailing.")
-                                      .arg(m_channels));
-        deinit();
+        message = QString("AVCodecContext tells us %1 channels are "
+                          "available, this is bad, bailing.")
+                          .arg(m_channels);
         return false;
     }
 
-    AudioFormat format =
+    m_format =
         AudioOutputSettings::AVSampleFormatToFormat(m_audioDec->sample_fmt,
                                                     m_audioDec->bits_per_raw_sample);
-    if (format == FORMAT_NONE)
+    if (m_format == FORMAT_NONE)
     {
-        error(QString("Error: Unsupported sample format: %1")
-              .arg(av_get_sample_fmt_name(m_audioDec->sample_fmt)));
-        deinit();
+        message = QString("Error: Unsupported sample format: %1")
+              .arg(av_get_sample_fmt_name(m_audioDec->sample_fmt));
         return false;
     }
 
-    const AudioSettings settings(format, m_audioDec->channels,
+    return true;
+}
+
+void avfDecoder::configureOutput(void)
+{
+    const AudioSettings settings(m_format, m_audioDec->channels,
                                  m_audioDec->codec_id,
                                  m_audioDec->sample_rate, false);
 
     output()->Reconfigure(settings);
     output()->SetSourceBitrate(m_audioDec->bit_rate);
+}
+
+/// Wait until the output needs more samples
+void avfDecoder::waitForOutput(void)
+{
+    while (!m_userStop && m_seekTime <= 0.0)
+    {
+        std::chrono::milliseconds buffered = output()->GetAudioBufferedTime();
+        // never go below 1s buffered
+        if (buffered < 1s)
+            break;
+        // wait
+        const struct timespec ns {0, (buffered.count() - 1000) * 1000000};
+        nanosleep(&ns, nullptr);
+    }
+}
+
+/** \brief Open the track and decode the first kDecodeAheadTime of it.
+
+    Runs in avfDecodeAhead while the previous track is still playing, so
+    this mustn't touch the output, which is still in use, and any errors
+    are only logged. The previous decoder falls back to draining the
+    output if this fails, and the track is then tried again as usual.
+    The output's own DecodeAudio() isn't thread safe, but as the output
+    accepts every sample format it only interleaves, which
+    AudioOutputUtil::DecodeAudio() does just the same.
+ */
+void avfDecoder::decodeAhead(void)
+{
+    m_inited = m_finish = false;
+    m_freq = m_bitrate = 0;
+    m_stat = m_channels = 0;
+    m_seekTime = -1.0;
+    m_aheadData.clear();
+
+    QString message;
+    delete m_inputContext;
+    m_inputContext = new RemoteAVFormatContext(getURL());
+
+    if (!m_inputContext->isOpen())
+        message = QString("Could not open url  (%1)").arg(m_url);
+    else if (m_outputBuffer && openCodec(message))
+    {
+        int bytesPerSecond = static_cast<int>(m_freq) * m_channels *
+            AudioOutputSettings::SampleSize(m_format);
+        int wanted = static_cast<int>(bytesPerSecond * kDecodeAheadTime.count() / 1000);
+        int decoded = 0;
+
+        AVPacket pkt;
+        AVPacket tmp_pkt;
+        memset(&pkt, 0, sizeof(AVPacket));
+        av_init_packet(&pkt);
+
+        while (!m_userStop && decoded < wanted)
+        {
+            if (av_read_frame(m_inputContext->getContext(), &pkt) < 0)
+            {
+                // a track this short is all decoded already
+                m_finish = true;
+                break;
+            }
+
+            av_init_packet(&tmp_pkt);
+            tmp_pkt.data = pkt.data;
+            tmp_pkt.size = pkt.size;
+
+            while (tmp_pkt.size > 0 && !m_userStop)
+            {
+                int data_size = 0;
+
+                int ret = AudioOutputUtil::DecodeAudio(m_audioDec,
+                                                       m_outputBuffer,
+                                                       data_size,
+                                                       &tmp_pkt);
+                if (ret < 0)
+                    break;
+
+                tmp_pkt.size -= ret;
+                tmp_pkt.data += ret;
+
+                if (data_size <= 0)
+                    continue;
+
+                m_aheadData.append(QByteArray(reinterpret_cast<char*>(m_outputBuffer),
+                                              data_size));
+                decoded += data_size;
+            }
+
+            av_packet_unref(&pkt);
+        }
+
+        if (!m_userStop)
+        {
+            LOG(VB_PLAYBACK, LOG_INFO,
+                QString("avfDecoder: decoded %1 bytes of %2 ahead")
+                    .arg(decoded).arg(m_url));
+            m_inited = true;
+            return;
+        }
+        message = "Stopped";
+    }
+
+    LOG(VB_PLAYBACK, LOG_WARNING,
+        QString("avfDecoder: couldn't decode %1 ahead: %2")
+            .arg(m_url).arg(message));
+    deinit();
+}
+
+/** \brief Hand the output over to the decoder lined up with setNext().
+
+    The next decoder carries on straight after our last sample, unless
+    the two tracks' formats differ, when the output has to be drained and
+    reconfigured first. Returns false, so that the output is drained as
+    usual, if there's no next decoder or it isn't ready in time.
+ */
+bool avfDecoder::handOver(void)
+{
+    avfDecoder *next = nullptr;
+    {
+        // keep the next decoder from being cancelled while waiting for it
+        QMutexLocker locker(getMutex());
+        next = m_next;
+        if (!next || !next->m_decodeAhead)
+            return false;
+        m_handingOver = true;
+    }
+
+    auto failed = [this]()
+    {
+        QMutexLocker locker(getMutex());
+        m_handingOver = false;
+        return false;
+    };
+
+    // wait no longer than the audio still buffered lasts
+    std::chrono::milliseconds buffered = output()->GetAudioBufferedTime();
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!next->m_decodeAhead->wait(50ms))
+    {
+        if (m_userStop || timer.hasExpired(buffered.count()))
+        {
+            LOG(VB_PLAYBACK, LOG_INFO,
+                QString("avfDecoder: %1 isn't ready in time")
+                    .arg(next->getURL()));
+            return failed();
+        }
+    }
+
+    if (!next->m_inited)
+        return failed();
+
+    if (next->m_freq != m_freq || next->m_channels != m_channels ||
+        next->m_format != m_format)
+    {
+        LOG(VB_PLAYBACK, LOG_INFO,
+            "avfDecoder: next track has a different format, draining");
+        output()->Drain();
+        output()->PauseUntilBuffered();
+    }
+
+    {
+        QMutexLocker locker(getMutex());
+        m_handingOver = false;
+        m_handedOver = true;
+    }
+
+    next->m_handOverTimer = timer;
+    next->m_handOverBuffered = buffered;
+    next->m_following = true;
+    next->setOutput(output());
+    next->start();
 
-    m_inited = true;
     return true;
 }
 
@@ -440,6 +710,32 @@ void avfDecoder::run()
         dispatch(e);
     }
 
+    if (m_following)
+    {
+        // Carry straight on from the previous track's last sample. The gap
+        // is however much longer than its remaining audio this took.
+        configureOutput();
+
+        std::chrono::milliseconds start = output()->GetAudioQueuedTime();
+        std::chrono::milliseconds gap =
+            std::max(std::chrono::milliseconds(m_handOverTimer.elapsed()) -
+                     m_handOverBuffered, 0ms);
+
+        {
+            DecoderEvent e(DecoderEvent::NextTrack, start, gap);
+            dispatch(e);
+        }
+
+        for (QByteArray &data : m_aheadData)
+        {
+            if (m_userStop)
+                break;
+            output()->AddData(data.data(), data.size(), -1ms, 0);
+            waitForOutput();
+        }
+        m_aheadData.clear();
+    }
+
     av_read_play(m_inputContext->getContext());
 
     while (!m_finish && !m_userStop)
@@ -503,27 +799,22 @@ void avfDecoder::run()
             av_packet_unref(&pkt);
 
             // Wait until we need to decode or supply more samples
-            while (!m_finish && !m_userStop && m_seekTime <= 0.0)
-            {
-                std::chrono::milliseconds buffered = output()->GetAudioBufferedTime();
-                // never go below 1s buffered
-                if (buffered < 1s)
-                    break;
-                // wait
-                const struct timespec ns {0, (buffered.count() - 1000) * 1000000};
-                nanosleep(&ns, nullptr);
-            }
+            waitForOutput();
         }
     }
 
+    bool handedOver = false;
     if (m_userStop)
     {
         m_inited = false;
     }
     else
     {
+        handedOver = handOver();
+
         // Drain ao buffer, making sure we play all remaining audio samples
-        output()->Drain();
+        if (!handedOver)
+            output()->Drain();
     }
 
     if (m_finish)
@@ -531,6 +822,8 @@ void avfDecoder::run()
     else if (m_userStop)
         m_stat = DecoderEvent::Stopped;
 
+    // the next decoder says when it has taken over
+    if (!handedOver)
     {
         DecoderEvent e((DecoderEvent::Type) m_stat);
         dispatch(e);
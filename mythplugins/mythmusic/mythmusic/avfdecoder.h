@@ -1,8 +1,11 @@
 #ifndef AVFECODER_H_
 #define AVFECODER_H_
 
+#include <chrono>
 #include <cstdint>
 
+#include <QElapsedTimer>
+#include <QList>
 #include <QObject>
 
 #include "decoder.h"
@@ -11,6 +14,7 @@
 #include "remoteavformatcontext.h"
 
 class QTimer;
+class avfDecodeAhead;
 
 class avfDecoder : public QObject, public Decoder
 {
@@ -24,13 +28,22 @@ class avfDecoder : public QObject, public Decoder
     double lengthInSeconds();
     void seek(double pos) override; // Decoder
     void stop() override; // Decoder
+    bool setNext(Decoder *next) override; // Decoder
+    void stopAndDelete(void) override; // Decoder
 
   protected slots:
     void checkMetatdata(void);
 
   private:
+    friend class avfDecodeAhead;
+
     void run() override; // MThread
 
+    bool openCodec(QString &message);
+    void configureOutput(void);
+    void waitForOutput(void);
+    void decodeAhead(void);
+    bool handOver(void);
     void deinit();
 
     bool m_inited                         {false};
@@ -42,6 +55,7 @@ class avfDecoder : public QObject, public Decoder
     long m_freq                           {0};
     long m_bitrate                        {0};
     int m_channels                        {0};
+    AudioFormat m_format                  {FORMAT_NONE};
     double m_seekTime                     {-1.0};
 
     QString m_devicename;
@@ -57,6 +71,16 @@ class avfDecoder : public QObject, public Decoder
     QString m_lastMetadata;
 
     int m_errCode                         {0};
+
+    // gapless playback, see setNext()
+    avfDecoder *m_next                    {nullptr};
+    bool m_handingOver                    {false};
+    bool m_handedOver                     {false};
+    avfDecodeAhead *m_decodeAhead         {nullptr};
+    QList<QByteArray> m_aheadData;
+    bool m_following                      {false};
+    QElapsedTimer m_handOverTimer;
+    std::chrono::milliseconds m_handOverBuffered {0};
 };
 
 #endif
@@ -29,6 +29,8 @@ QEvent::Type DecoderEvent::Finished =
     (QEvent::Type) QEvent::registerEventType();
 QEvent::Type DecoderEvent::Error =
     (QEvent::Type) QEvent::registerEventType();
+QEvent::Type DecoderEvent::NextTrack =
+    (QEvent::Type) QEvent::registerEventType();
 
 Decoder::~Decoder()
 {
@@ -36,6 +38,13 @@ Decoder::~Decoder()
     m_out = nullptr;
 }
 
+void Decoder::stopAndDelete(void)
+{
+    stop();
+    wait();
+    delete this;
+}
+
 /*
 QString Decoder::getURL(void)
 {
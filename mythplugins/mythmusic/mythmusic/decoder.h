@@ -3,6 +3,8 @@
 #ifndef DECODER_H_
 #define DECODER_H_
 
+#include <chrono>
+
 #include <QWaitCondition>
 #include <QStringList>
 #include <QEvent>
@@ -31,6 +33,9 @@ class DecoderEvent : public MythEvent
   public:
     explicit DecoderEvent(Type type) : MythEvent(type) { ; }
     explicit DecoderEvent(QString *e) : MythEvent(Error), m_errorMsg(e) { ; }
+    DecoderEvent(Type type, std::chrono::milliseconds start,
+                 std::chrono::milliseconds gap)
+        : MythEvent(type), m_start(start), m_gap(gap) { ; }
 
     ~DecoderEvent() override
     {
@@ -38,6 +43,10 @@ class DecoderEvent : public MythEvent
     }
 
     const QString *errorMessage() const { return m_errorMsg; }
+    /// Output timecode at which the next track's first sample plays
+    std::chrono::milliseconds start() const { return m_start; }
+    /// Silence heard between the two tracks
+    std::chrono::milliseconds gap() const { return m_gap; }
 
     DecoderEvent &operator=(const DecoderEvent&) = delete;
 
@@ -48,9 +57,11 @@ class DecoderEvent : public MythEvent
     static Type Stopped;
     static Type Finished;
     static Type Error;
+    static Type NextTrack;
 
   private:
-    DecoderEvent(const DecoderEvent &o) : MythEvent(o)
+    DecoderEvent(const DecoderEvent &o)
+        : MythEvent(o), m_start(o.m_start), m_gap(o.m_gap)
     {
         if (o.m_errorMsg)
         {
@@ -60,6 +71,8 @@ class DecoderEvent : public MythEvent
 
   private:
     QString *m_errorMsg {nullptr};
+    std::chrono::milliseconds m_start {0};
+    std::chrono::milliseconds m_gap   {0};
 };
 
 class Decoder : public MThread, public MythObservable
@@ -71,6 +84,17 @@ class Decoder : public MThread, public MythObservable
     virtual void seek(double) = 0;
     virtual void stop() = 0;
 
+    /// Line up \p next to take over the output, without draining it, when
+    /// this decoder reaches the end of its input. \p next then opens its
+    /// track and decodes the start of it in the background, and sends a
+    /// DecoderEvent::NextTrack once it has taken over. Returns false if
+    /// that isn't supported or this decoder has already handed over.
+    virtual bool setNext(Decoder */*next*/) { return false; }
+
+    /// Stop the decoder and delete it once its threads have finished,
+    /// which may be later on if it can't be interrupted straight away.
+    virtual void stopAndDelete(void);
+
     DecoderFactory *factory() const { return m_fctry; }
 
     AudioOutput *output() { return m_out; }
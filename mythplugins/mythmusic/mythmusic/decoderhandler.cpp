@@ -89,6 +89,134 @@ void DecoderHandler::start(MusicMetadata *mdata)
     createPlaylist(m_url);
 }
 
+/** \brief Line up the track after the current one to follow it without a gap.
+
+    The track is opened and the start of it decoded in the background, and
+    the current decoder hands the output over to it when it finishes. Only
+    single files can be lined up, not playlists, and only by decoders that
+    support it, and passing nullptr cancels the lined up track if it hasn't
+    been handed over yet.
+    Listeners added with addDecoderListener() are added to it. Returns the
+    new decoder, or nullptr if nothing new was lined up.
+ */
+Decoder *DecoderHandler::decodeAhead(MusicMetadata *mdata)
+{
+    if (m_next && mdata && m_nextMeta.ID() == mdata->ID() &&
+        m_nextMeta.Filename(false) == mdata->Filename(false))
+        return nullptr;
+
+    stopNext();
+
+    if (!mdata || !m_decoder || m_next)
+        return nullptr;
+
+    QUrl url;
+    if (QFileInfo(mdata->Filename()).isAbsolute())
+        url = QUrl::fromLocalFile(mdata->Filename());
+    else
+        url.setUrl(mdata->Filename());
+
+    QString extension = QFileInfo(url.path()).suffix().toLower();
+    if (extension.isEmpty() || extension == "pls" || extension == "m3u" ||
+        extension == "asx")
+        return nullptr;
+
+    Decoder *decoder = Decoder::create("." + extension, nullptr, true);
+    if (!decoder)
+        return nullptr;
+
+    decoder->setURL(url.toString());
+
+    if (!m_decoder->setNext(decoder))
+    {
+        delete decoder;
+        return nullptr;
+    }
+
+    for (QObject *listener : qAsConst(m_decoderListeners))
+        decoder->addListener(listener);
+
+    LOG(VB_PLAYBACK, LOG_INFO, QString("Decoding '%1' ahead").arg(url.toString()));
+
+    m_next = decoder;
+    m_nextMeta = *mdata;
+
+    return m_next;
+}
+
+/** \brief Make the decoder lined up by decodeAhead() the current one.
+
+    Called once it has taken over the output, which it announces with a
+    DecoderEvent::NextTrack.
+ */
+bool DecoderHandler::handOver(void)
+{
+    if (!m_next || !m_next->isRunning())
+        return false;
+
+    if (m_decoder)
+    {
+        m_decoder->wait();
+        delete m_decoder;
+    }
+
+    m_decoder = m_next;
+    m_next = nullptr;
+    m_meta = m_nextMeta;
+    m_url.setUrl(m_decoder->getURL());
+
+    m_playlist.clear();
+    auto *entry = new PlayListFileEntry;
+    entry->setFile(m_url.isLocalFile() ? m_url.toLocalFile() : m_url.toString());
+    m_playlist.add(entry);
+    m_playlistPos = 0;
+    m_redirects = 0;
+    m_state = ACTIVE;
+
+    LOG(VB_PLAYBACK, LOG_INFO, QString("Now playing '%1'").arg(m_url.toString()));
+
+    return true;
+}
+
+void DecoderHandler::stopNext(void)
+{
+    if (!m_next)
+        return;
+
+    // once handed over it's left to be the current decoder
+    if (m_decoder && !m_decoder->setNext(nullptr))
+        return;
+
+    m_next->stopAndDelete();
+    m_next = nullptr;
+}
+
+/** \brief Add a listener to the current decoder and any lined up after it.
+
+    Listeners are remembered so that they are also added to decoders lined
+    up later on.
+ */
+void DecoderHandler::addDecoderListener(QObject *listener)
+{
+    if (!m_decoderListeners.contains(listener))
+        m_decoderListeners.append(listener);
+
+    if (m_decoder)
+        m_decoder->addListener(listener);
+    if (m_next)
+        m_next->addListener(listener);
+}
+
+void DecoderHandler::removeDecoderListener(QObject *listener)
+{
+    m_decoderListeners.removeAll(listener);
+
+    if (m_decoder)
+        m_decoder->removeListener(listener);
+    if (m_next)
+        m_next->removeListener(listener);
+}
+
 void DecoderHandler::doStart(bool result)
 {
     doOperationStop();
@@ -198,6 +326,13 @@ void DecoderHandler::stop(void)
         m_decoder = nullptr;
     }
 
+    // the current decoder has gone, so the next can't be handed over to
+    if (m_next)
+    {
+        m_next->stopAndDelete();
+        m_next = nullptr;
+    }
+
     doOperationStop();
 
     m_state = STOPPED;
@@ -85,6 +85,10 @@ class DecoderHandler : public QObject, public MythObservable
     Decoder *getDecoder(void) { return m_decoder; }
 
     void start(MusicMetadata *mdata);
+    Decoder *decodeAhead(MusicMetadata *mdata);
+    bool handOver(void);
+    void addDecoderListener(QObject *listener);
+    void removeDecoderListener(QObject *listener);
 
     void stop(void);
     void customEvent(QEvent *e) override; // QObject
@@ -109,12 +113,16 @@ class DecoderHandler : public QObject, public MythObservable
     void createPlaylistForSingleFile(const QUrl &url);
     void createPlaylistFromFile(const QUrl &url);
     void createPlaylistFromRemoteUrl(const QUrl &url);
+    void stopNext(void);
 
     int               m_state        {STOPPED};
     int               m_playlistPos  {0};
     PlayListFile      m_playlist;
     Decoder          *m_decoder      {nullptr};
+    Decoder          *m_next         {nullptr};
     MusicMetadata     m_meta;
+    MusicMetadata     m_nextMeta;
+    QList<QObject*>   m_decoderListeners;
     QUrl              m_url;
     bool              m_op           {false};
     uint              m_redirects    {0};
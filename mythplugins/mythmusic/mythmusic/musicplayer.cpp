@@ -145,11 +145,11 @@ void MusicPlayer::addListener(QObject *listener)
     if (listener && m_output)
         m_output->addListener(listener);
 
-    if (listener && getDecoder())
-        getDecoder()->addListener(listener);
-
     if (listener && m_decoderHandler)
+    {
+        m_decoderHandler->addDecoderListener(listener);
         m_decoderHandler->addListener(listener);
+    }
 
     MythObservable::addListener(listener);
 
@@ -161,11 +161,11 @@ void MusicPlayer::removeListener(QObject *listener)
     if (listener && m_output)
         m_output->removeListener(listener);
 
-    if (listener && getDecoder())
-        getDecoder()->removeListener(listener);
-
     if (listener && m_decoderHandler)
+    {
+        m_decoderHandler->removeDecoderListener(listener);
         m_decoderHandler->removeListener(listener);
+    }
 
     MythObservable::removeListener(listener);
 
@@ -252,17 +252,18 @@ void MusicPlayer::stop(bool stopAll)
     }
 
     m_isPlaying = false;
+    m_gapTimer.invalidate();
 
-    if (stopAll && getDecoder())
+    if (stopAll && m_decoderHandler)
     {
-        getDecoder()->removeListener(this);
+        m_decoderHandler->removeDecoderListener(this);
 
-        // remove any listeners from the decoder
+        // remove any listeners from the decoders
         {
             QMutexLocker locker(m_lock);
             // NOLINTNEXTLINE(modernize-loop-convert)
             for (auto it = m_listeners.begin(); it != m_listeners.end() ; ++it)
-                getDecoder()->removeListener(*it);
+                m_decoderHandler->removeDecoderListener(*it);
         }
     }
 
@@ -353,6 +354,8 @@ void MusicPlayer::play(void)
 
 void MusicPlayer::stopDecoder(void)
 {
+    m_nextTrackStart = -1s;
+
     if (getDecoderHandler())
         getDecoderHandler()->stop();
 }
@@ -796,7 +799,16 @@ void MusicPlayer::customEvent(QEvent *event)
         }
     }
 
-    if (event->type() == OutputEvent::Error)
+    if (event->type() == OutputEvent::Playing)
+    {
+        // a track has started after the output was drained
+        if (m_gapTimer.isValid())
+        {
+            setTrackGap(std::chrono::milliseconds(m_gapTimer.elapsed()));
+            m_gapTimer.invalidate();
+        }
+    }
+    else if (event->type() == OutputEvent::Error)
     {
         auto *aoe = dynamic_cast<OutputEvent *>(event);
 
@@ -869,10 +881,10 @@ void MusicPlayer::customEvent(QEvent *event)
         if (!oe)
             return;
 
-        if (m_playMode != PLAYMODE_RADIO)
-            m_currentTime = oe->elapsedSeconds();
-        else
-            m_currentTime = oe->elapsedSeconds() - m_lastTrackStart;
+        if (m_nextTrackStart >= 0s && oe->elapsedSeconds() >= m_nextTrackStart)
+            nextTrackStarted();
+
+        m_currentTime = oe->elapsedSeconds() - m_lastTrackStart;
 
         if (m_playMode != PLAYMODE_RADIO && !m_updatedLastplay)
         {
@@ -907,27 +919,26 @@ void MusicPlayer::customEvent(QEvent *event)
         }
         else
         {
-            auto metadataSecs = duration_cast<std::chrono::seconds>(getCurrentMetadata()->Length());
-            if (m_playMode != PLAYMODE_RADIO && getCurrentMetadata() &&
-                m_currentTime != metadataSecs)
-            {
-                LOG(VB_GENERAL, LOG_NOTICE, QString("MusicPlayer: Updating track length was %1s, should be %2s")
-                    .arg(metadataSecs.count()).arg(m_currentTime.count()));
-
-                getCurrentMetadata()->setLength(m_currentTime);
-                getCurrentMetadata()->dumpToDatabase();
+            updateTrackLength();
 
-                // this will update any track lengths displayed on screen
-                gPlayer->sendMetadataChangedEvent(getCurrentMetadata()->ID());
-
-                // this will force the playlist stats to update
-                MusicPlayerEvent me(MusicPlayerEvent::TrackChangeEvent, m_currentTrack);
-                dispatch(me);
-            }
+            // time the silence until the next track starts playing
+            m_gapTimer.start();
 
             nextAuto();
         }
     }
+    else if (event->type() == DecoderEvent::NextTrack)
+    {
+        auto *dxe = dynamic_cast<DecoderEvent *>(event);
+
+        if (!dxe || !getDecoderHandler() || !getDecoderHandler()->handOver())
+            return;
+
+        // the previous track is still playing out, so only switch to the
+        // next one once the output reaches it
+        m_nextTrackStart = std::chrono::ceil<std::chrono::seconds>(dxe->start());
+        setTrackGap(dxe->gap());
+    }
     else if (event->type() == DecoderEvent::Stopped)
     {
     }
@@ -1108,11 +1119,18 @@ void MusicPlayer::seek(std::chrono::seconds pos)
 {
     if (m_output)
     {
+        // the decoder has already moved on to the next track
+        if (m_nextTrackStart >= 0s)
+            nextTrackStarted();
+
         Decoder *decoder = getDecoder();
         if (decoder && decoder->isRunning())
             decoder->seek(pos.count());
 
         m_output->SetTimecode(pos);
+
+        if (m_playMode != PLAYMODE_RADIO)
+            m_lastTrackStart = 0s;
     }
 }
 
@@ -1208,6 +1226,8 @@ MusicPlayer::RepeatMode MusicPlayer::toggleRepeatMode(void)
             break;
     }
 
+    decodeAhead();
+
     return m_repeatMode;
 }
 
@@ -1265,6 +1285,8 @@ void MusicPlayer::setShuffleMode(ShuffleMode mode)
             }
         }
     }
+
+    decodeAhead();
 }
 
 void MusicPlayer::updateLastplay()
@@ -1481,7 +1503,10 @@ void MusicPlayer::activePlaylistChanged(int trackID, bool deleted)
     {
         m_currentTrack = -1;
         stop(true);
+        return;
     }
+
+    decodeAhead();
 }
 
 void MusicPlayer::playlistChanged(int playlistID)
@@ -1528,14 +1553,14 @@ void MusicPlayer::decoderHandlerReady(void)
 
     decoder->setOutput(m_output);
     //decoder-> setBlockSize(2 * 1024);
-    decoder->addListener(this);
+    m_decoderHandler->addDecoderListener(this);
 
-    // add any listeners to the decoder
+    // add any listeners to the decoder and any lined up after it
     {
         QMutexLocker locker(m_lock);
         // NOLINTNEXTLINE(modernize-loop-convert)
         for (auto it = m_listeners.begin(); it != m_listeners.end() ; ++it)
-            decoder->addListener(*it);
+            m_decoderHandler->addDecoderListener(*it);
     }
 
     m_currentTime = 0s;
@@ -1576,6 +1601,112 @@ void MusicPlayer::decoderHandlerReady(void)
     // tell any listeners we've started playing a new track
     MusicPlayerEvent me(MusicPlayerEvent::TrackChangeEvent, m_currentTrack);
     dispatch(me);
+
+    decodeAhead();
+}
+
+/// line up the next track to follow on from the current one without a gap
+void MusicPlayer::decodeAhead(void)
+{
+    if (!getDecoderHandler() || !getDecoder())
+        return;
+
+    MusicMetadata *mdata = nullptr;
+    if (!m_oneshotMetadata)
+        mdata = getNextMetadata();
+
+    if (mdata && mdata->Filename() == METADATA_INVALID_FILENAME)
+        mdata = nullptr;
+
+    // remember where it is, the same track may be in the playlist twice
+    m_nextTrackPos = -1;
+    if (mdata)
+    {
+        if (m_repeatMode == REPEAT_TRACK)
+            m_nextTrackPos = m_currentTrack;
+        else if (m_currentTrack < getCurrentPlaylist()->getTrackCount() - 1)
+            m_nextTrackPos = m_currentTrack + 1;
+        else
+            m_nextTrackPos = 0;
+    }
+
+    // the decoder handler adds our listeners to it
+    getDecoderHandler()->decodeAhead(mdata);
+}
+
+/// the track lined up by decodeAhead() has reached the output
+void MusicPlayer::nextTrackStarted(void)
+{
+    std::chrono::seconds start = m_nextTrackStart;
+    m_nextTrackStart = -1s;
+
+    updateTrackLength();
+
+    int trackPos = -1;
+    if (getCurrentPlaylist())
+    {
+        MusicMetadata::IdType id = getDecoderHandler()->getMetadata().ID();
+        MusicMetadata *mdata = getCurrentPlaylist()->getSongAt(m_nextTrackPos);
+        if (mdata && mdata->ID() == id)
+            trackPos = m_nextTrackPos;
+        else
+            trackPos = getCurrentPlaylist()->getTrackPosition(id);
+    }
+    m_nextTrackPos = -1;
+
+    changeCurrentTrack(trackPos);
+
+    if (!getCurrentMetadata())
+    {
+        stop();
+        return;
+    }
+
+    m_currentTime = 0s;
+    m_lastTrackStart = start;
+    m_updatedLastplay = false;
+
+    // tell any listeners we've started playing a new track
+    MusicPlayerEvent me(MusicPlayerEvent::TrackChangeEvent, m_currentTrack);
+    dispatch(me);
+
+    decodeAhead();
+
+    // if we don't already have a gui attached show the miniplayer if configured to do so
+    if (m_isAutoplay && m_autoShowPlayer && m_isPlaying)
+        showMiniPlayer();
+}
+
+/// correct the current track's length if it played for a different time
+void MusicPlayer::updateTrackLength(void)
+{
+    if (m_playMode == PLAYMODE_RADIO || !getCurrentMetadata())
+        return;
+
+    auto metadataSecs = duration_cast<std::chrono::seconds>(getCurrentMetadata()->Length());
+    if (m_currentTime == metadataSecs)
+        return;
+
+    LOG(VB_GENERAL, LOG_NOTICE, QString("MusicPlayer: Updating track length was %1s, should be %2s")
+        .arg(metadataSecs.count()).arg(m_currentTime.count()));
+
+    getCurrentMetadata()->setLength(m_currentTime);
+    getCurrentMetadata()->dumpToDatabase();
+
+    // this will update any track lengths displayed on screen
+    gPlayer->sendMetadataChangedEvent(getCurrentMetadata()->ID());
+
+    // this will force the playlist stats to update
+    MusicPlayerEvent me(MusicPlayerEvent::TrackChangeEvent, m_currentTrack);
+    dispatch(me);
+}
+
+void MusicPlayer::setTrackGap(std::chrono::milliseconds gap)
+{
+    m_trackGap = gap;
+
+    LOG(VB_PLAYBACK, LOG_INFO, QString("MusicPlayer: gap between tracks %1ms")
+        .arg(gap.count()));
 }
 
 void MusicPlayer::removeTrack(int trackID)
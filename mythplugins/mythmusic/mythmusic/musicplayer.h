@@ -1,6 +1,9 @@
 #ifndef MUSICPLAYER_H_
 #define MUSICPLAYER_H_
 
+// qt
+#include <QElapsedTimer>
+
 // mythtv
 #include <audiooutput.h>
 #include <mythobservable.h>
@@ -134,6 +137,8 @@ class MusicPlayer : public QObject, public MythObservable
     void         changeCurrentTrack(int trackNo);
 
     std::chrono::seconds getCurrentTrackTime(void) const { return m_currentTime; }
+    /// the silence measured between the last two tracks played
+    std::chrono::milliseconds getTrackGap(void) const { return m_trackGap; }
 
     void         activePlaylistChanged(int trackID, bool deleted);
     void         playlistChanged(int playlistID);
@@ -208,6 +213,10 @@ class MusicPlayer : public QObject, public MythObservable
 
     void setupDecoderHandler(void);
     void decoderHandlerReady(void);
+    void decodeAhead(void);
+    void nextTrackStarted(void);
+    void updateTrackLength(void);
+    void setTrackGap(std::chrono::milliseconds gap);
 
     int          m_currentTrack {-1};
     std::chrono::seconds  m_currentTime {0s};
@@ -249,6 +258,12 @@ class MusicPlayer : public QObject, public MythObservable
     int          m_bufferSize         {0};
 
     int          m_errorCount         {0};
+
+    // gapless playback
+    std::chrono::seconds      m_nextTrackStart {-1s};
+    int                       m_nextTrackPos   {-1};
+    std::chrono::milliseconds m_trackGap       {0ms};
+    QElapsedTimer             m_gapTimer;
 };
 
 Q_DECLARE_METATYPE(MusicPlayer::ResumeMode);
@@ -13,6 +13,7 @@
 #include <cmath>
 
 // C++
+#include <algorithm>
 #include <iostream>
 
 // Qt
@@ -36,8 +37,8 @@
 #include "decoder.h"
 #include "musicplayer.h"
 
-#define FFTW_N 512
-// static_assert(FFTW_N==SAMPLES_DEFAULT_SIZE)
+#define FFT_N 512
+// static_assert(FFT_N==SAMPLES_DEFAULT_SIZE)
 
 
 VisFactory* VisFactory::g_pVisFactories = nullptr;
@@ -157,6 +158,103 @@ int LogScale::operator[](int index)
     return m_indices[index];
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// VisualFrame
+
+void VisualFrame::resize(const QSize &size)
+{
+    if (m_image.size() != size)
+        m_image = QImage(size, QImage::Format_RGB32);
+}
+
+void VisualFrame::clear(QRgb colour)
+{
+    m_image.fill(colour);
+}
+
+void VisualFrame::fillRect(const QRect &rect, QRgb colour)
+{
+    QRect area = rect.normalized() & m_image.rect();
+    if (area.isEmpty())
+        return;
+
+    uchar *bits = m_image.bits();
+    int stride = m_image.bytesPerLine();
+    for (int y = area.top(); y <= area.bottom(); y++)
+    {
+        auto *line = reinterpret_cast<QRgb*>(bits + (y * stride));
+        std::fill(line + area.left(), line + area.right() + 1, colour);
+    }
+}
+
+// Fill column x between y1 and y2 inclusive, in either order
+void VisualFrame::fillSpan(int x, int y1, int y2, QRgb colour)
+{
+    if (x < 0 || x >= m_image.width())
+        return;
+    int top    = std::max(std::min(y1, y2), 0);
+    int bottom = std::min(std::max(y1, y2), m_image.height() - 1);
+
+    uchar *bits = m_image.bits();
+    int stride = m_image.bytesPerLine();
+    for (int y = top; y <= bottom; y++)
+        reinterpret_cast<QRgb*>(bits + (y * stride))[x] = colour;
+}
+
+void VisualFrame::draw(QPainter *p) const
+{
+    p->drawImage(0, 0, m_image);
+}
+
+/*
+ * The sample of greatest magnitude between From and To, keeping its sign.
+ * Add, if given, is summed with Samples first.
+*/
+static int Peak(const short *Samples, const short *Add,
+                unsigned long From, unsigned long To)
+{
+    int low  = 0;
+    int high = 0;
+    if (Add)
+    {
+        for (auto s = From; s < To; s++)
+        {
+            int value = Samples[s] + Add[s];
+            low  = std::min(low, value);
+            high = std::max(high, value);
+        }
+    }
+    else
+    {
+        for (auto s = From; s < To; s++)
+        {
+            low  = std::min(low, static_cast<int>(Samples[s]));
+            high = std::max(high, static_cast<int>(Samples[s]));
+        }
+    }
+    return (high >= -low) ? high : low;
+}
+
+// Move Value out to Peak, if that is further from zero in the same direction
+static double Extend(double Value, double Peak)
+{
+    if (Peak > 0)
+        return (Peak > Value) ? Peak : Value;
+    return (Peak < Value) ? Peak : Value;
+}
+
+#if TWOCOLOUR
+static QRgb ScopeColour(const QColor &Start, const QColor &Target, double Per)
+{
+    Per = std::clamp(std::abs(Per), 0.0, 1.0);
+    double r = Start.red() + (Target.red() - Start.red()) * (Per * Per);
+    double g = Start.green() + (Target.green() - Start.green()) * (Per * Per);
+    double b = Start.blue() + (Target.blue() - Start.blue()) * (Per * Per);
+    return qRgb(std::clamp(int(r), 0, 255), std::clamp(int(g), 0, 255),
+                std::clamp(int(b), 0, 255));
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // StereoScope
 
@@ -221,21 +319,21 @@ bool StereoScope::process( VisualNode *node )
                 }
             }
 #endif
-            for (auto s = (unsigned long)index; s < indexTo && s < node->m_length; s++)
+            auto indexFrom = (unsigned long)index;
+            indexTo = std::min(indexTo, node->m_length);
+            if (indexFrom < indexTo)
             {
                 double adjHeight = static_cast<double>(m_size.height()) / 4.0;
-                double tmpL = ( ( node->m_left ? static_cast<double>(node->m_left[s]) : 0.) *
-                                adjHeight ) / 32768.0;
-                double tmpR = ( ( node->m_right ? static_cast<double>(node->m_right[s]) : 0.) *
-                                adjHeight ) / 32768.0;
-                if (tmpL > 0)
-                    valL = (tmpL > valL) ? tmpL : valL;
-                else
-                    valL = (tmpL < valL) ? tmpL : valL;
-                if (tmpR > 0)
-                    valR = (tmpR > valR) ? tmpR : valR;
-                else
-                    valR = (tmpR < valR) ? tmpR : valR;
+                if (node->m_left)
+                {
+                    int peak = Peak(node->m_left, nullptr, indexFrom, indexTo);
+                    valL = Extend(valL, (peak * adjHeight) / 32768.0);
+                }
+                if (node->m_right)
+                {
+                    int peak = Peak(node->m_right, nullptr, indexFrom, indexTo);
+                    valR = Extend(valR, (peak * adjHeight) / 32768.0);
+                }
             }
 
             if (valL != 0. || valR != 0.)
@@ -295,98 +393,29 @@ bool StereoScope::process( VisualNode *node )
 
 bool StereoScope::draw( QPainter *p, const QColor &back )
 {
-    p->fillRect(0, 0, m_size.width(), m_size.height(), back);
-    for ( int i = 1; i < m_size.width(); i++ )
+    m_frame.resize(m_size);
+    m_frame.clear(back.rgb());
+
+    int const width = m_size.width();
+    double const adjHeightL = static_cast<double>(m_size.height()) / 4.0;
+    double const adjHeightR = static_cast<double>(m_size.height()) * 3.0 / 4.0;
+    QRgb colourL = qRgb(255, 0, 0);
+    QRgb colourR = colourL;
+    for ( int i = 1; i < width; i++ )
     {
 #if TWOCOLOUR
-    double r, g, b, per;
-
-    // left
-    per = ( static_cast<double>(m_magnitudes[i]) * 2.0 ) /
-          ( static_cast<double>(m_size.height()) / 4.0 );
-    if (per < 0.0)
-        per = -per;
-    if (per > 1.0)
-        per = 1.0;
-    else if (per < 0.0)
-        per = 0.0;
-
-    r = m_startColor.red() + (m_targetColor.red() -
-                m_startColor.red()) * (per * per);
-    g = m_startColor.green() + (m_targetColor.green() -
-                  m_startColor.green()) * (per * per);
-    b = m_startColor.blue() + (m_targetColor.blue() -
-                 m_startColor.blue()) * (per * per);
-
-    if (r > 255.0)
-        r = 255.0;
-    else if (r < 0.0)
-        r = 0;
-
-    if (g > 255.0)
-        g = 255.0;
-    else if (g < 0.0)
-        g = 0;
-
-    if (b > 255.0)
-        b = 255.0;
-    else if (b < 0.0)
-        b = 0;
-
-    p->setPen( QColor( int(r), int(g), int(b) ) );
-#else
-    p->setPen(Qt::red);
+        colourL = ScopeColour(m_startColor, m_targetColor,
+                              m_magnitudes[i] * 2.0 / adjHeightL);
+        colourR = ScopeColour(m_startColor, m_targetColor,
+                              m_magnitudes[i + width] * 2.0 / adjHeightL);
 #endif
-    double adjHeight = static_cast<double>(m_size.height()) / 4.0;
-    p->drawLine( i - 1,
-                 (int)(adjHeight + m_magnitudes[i - 1]),
-                 i,
-                 (int)(adjHeight + m_magnitudes[i]));
-
-#if TWOCOLOUR
-    // right
-    per = ( static_cast<double>(m_magnitudes[ i + m_size.width() ]) * 2 ) /
-          adjHeight;
-    if (per < 0.0)
-        per = -per;
-    if (per > 1.0)
-        per = 1.0;
-    else if (per < 0.0)
-        per = 0.0;
-
-    r = m_startColor.red() + (m_targetColor.red() -
-                m_startColor.red()) * (per * per);
-    g = m_startColor.green() + (m_targetColor.green() -
-                  m_startColor.green()) * (per * per);
-    b = m_startColor.blue() + (m_targetColor.blue() -
-                 m_startColor.blue()) * (per * per);
-
-    if (r > 255.0)
-        r = 255.0;
-    else if (r < 0.0)
-        r = 0;
-
-    if (g > 255.0)
-        g = 255.0;
-    else if (g < 0.0)
-        g = 0;
-
-    if (b > 255.0)
-        b = 255.0;
-    else if (b < 0.0)
-        b = 0;
-
-    p->setPen( QColor( int(r), int(g), int(b) ) );
-#else
-    p->setPen(Qt::red);
-#endif
-    adjHeight = static_cast<double>(m_size.height()) * 3.0 / 4.0;
-    p->drawLine( i - 1,
-                 (int)(adjHeight + m_magnitudes[i + m_size.width() - 1]),
-                 i,
-                 (int)(adjHeight + m_magnitudes[i + m_size.width()]));
+        m_frame.fillSpan(i, (int)(adjHeightL + m_magnitudes[i - 1]),
+                            (int)(adjHeightL + m_magnitudes[i]), colourL);
+        m_frame.fillSpan(i, (int)(adjHeightR + m_magnitudes[i + width - 1]),
+                            (int)(adjHeightR + m_magnitudes[i + width]), colourR);
     }
 
+    m_frame.draw(p);
     return true;
 }
 
@@ -430,19 +459,14 @@ bool MonoScope::process( VisualNode *node )
                 }
             }
 #endif
-            for (auto s = (unsigned long)index; s < indexTo && s < node->m_length; s++)
+            auto indexFrom = (unsigned long)index;
+            indexTo = std::min(indexTo, node->m_length);
+            if (indexFrom < indexTo)
             {
-                double tmp = ( static_cast<double>(node->m_left[s]) +
-                               (node->m_right ? static_cast<double>(node->m_right[s]) : 0.0) *
-                               ( static_cast<double>(m_size.height()) / 2.0 ) ) / 65536.0;
-                if (tmp > 0)
-                {
-                    val = (tmp > val) ? tmp : val;
-                }
-                else
-                {
-                    val = (tmp < val) ? tmp : val;
-                }
+                // Mono sources count twice, to match the sum of both channels
+                const short *add = node->m_right ? node->m_right : node->m_left;
+                int peak = Peak(node->m_left, add, indexFrom, indexTo);
+                val = Extend(val, (peak * static_cast<double>(m_size.height()) / 2.0) / 65536.0);
             }
 
             if ( val != 0. )
@@ -485,53 +509,22 @@ bool MonoScope::process( VisualNode *node )
 
 bool MonoScope::draw( QPainter *p, const QColor &back )
 {
-    p->fillRect( 0, 0, m_size.width(), m_size.height(), back );
-    for ( int i = 1; i < m_size.width(); i++ ) {
+    m_frame.resize(m_size);
+    m_frame.clear(back.rgb());
+
+    double const adjHeight = static_cast<double>(m_size.height()) / 2.0;
+    QRgb colour = qRgb(255, 0, 0);
+    for ( int i = 1; i < m_size.width(); i++ )
+    {
 #if TWOCOLOUR
-        double r, g, b, per;
-
-        per = double( m_magnitudes[ i ] ) /
-              double( m_size.height() / 4 );
-        if (per < 0.0)
-            per = -per;
-        if (per > 1.0)
-            per = 1.0;
-        else if (per < 0.0)
-            per = 0.0;
-
-        r = m_startColor.red() + (m_targetColor.red() -
-                                m_startColor.red()) * (per * per);
-        g = m_startColor.green() + (m_targetColor.green() -
-                                  m_startColor.green()) * (per * per);
-        b = m_startColor.blue() + (m_targetColor.blue() -
-                                 m_startColor.blue()) * (per * per);
-
-        if (r > 255.0)
-            r = 255.0;
-        else if (r < 0.0)
-            r = 0;
-
-        if (g > 255.0)
-            g = 255.0;
-        else if (g < 0.0)
-            g = 0;
-
-        if (b > 255.0)
-            b = 255.0;
-        else if (b < 0.0)
-            b = 0;
-
-        p->setPen(QColor(int(r), int(g), int(b)));
-#else
-        p->setPen(Qt::red);
+        colour = ScopeColour(m_startColor, m_targetColor,
+                             m_magnitudes[ i ] / double( m_size.height() / 4 ));
 #endif
-        double adjHeight = static_cast<double>(m_size.height()) / 2.0;
-        p->drawLine( i - 1,
-                     (int)(adjHeight + m_magnitudes[ i - 1 ]),
-                     i,
-                     (int)(adjHeight + m_magnitudes[ i ] ));
+        m_frame.fillSpan(i, (int)(adjHeight + m_magnitudes[ i - 1 ]),
+                            (int)(adjHeight + m_magnitudes[ i ]), colour);
     }
 
+    m_frame.draw(p);
     return true;
 }
 
@@ -588,38 +581,25 @@ static class MonoScopeFactory : public VisFactory
 
 ///////////////////////////////////////////////////////////////////////////////
 // Spectrum
-//
-// NOTE: This visualiser requires mythplugins to be compiled with --enable-fft
 
-#if FFTW3_SUPPORT
 Spectrum::Spectrum()
 {
     LOG(VB_GENERAL, LOG_INFO, QString("Spectrum : Being Initialised"));
 
     m_fps = 15;
 
-    m_lin = (myth_fftw_float*) av_malloc(sizeof(myth_fftw_float)*FFTW_N);
-    m_rin = (myth_fftw_float*) av_malloc(sizeof(myth_fftw_float)*FFTW_N);
-    m_lout = (myth_fftw_complex*) av_malloc(sizeof(myth_fftw_complex)*(FFTW_N/2+1));
-    m_rout = (myth_fftw_complex*) av_malloc(sizeof(myth_fftw_complex)*(FFTW_N/2+1));
-
-    m_lplan = fftw_plan_dft_r2c_1d(FFTW_N, m_lin, (myth_fftw_complex_cast*)m_lout, FFTW_MEASURE);
-    m_rplan = fftw_plan_dft_r2c_1d(FFTW_N, m_rin, (myth_fftw_complex_cast*)m_rout, FFTW_MEASURE);
+    float scale = 1.0F;
+    if (av_tx_init(&m_tx, &m_txFn, AV_TX_FLOAT_FFT, 0, FFT_N, &scale, 0) < 0)
+        LOG(VB_GENERAL, LOG_ERR, QString("Spectrum : Failed to initialise the FFT"));
+    m_txIn  = static_cast<AVComplexFloat*>(av_mallocz(sizeof(AVComplexFloat) * FFT_N));
+    m_txOut = static_cast<AVComplexFloat*>(av_mallocz(sizeof(AVComplexFloat) * FFT_N));
 }
 
 Spectrum::~Spectrum()
 {
-    if (m_lin)
-        av_free(m_lin);
-    if (m_rin)
-        av_free(m_rin);
-    if (m_lout)
-        av_free(m_lout);
-    if (m_rout)
-        av_free(m_rout);
-
-    fftw_destroy_plan(m_lplan);
-    fftw_destroy_plan(m_rplan);
+    av_tx_uninit(&m_tx);
+    av_free(m_txIn);
+    av_free(m_txOut);
 }
 
 void Spectrum::resize(const QSize &newsize)
@@ -655,10 +635,69 @@ void Spectrum::resize(const QSize &newsize)
     }
 
     m_scaleFactor = ( static_cast<double>(m_size.height()) / 2.0 ) /
-                    log( static_cast<double>(FFTW_N) );
+                    log( static_cast<double>(FFT_N) );
+
+    // Each bar shows the bin the previous bar ended at
+    m_bins.resize(m_scale.range());
+    int index = 1;
+    for (int i = 0; i < m_scale.range(); i++)
+    {
+        m_bins[i] = std::clamp(index, 0, FFT_N / 2);
+        index = m_scale[i];
+    }
+    m_power.resize(m_bins.size() * 2);
+
+    setColours(m_size.height());
 }
 
-template<typename T> T sq(T a) { return a*a; };
+void Spectrum::setColours(int steps)
+{
+    steps = std::max(steps, 1);
+    m_colours.resize(steps + 1);
+    for (int i = 0; i <= steps; i++)
+    {
+        double per = static_cast<double>(i) / steps;
+
+        double r = m_startColor.red() +
+            (m_targetColor.red() - m_startColor.red()) * (per * per);
+        double g = m_startColor.green() +
+            (m_targetColor.green() - m_startColor.green()) * (per * per);
+        double b = m_startColor.blue() +
+            (m_targetColor.blue() - m_startColor.blue()) * (per * per);
+
+        r = clamp(r, 255.0, 0.0);
+        g = clamp(g, 255.0, 0.0);
+        b = clamp(b, 255.0, 0.0);
+
+        m_colours[i] = qRgb(int(r), int(g), int(b));
+    }
+}
+
+/*
+ * Bar heights from a transform of the left channel in the real part and
+ * the right in the imaginary part. The two spectra are separated at just
+ * the bins that are shown, giving the left bars followed by the right in
+ * Power. The logs are then taken over all the bars in one flat loop.
+*/
+static void BarHeights(const AVComplexFloat *Spectrum, const std::vector<int> &Bins,
+                       float *Power, float Scale)
+{
+    size_t const count = Bins.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        const AVComplexFloat z  = Spectrum[Bins[i]];
+        const AVComplexFloat zc = Spectrum[(FFT_N - Bins[i]) & (FFT_N - 1)];
+        float leftRe  = z.re + zc.re;
+        float leftIm  = z.im - zc.im;
+        float rightRe = z.im + zc.im;
+        float rightIm = zc.re - z.re;
+        Power[i]         = 0.25F * ((leftRe * leftRe) + (leftIm * leftIm));
+        Power[i + count] = 0.25F * ((rightRe * rightRe) + (rightIm * rightIm));
+    }
+
+    for (size_t i = 0; i < count * 2; i++)
+        Power[i] = (Power[i] > 1.0F) ? (std::log(Power[i]) - 22.0F) * Scale : 0.0F;
+}
 
 bool Spectrum::process(VisualNode *node)
 {
@@ -668,38 +707,34 @@ bool Spectrum::process(VisualNode *node)
     bool allZero = true;
 
     uint i = 0;
-    long w = 0;
     QRect *rectsp = m_rects.data();
     double *magnitudesp = m_magnitudes.data();
 
+    if (!m_txFn || !m_txIn || !m_txOut)
+        return false;
+
     if (node)
     {
-        i = node->m_length;
-        if (i > FFTW_N)
-            i = FFTW_N;
-        fast_real_set_from_short(m_lin, node->m_left, i);
-        if (node->m_right)
-            fast_real_set_from_short(m_rin, node->m_right, i);
+        i = std::min(node->m_length, static_cast<unsigned long>(FFT_N));
+        // Mono is shown on both sides
+        const short *right = node->m_right ? node->m_right : node->m_left;
+        for (uint k = 0; k < i; k++)
+        {
+            m_txIn[k].re = node->m_left[k];
+            m_txIn[k].im = right[k];
+        }
     }
 
-    fast_reals_set(m_lin + i, m_rin + i, 0, FFTW_N - i);
+    std::fill(m_txIn + i, m_txIn + FFT_N, AVComplexFloat { 0.0F, 0.0F });
 
-    fftw_execute(m_lplan);
-    fftw_execute(m_rplan);
+    m_txFn(m_tx, m_txOut, m_txIn, sizeof(AVComplexFloat));
+    BarHeights(m_txOut, m_bins, m_power.data(), static_cast<float>(m_scaleFactor));
 
-    long index = 1;
-
-    for (i = 0; (int)i < m_rects.size(); i++, w += m_analyzerBarWidth)
+    for (i = 0; (int)i < m_rects.size(); i++)
     {
-        // The 1D output is Hermitian symmetric (Yk = Yn-k) so Yn = Y0 etc.
-        // The dft_r2c_1d plan doesn't output these redundant values
-        // and furthermore they're not allocated in the ctor
-        double tmp = 2 * sq(real(m_lout[index])); // + sq(real(m_lout[FFTW_N - index]));
-        double magL = (tmp > 1.) ? (log(tmp) - 22.0) * m_scaleFactor : 0.;
-
-        tmp = 2 * sq(real(m_rout[index])); // + sq(real(m_rout[FFTW_N - index]));
-        double magR = (tmp > 1.) ? (log(tmp) - 22.0) * m_scaleFactor : 0.;
-
+        double magL = m_power[i];
+        double magR = m_power[i + m_scale.range()];
+        double tmp = 0.0;
 
         double adjHeight = static_cast<double>(m_size.height()) / 2.0;
         if (magL > adjHeight)
@@ -747,8 +782,6 @@ bool Spectrum::process(VisualNode *node)
         magnitudesp[i + m_scale.range()] = magR;
         rectsp[i].setTop( m_size.height() / 2 - int( magL ) );
         rectsp[i].setBottom( m_size.height() / 2 + int( magR ) );
-
-        index = m_scale[i];
     }
 
     Q_UNUSED(allZero);
@@ -772,30 +805,17 @@ bool Spectrum::draw(QPainter *p, const QColor &back)
     // just uses some Qt methods to draw on a pixmap.
     // MainVisual then bitblts that onto the screen.
 
-    QRect *rectsp = m_rects.data();
+    m_frame.resize(m_size);
+    m_frame.clear(back.rgb());
 
-    p->fillRect(0, 0, m_size.width(), m_size.height(), back);
-    for (uint i = 0; i < (uint)m_rects.size(); i++)
+    int steps = static_cast<int>(m_colours.size()) - 1;
+    for (const QRect & rect : qAsConst(m_rects))
     {
-        double per = double( rectsp[i].height() - 2 ) / double( m_size.height() );
-
-        per = clamp(per, 1.0, 0.0);
-
-        double r = m_startColor.red() +
-            (m_targetColor.red() - m_startColor.red()) * (per * per);
-        double g = m_startColor.green() +
-            (m_targetColor.green() - m_startColor.green()) * (per * per);
-        double b = m_startColor.blue() +
-            (m_targetColor.blue() - m_startColor.blue()) * (per * per);
-
-        r = clamp(r, 255.0, 0.0);
-        g = clamp(g, 255.0, 0.0);
-        b = clamp(b, 255.0, 0.0);
-
-        if(rectsp[i].height() > 4)
-            p->fillRect(rectsp[i], QColor(int(r), int(g), int(b)));
+        if (rect.height() > 4)
+            m_frame.fillRect(rect, m_colours[std::clamp(rect.height() - 2, 0, steps)]);
     }
 
+    m_frame.draw(p);
     return true;
 }
 
@@ -823,8 +843,6 @@ static class SpectrumFactory : public VisFactory
 
 ///////////////////////////////////////////////////////////////////////////////
 // Squares
-//
-// NOTE: This visualiser requires mythplugins to be compiled with --enable-fftw
 
 Squares::Squares()
 {
@@ -838,51 +856,41 @@ void Squares::resize (const QSize &newsize) {
     m_actualSize = newsize;
 }
 
-void Squares::drawRect(QPainter *p, QRect *rect, int i, int c, int w, int h)
+void Squares::drawRect(const QRect &rect, int i, int c, int w, int h)
 {
-    double per = NAN;
     int correction = (m_actualSize.width() % m_rects.size ()) / 2;
     int x = ((i / 2) * w) + correction;
     int y = 0;
+    int level = 0;
 
+    // The colours were set up by Spectrum::resize() for the fake height
     if (i % 2 == 0)
     {
         y = c - h;
-        per = double(m_fakeHeight - rect->top()) / double(m_fakeHeight);
+        level = m_fakeHeight - rect.top();
     }
     else
     {
         y = c;
-        per = double(rect->bottom()) / double(m_fakeHeight);
+        level = rect.bottom();
     }
 
-    per = clamp(per, 1.0, 0.0);
-
-    double r = m_startColor.red() +
-        (m_targetColor.red() - m_startColor.red()) * (per * per);
-    double g = m_startColor.green() +
-        (m_targetColor.green() - m_startColor.green()) * (per * per);
-    double b = m_startColor.blue() +
-        (m_targetColor.blue() - m_startColor.blue()) * (per * per);
-
-    r = clamp(r, 255.0, 0.0);
-    g = clamp(g, 255.0, 0.0);
-    b = clamp(b, 255.0, 0.0);
-
-    p->fillRect (x, y, w, h, QColor (int(r), int(g), int(b)));
+    level = std::clamp(level, 0, static_cast<int>(m_colours.size()) - 1);
+    m_frame.fillRect(QRect(x, y, w, h), m_colours[level]);
 }
 
 bool Squares::draw(QPainter *p, const QColor &back)
 {
-    p->fillRect (0, 0, m_actualSize.width(), m_actualSize.height(), back);
+    m_frame.resize(m_actualSize);
+    m_frame.clear(back.rgb());
     int w = m_actualSize.width() / (m_rects.size() / 2);
     int h = w;
     int center = m_actualSize.height() / 2;
 
-    QRect *rectsp = m_rects.data();
-    for (uint i = 0; i < (uint)m_rects.size(); i++)
-        drawRect(p, &(rectsp[i]), i, center, w, h);
+    for (int i = 0; i < m_rects.size(); i++)
+        drawRect(m_rects[i], i, center, w, h);
 
+    m_frame.draw(p);
     return true;
 }
 
@@ -908,8 +916,6 @@ static class SquaresFactory : public VisFactory
     }
 }SquaresFactory;
 
-#endif // FFTW3_SUPPORT
-
 Piano::Piano()
 {
     // Setup the "magical" audio coefficients
@@ -934,7 +940,7 @@ Piano::Piano()
     for (uint key = 0; key < PIANO_N; key++)
     {
         // This is constant through time
-        m_pianoData[key].coeff = (goertzel_data)(2.0 * cos(2.0 * M_PI * current_freq / sample_rate));
+        m_coeff[key] = (goertzel_data)(2.0 * cos(2.0 * M_PI * current_freq / sample_rate));
 
         // Want 20 whole cycles of the current waveform at least
         double samples_required = sample_rate/current_freq * 20.0;
@@ -969,8 +975,8 @@ void Piano::zero_analysis(void)
     for (uint key = 0; key < PIANO_N; key++)
     {
         // These get updated continously, and must be stored between chunks of audio data
-        m_pianoData[key].q2 = 0.0F;
-        m_pianoData[key].q1 = 0.0F;
+        m_q2[key] = 0.0F;
+        m_q1[key] = 0.0F;
         m_pianoData[key].magnitude = 0.0F;
         m_pianoData[key].max_magnitude_seen =
             (goertzel_data)(PIANO_RMS_NEGLIGIBLE*PIANO_RMS_NEGLIGIBLE); // This is a guess - will be quickly overwritten
@@ -1058,6 +1064,9 @@ void Piano::resize(const QSize &newsize)
     m_magnitude.resize(PIANO_N);
     for (double & key : m_magnitude)
         key = 0.0;
+
+    // Everything is drawn afresh on the next frame
+    m_background = 0;
 }
 
 unsigned long Piano::getDesiredSamples(void)
@@ -1133,20 +1142,25 @@ bool Piano::process_all_types(VisualNode *node, bool /*this_will_be_displayed*/)
         return allZero; // Nothing to see here - the server can stop if it wants to
     }
 
-    for (uint key = 0; key < PIANO_N; key++)
+    // Step every key's filter for each sample in turn. Each filter only
+    // depends on its own previous state, so the inner loop runs across
+    // the keys in SIMD registers.
+    for (uint i = 0; i < n; i++)
     {
-        goertzel_data coeff = m_pianoData[key].coeff;
-        goertzel_data q2 = m_pianoData[key].q2;
-        goertzel_data q1 = m_pianoData[key].q1;
-
-        for (uint i = 0; i < n; i++)
+        goertzel_data sample = m_audioData[i];
+        for (uint key = 0; key < PIANO_N; key++)
         {
-            goertzel_data q0 = coeff * q1 - q2 + m_audioData[i];
-            q2 = q1;
-            q1 = q0;
+            goertzel_data q0 = m_coeff[key] * m_q1[key] - m_q2[key] + sample;
+            m_q2[key] = m_q1[key];
+            m_q1[key] = q0;
         }
-        m_pianoData[key].q2 = q2;
-        m_pianoData[key].q1 = q1;
+    }
+
+    for (uint key = 0; key < PIANO_N; key++)
+    {
+        goertzel_data coeff = m_coeff[key];
+        goertzel_data q2 = m_q2[key];
+        goertzel_data q1 = m_q1[key];
 
         m_pianoData[key].samples_processed += n;
 
@@ -1199,8 +1213,8 @@ bool Piano::process_all_types(VisualNode *node, bool /*this_will_be_displayed*/)
                     .arg(key).arg(n_samples).arg(magnitude_av));
 
             m_pianoData[key].samples_processed = 0; // Reset the counts, now that we've set the magnitude...
-            m_pianoData[key].q1 = (goertzel_data)0.0;
-            m_pianoData[key].q2 = (goertzel_data)0.0;
+            m_q1[key] = (goertzel_data)0.0;
+            m_q2[key] = (goertzel_data)0.0;
         }
     }
 
@@ -1235,7 +1249,15 @@ bool Piano::draw(QPainter *p, const QColor &back)
 
     unsigned int n = PIANO_N;
 
-    p->fillRect(0, 0, m_size.width(), m_size.height(), back);
+    // The keys stay where they are, so only those that change colour are
+    // filled again, unless the background has to be cleared
+    m_frame.resize(m_size);
+    if (m_background != back.rgb())
+    {
+        m_background = back.rgb();
+        m_frame.clear(m_background);
+        m_keyColours.fill(0);
+    }
 
     // Protect maximum array length
     if(n > (uint)m_rects.size())
@@ -1289,6 +1311,7 @@ bool Piano::draw(QPainter *p, const QColor &back)
     }
 
     // Deal with all the white keys first
+    bool whiteChanged = false;
     for (uint key = 0; key < n; key++)
     {
         if (m_pianoData[key].is_black_note)
@@ -1306,10 +1329,16 @@ bool Piano::draw(QPainter *p, const QColor &back)
         double g = m_whiteStartColor.green() + (m_whiteTargetColor.green() - m_whiteStartColor.green()) * per;
         double b = m_whiteStartColor.blue() + (m_whiteTargetColor.blue() - m_whiteStartColor.blue()) * per;
 
-        p->fillRect(rectsp[key], QColor(int(r), int(g), int(b)));
+        QRgb colour = qRgb(int(r), int(g), int(b));
+        if (colour != m_keyColours[key])
+        {
+            m_frame.fillRect(rectsp[key], colour);
+            m_keyColours[key] = colour;
+            whiteChanged = true;
+        }
     }
 
-    // Then overlay the black keys
+    // Then overlay the black keys, all of them if any white key was redrawn
     for (uint key = 0; key < n; key++)
     {
         if (!m_pianoData[key].is_black_note)
@@ -1325,9 +1354,15 @@ bool Piano::draw(QPainter *p, const QColor &back)
         double g = m_blackStartColor.green() + (m_blackTargetColor.green() - m_blackStartColor.green()) * per;
         double b = m_blackStartColor.blue() + (m_blackTargetColor.blue() - m_blackStartColor.blue()) * per;
 
-        p->fillRect(rectsp[key], QColor(int(r), int(g), int(b)));
+        QRgb colour = qRgb(int(r), int(g), int(b));
+        if (whiteChanged || colour != m_keyColours[key])
+        {
+            m_frame.fillRect(rectsp[key], colour);
+            m_keyColours[key] = colour;
+        }
     }
 
+    m_frame.draw(p);
     return true;
 }
 
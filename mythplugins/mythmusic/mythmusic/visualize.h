@@ -13,11 +13,13 @@
 #define VISUALIZE_H
 
 // C++ headers
-#include <QVector>
+#include <array>
 #include <vector>
 
 // Qt headers
 #include <QCoreApplication>
+#include <QImage>
+#include <QVector>
 
 // MythTV headers
 #include <visual.h>
@@ -28,19 +30,8 @@
 #include "constants.h"
 #include "config.h"
 
-#include <complex>
 extern "C" {
-#ifdef FFTW3_SUPPORT
-#include <fftw3.h>
-#define myth_fftw_float double /* need to use different plan function to change */
-#define fftw_real myth_fftw_float
-#define myth_fftw_complex std::complex<myth_fftw_float>
-#if (myth_fftw_float == double)
-#define myth_fftw_complex_cast fftw_complex
-#elif (myth_fftw_float == float)
-#define myth_fftw_complex_cast fftwf_complex
-#endif
-#endif
+#include "libavutil/tx.h"
 }
 
 #define SAMPLES_DEFAULT_SIZE 512
@@ -113,6 +104,24 @@ class VisFactory
     VisFactory*        m_pNextVisFactory {nullptr};
 };
 
+/*
+ * The picture drawn by the bar and scope visualizers. Everything is written
+ * straight into the pixels, a scanline at a time, and the whole frame is
+ * then handed to the painter with a single drawImage().
+*/
+class VisualFrame
+{
+  public:
+    void resize(const QSize &size);
+    void clear(QRgb colour);
+    void fillRect(const QRect &rect, QRgb colour);
+    void fillSpan(int x, int y1, int y2, QRgb colour);
+    void draw(QPainter *p) const;
+
+  private:
+    QImage m_image;
+};
+
 #define RUBBERBAND false
 #define TWOCOLOUR 0
 
@@ -133,6 +142,7 @@ class StereoScope : public VisualBase
     QColor         m_targetColor {Qt::red};
     std::vector<double> m_magnitudes  {};
     QSize          m_size;
+    VisualFrame    m_frame;
     bool const     m_rubberband  {RUBBERBAND};
     double const   m_falloff     {1.0};
 };
@@ -167,7 +177,6 @@ class LogScale
     int  m_r       {0};
 };
 
-#ifdef FFTW3_SUPPORT
 class Spectrum : public VisualBase
 {
     // This class draws bars (up and down)
@@ -186,6 +195,7 @@ class Spectrum : public VisualBase
 
   protected:
     static inline double clamp(double cur, double max, double min);
+    void setColours(int steps);
 
     QColor             m_startColor       {Qt::blue};
     QColor             m_targetColor      {Qt::red};
@@ -193,6 +203,8 @@ class Spectrum : public VisualBase
     QVector<double>    m_magnitudes;
     QSize              m_size;
     LogScale           m_scale;
+    VisualFrame        m_frame;
+    std::vector<QRgb>  m_colours;         // start to target, indexed by height
 
     // Setup the "magical" audio data transformations
     // provided by the Fast Fourier Transforms library
@@ -200,12 +212,12 @@ class Spectrum : public VisualBase
     double             m_falloff          {10.0};
     int                m_analyzerBarWidth {6};
 
-    fftw_plan          m_lplan;
-    fftw_plan          m_rplan;
-    myth_fftw_float   *m_lin              {nullptr};
-    myth_fftw_float   *m_rin              {nullptr};
-    myth_fftw_complex *m_lout             {nullptr};
-    myth_fftw_complex *m_rout             {nullptr};
+    AVTXContext       *m_tx               {nullptr};
+    av_tx_fn           m_txFn             {nullptr};
+    AVComplexFloat    *m_txIn             {nullptr}; // left real, right imaginary
+    AVComplexFloat    *m_txOut            {nullptr};
+    std::vector<int>   m_bins;            // FFT bin shown by each bar
+    std::vector<float> m_power;           // left bars, then right bars
 };
 
 class Squares : public Spectrum
@@ -220,14 +232,12 @@ class Squares : public Spectrum
         {(void) action;}
 
   private:
-    void drawRect(QPainter *p, QRect *rect, int i, int c, int w, int h);
+    void drawRect(const QRect &rect, int i, int c, int w, int h);
     QSize m_actualSize        {0,0};
     int   m_fakeHeight        {0};
     int   m_numberOfSquares   {16};
 };
 
-#endif // FFTW3_SUPPORT
-
 class Piano : public VisualBase
 {
     // This class draws bars (up and down)
@@ -246,7 +256,7 @@ class Piano : public VisualBase
 #define PIANO_KEYPRESS_TOO_LIGHT .2
 
 struct piano_key_data {
-    goertzel_data q1, q2, coeff, magnitude;
+    goertzel_data magnitude;
     goertzel_data max_magnitude_seen;
 
     // This keeps track of the samples processed for each note
@@ -292,6 +302,16 @@ struct piano_key_data {
     piano_key_data *m_pianoData        {nullptr};
     piano_audio    *m_audioData        {nullptr};
 
+    // The Goertzel filters are kept apart from piano_key_data,
+    // so that all the keys can be stepped together for each sample
+    std::array<goertzel_data,PIANO_N> m_coeff {};
+    std::array<goertzel_data,PIANO_N> m_q1    {};
+    std::array<goertzel_data,PIANO_N> m_q2    {};
+
+    VisualFrame     m_frame;
+    QRgb            m_background       {0};
+    std::array<QRgb,PIANO_N> m_keyColours {}; // as last drawn
+
     std::vector<double> m_magnitude    {};
 };
 
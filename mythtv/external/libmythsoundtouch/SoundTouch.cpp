@@ -413,6 +413,11 @@ BOOL SoundTouch::setSetting(uint settingId, uint value)
             pTDStretch->setParameters(sampleRate, sequenceMs, seekWindowMs, value);
             return TRUE;
 
+        case SETTING_THREADS:
+            // change number of threads sharing the overlap position search
+            pTDStretch->setThreads(value);
+            return TRUE;
+
         default :
             return FALSE;
     }
@@ -450,6 +455,9 @@ uint SoundTouch::getSetting(uint settingId) const
             pTDStretch->getParameters(NULL, NULL, NULL, &temp);
             return temp;
 
+        case SETTING_THREADS:
+            return pTDStretch->getThreads();
+
         default :
             return 0;
     }
@@ -115,6 +115,13 @@ namespace soundtouch
 /// See "STTypes.h" or README for more information.
 #define SETTING_OVERLAP_MS          5
 
+/// Number of threads sharing the time-stretch overlap position search for
+/// sound with more than two channels (default = 1). All channels still use
+/// the same overlap position, and the output doesn't depend on this setting.
+/// Only the full search is shared; with SETTING_USE_QUICKSEEK enabled the
+/// search stays on the calling thread.
+#define SETTING_THREADS             6
+
 
 class SoundTouch : public FIFOProcessor
 {
@@ -99,6 +99,18 @@ TDStretch::TDStretch() : FIFOProcessor(&outputBuffer)
     midBufferLength = 0;
     overlapLength = 0;
 
+#ifdef MULTICHANNEL
+    numThreads = 1;
+    seekGeneration = 0;
+    seekPending = 0;
+    bQuitWorkers = FALSE;
+    seekRefPos = NULL;
+    seekCount = 0;
+    seekChunk = 0;
+    seekBestCorr.resize(1);
+    seekBestIndex.resize(1);
+#endif
+
     tempo = 1.0f;
     setParameters(44100, DEFAULT_SEQUENCE_MS, DEFAULT_SEEKWINDOW_MS, DEFAULT_OVERLAP_MS);
 
@@ -110,6 +122,9 @@ TDStretch::TDStretch() : FIFOProcessor(&outputBuffer)
 
 TDStretch::~TDStretch()
 {
+#ifdef MULTICHANNEL
+    stopSeekWorkers();
+#endif
     if (midBufferLength)
     {
         delete[] pMidBuffer;
@@ -248,11 +263,16 @@ uint TDStretch::seekBestOverlapPosition(const SAMPLETYPE *refPos)
 #ifdef MULTICHANNEL
     if (channels > 2) 
     {
-        // stereo sound
+        // multichannel sound
         if (bQuickseek) 
         {
+            // always single threaded, see setThreads()
             return seekBestOverlapPositionMultiQuick(refPos);
         } 
+        else if (numThreads > 1)
+        {
+            return seekBestOverlapPositionMultiThreaded(refPos);
+        }
         else 
         {
             return seekBestOverlapPositionMulti(refPos);
@@ -408,8 +428,163 @@ uint TDStretch::seekBestOverlapPositionMultiQuick(const SAMPLETYPE *refPos)
 
     return bestOffs;
 }
+
+
+// Stops and joins the worker threads.
+void TDStretch::stopSeekWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(seekMutex);
+        bQuitWorkers = TRUE;
+    }
+    seekStart.notify_all();
+    for (auto &worker : seekWorkers)
+    {
+        worker.join();
+    }
+    seekWorkers.clear();
+    bQuitWorkers = FALSE;
+}
+
+
+// Worker thread loop: scans this thread's share of each new search.
+// 'generation' is the search count when the thread was started, as the
+// first search may begin before the thread gets to run.
+void TDStretch::seekWorker(uint thread, uint generation)
+{
+    std::unique_lock<std::mutex> lock(seekMutex);
+    while (true)
+    {
+        seekStart.wait(lock, [&]{ return bQuitWorkers || seekGeneration != generation; });
+        if (bQuitWorkers) return;
+        generation = seekGeneration;
+
+        lock.unlock();
+        scanCandidates(thread);
+        lock.lock();
+
+        if (--seekPending == 0)
+        {
+            seekDone.notify_one();
+        }
+    }
+}
+
+
+// Finds the highest correlation among one thread's contiguous share of the
+// offsets being searched. The first of equal values wins, as in the serial search.
+void TDStretch::scanCandidates(uint thread)
+{
+    uint first = thread * seekChunk;
+    uint last = min(first + seekChunk, seekCount);
+    LONG_SAMPLETYPE bestCorr = 0;
+    uint bestIndex = last;
+
+    for (uint i = first; i < last; i ++)
+    {
+        LONG_SAMPLETYPE corr = calcCrossCorrMulti(seekRefPos + channels * i, pRefMidBuffer);
+        if (bestIndex == last || corr > bestCorr)
+        {
+            bestCorr = corr;
+            bestIndex = i;
+        }
+    }
+    seekBestCorr[thread] = bestCorr;
+    seekBestIndex[thread] = bestIndex;
+}
+
+
+// Scans offsets 0 .. 'count' - 1, sharing them between the worker
+// threads and the calling one. The per thread results are merged in offset
+// order, so 'bestCorr' and 'bestOffs' end up exactly as a serial scan leaves
+// them.
+void TDStretch::scanCandidatesThreaded(uint count, LONG_SAMPLETYPE &bestCorr, uint &bestOffs)
+{
+    seekCount = count;
+    seekChunk = (count + numThreads - 1) / numThreads;
+    {
+        std::lock_guard<std::mutex> lock(seekMutex);
+        seekPending = numThreads - 1;
+        seekGeneration ++;
+    }
+    seekStart.notify_all();
+
+    scanCandidates(0);
+
+    {
+        std::unique_lock<std::mutex> lock(seekMutex);
+        seekDone.wait(lock, [&]{ return seekPending == 0; });
+    }
+
+    for (uint t = 0; t < numThreads; t ++)
+    {
+        uint last = min((t + 1) * seekChunk, seekCount);
+        if (seekBestIndex[t] < last && seekBestCorr[t] > bestCorr)
+        {
+            bestCorr = seekBestCorr[t];
+            bestOffs = seekBestIndex[t];
+        }
+    }
+}
+
+
+// Multithreaded version of seekBestOverlapPositionMulti. Every channel takes
+// part in each correlation, so one offset is chosen for all channels and they
+// stay phase aligned.
+uint TDStretch::seekBestOverlapPositionMultiThreaded(const SAMPLETYPE *refPos)
+{
+    uint bestOffs;
+    LONG_SAMPLETYPE bestCorr;
+
+    // Slopes the amplitudes of the 'midBuffer' samples
+    precalcCorrReference();
+
+    bestCorr = INT_MIN;
+    bestOffs = 0;
+
+    seekRefPos = refPos;
+    scanCandidatesThreaded(seekLength, bestCorr, bestOffs);
+
+    // clear cross correlation routine state if necessary (is so e.g. in MMX routines).
+    clearCrossCorrState();
+
+    return bestOffs;
+}
 #endif
 
+// Sets the number of threads sharing the multichannel overlap position search.
+// Threads beyond the calling one are kept waiting in a pool until needed.
+// Only the full search is shared, the quick seek runs on the calling thread.
+void TDStretch::setThreads(uint threads)
+{
+#ifdef MULTICHANNEL
+    if (threads < 1) threads = 1;
+    if (threads == numThreads) return;
+
+    stopSeekWorkers();
+    numThreads = threads;
+    seekBestCorr.resize(numThreads);
+    seekBestIndex.resize(numThreads);
+    for (uint i = 1; i < numThreads; i ++)
+    {
+        seekWorkers.emplace_back(&TDStretch::seekWorker, this, i, seekGeneration);
+    }
+#else
+    (void)threads;
+#endif
+}
+
+
+uint TDStretch::getThreads() const
+{
+#ifdef MULTICHANNEL
+    return numThreads;
+#else
+    return 1;
+#endif
+}
+
+
 // Seeks for the optimal overlap-mixing position. The 'stereo' version of the
 // routine
 //
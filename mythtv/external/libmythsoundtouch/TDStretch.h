@@ -44,6 +44,11 @@
 #ifndef TDStretch_H
 #define TDStretch_H
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "STTypes.h"
 #include "RateTransposer.h"
 #include "FIFOSamplePipe.h"
@@ -123,6 +128,25 @@ protected:
     uint seekWindowMs;
     uint overlapMs;
 
+#ifdef MULTICHANNEL
+    // Worker threads sharing the multichannel overlap position search
+    uint numThreads;
+    std::vector<std::thread> seekWorkers;
+    std::mutex seekMutex;
+    std::condition_variable seekStart;
+    std::condition_variable seekDone;
+    uint seekGeneration;
+    uint seekPending;
+    BOOL bQuitWorkers;
+
+    // Current search and each thread's best match
+    const SAMPLETYPE *seekRefPos;
+    uint seekCount;
+    uint seekChunk;
+    std::vector<LONG_SAMPLETYPE> seekBestCorr;
+    std::vector<uint> seekBestIndex;
+#endif
+
     void acceptNewOverlapLength(uint newOverlapLength);
 
     virtual void clearCrossCorrState();
@@ -137,6 +161,11 @@ protected:
 #ifdef MULTICHANNEL
     virtual uint seekBestOverlapPositionMulti(const SAMPLETYPE *refPos);
     virtual uint seekBestOverlapPositionMultiQuick(const SAMPLETYPE *refPos);
+    uint seekBestOverlapPositionMultiThreaded(const SAMPLETYPE *refPos);
+    void scanCandidates(uint thread);
+    void scanCandidatesThreaded(uint count, LONG_SAMPLETYPE &bestCorr, uint &bestOffs);
+    void seekWorker(uint thread, uint generation);
+    void stopSeekWorkers();
 #endif
     virtual uint seekBestOverlapPositionStereo(const SAMPLETYPE *refPos);
     virtual uint seekBestOverlapPositionStereoQuick(const SAMPLETYPE *refPos);
@@ -206,6 +235,17 @@ public:
     /// Returns nonzero if the quick seeking algorithm is enabled.
     BOOL isQuickSeekEnabled() const;
 
+    /// Sets the number of threads that share the overlap position search
+    /// when there are more than two channels. One offset is still chosen
+    /// for all channels, and the result is identical to a single thread.
+    /// Only the full search is shared. The quick seek passes test about 50
+    /// offsets in all, too few to pay for waking the threads, so they stay
+    /// on the calling thread.
+    void setThreads(uint threads);
+
+    /// Returns the number of threads used for the overlap position search.
+    uint getThreads() const;
+
     /// Sets routine control parameters. These control are certain time constants
     /// defining how the sound is stretched to the desired duration.
     //
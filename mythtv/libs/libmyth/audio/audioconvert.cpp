@@ -29,6 +29,7 @@
 #include "mythlogging.h"
 #include "mythaverror.h"
 #include "audioconvert.h"
+#include "audiokernels.h"
 
 extern "C" {
 #include "libavcodec/avcodec.h"
@@ -37,296 +38,13 @@ extern "C" {
 
 #define LOC QString("AudioConvert: ")
 
-#define ISALIGN(x) (((unsigned long)(x) & 0xf) == 0)
-
-#if ARCH_X86
-static int has_sse2 = -1;
-
-// Check cpuid for SSE2 support on x86 / x86_64
-static inline bool sse_check()
-{
-    if (has_sse2 != -1)
-        return (bool)has_sse2;
-    __asm__(
-            // -fPIC - we may not clobber ebx/rbx
-#if ARCH_X86_64
-            "push       %%rbx               \n\t"
-#else
-            "push       %%ebx               \n\t"
-#endif
-            "mov        $1, %%eax           \n\t"
-            "cpuid                          \n\t"
-            "and        $0x4000000, %%edx   \n\t"
-            "shr        $26, %%edx          \n\t"
-#if ARCH_X86_64
-            "pop        %%rbx               \n\t"
-#else
-            "pop        %%ebx               \n\t"
-#endif
-            :"=d"(has_sse2)
-            ::"%eax","%ecx"
-            );
-    return (bool)has_sse2;
-}
-#endif //ARCH_x86
-
-#if !HAVE_LRINTF
-static av_always_inline av_const long int lrintf(float x)
-{
-    return (int)(rint(x));
-}
-#endif /* HAVE_LRINTF */
-
-static inline float clipcheck(float f)
-{
-    if (f > 1.0F) f = 1.0F;
-    else if (f < -1.0F) f = -1.0F;
-    return f;
-}
-
 /*
- The SSE code processes 16 bytes at a time and leaves any remainder for the C
+ The conversions themselves are done by AudioKernels, which picks SIMD
+ versions for the CPU at runtime.
  */
 
-static int toFloat8(float* out, const uchar* in, int len)
-{
-    int i = 0;
-    float f = 1.0F / ((1<<7));
-
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        i = loops << 4;
-        int a = 0x80808080;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm0          \n\t"
-                          "movd       %4, %%xmm7          \n\t"
-                          "punpckldq  %%xmm0, %%xmm0      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm0, %%xmm0      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "movdqu     (%1), %%xmm1        \n\t"
-                          "xorpd      %%xmm2, %%xmm2      \n\t"
-                          "xorpd      %%xmm3, %%xmm3      \n\t"
-                          "psubb      %%xmm0, %%xmm1      \n\t"
-                          "xorpd      %%xmm4, %%xmm4      \n\t"
-                          "punpcklbw  %%xmm1, %%xmm2      \n\t"
-                          "xorpd      %%xmm5, %%xmm5      \n\t"
-                          "punpckhbw  %%xmm1, %%xmm3      \n\t"
-                          "punpcklwd  %%xmm2, %%xmm4      \n\t"
-                          "xorpd      %%xmm6, %%xmm6      \n\t"
-                          "punpckhwd  %%xmm2, %%xmm5      \n\t"
-                          "psrad      $24,    %%xmm4      \n\t"
-                          "punpcklwd  %%xmm3, %%xmm6      \n\t"
-                          "psrad      $24,    %%xmm5      \n\t"
-                          "punpckhwd  %%xmm3, %%xmm1      \n\t"
-                          "psrad      $24,    %%xmm6      \n\t"
-                          "cvtdq2ps   %%xmm4, %%xmm4      \n\t"
-                          "psrad      $24,    %%xmm1      \n\t"
-                          "cvtdq2ps   %%xmm5, %%xmm5      \n\t"
-                          "mulps      %%xmm7, %%xmm4      \n\t"
-                          "cvtdq2ps   %%xmm6, %%xmm6      \n\t"
-                          "mulps      %%xmm7, %%xmm5      \n\t"
-                          "movups     %%xmm4, (%0)        \n\t"
-                          "cvtdq2ps   %%xmm1, %%xmm1      \n\t"
-                          "mulps      %%xmm7, %%xmm6      \n\t"
-                          "movups     %%xmm5, 16(%0)      \n\t"
-                          "mulps      %%xmm7, %%xmm1      \n\t"
-                          "movups     %%xmm6, 32(%0)      \n\t"
-                          "add        $16,    %1          \n\t"
-                          "movups     %%xmm1, 48(%0)      \n\t"
-                          "add        $64,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out),"+r"(in)
-                          :"c"(loops), "r"(a), "r"(f)
-                          :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (; i < len; i++)
-        *out++ = (*in++ - 0x80) * f;
-    return len << 2;
-}
-
-/*
- The SSE code processes 16 bytes at a time and leaves any remainder for the C
- - there is no remainder in practice */
-
-static inline uchar clip_uchar(int a)
-{
-    if (a&(~0xFF))
-        return (-a)>>31;
-    return a;
-}
-
-static int fromFloat8(uchar* out, const float* in, int len)
-{
-    int i = 0;
-    float f = (1<<7);
-
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        i = loops << 4;
-        int a = 0x80808080;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm0          \n\t"
-                          "movd       %4, %%xmm7          \n\t"
-                          "punpckldq  %%xmm0, %%xmm0      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm0, %%xmm0      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "movups     (%1), %%xmm1        \n\t"
-                          "movups     16(%1), %%xmm2      \n\t"
-                          "mulps      %%xmm7, %%xmm1      \n\t"
-                          "movups     32(%1), %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm2      \n\t"
-                          "cvtps2dq   %%xmm1, %%xmm1      \n\t"
-                          "movups     48(%1), %%xmm4      \n\t"
-                          "mulps      %%xmm7, %%xmm3      \n\t"
-                          "cvtps2dq   %%xmm2, %%xmm2      \n\t"
-                          "mulps      %%xmm7, %%xmm4      \n\t"
-                          "cvtps2dq   %%xmm3, %%xmm3      \n\t"
-                          "packssdw   %%xmm2, %%xmm1      \n\t"
-                          "cvtps2dq   %%xmm4, %%xmm4      \n\t"
-                          "packssdw   %%xmm4, %%xmm3      \n\t"
-                          "add        $64,    %1          \n\t"
-                          "packsswb   %%xmm3, %%xmm1      \n\t"
-                          "paddb      %%xmm0, %%xmm1      \n\t"
-                          "movdqu     %%xmm1, (%0)        \n\t"
-                          "add        $16,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out),"+r"(in)
-                          :"c"(loops), "r"(a), "r"(f)
-                          :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (;i < len; i++)
-        *out++ = clip_uchar(lrintf(*in++ * f) + 0x80);
-    return len;
-}
-
-static int toFloat16(float* out, const short* in, int len)
-{
-    int i = 0;
-    float f = 1.0F / ((1<<15));
-
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm7          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "xorpd      %%xmm2, %%xmm2      \n\t"
-                          "movdqu     (%1),   %%xmm1      \n\t"
-                          "xorpd      %%xmm3, %%xmm3      \n\t"
-                          "punpcklwd  %%xmm1, %%xmm2      \n\t"
-                          "movdqu     16(%1), %%xmm4      \n\t"
-                          "punpckhwd  %%xmm1, %%xmm3      \n\t"
-                          "psrad      $16,    %%xmm2      \n\t"
-                          "punpcklwd  %%xmm4, %%xmm5      \n\t"
-                          "psrad      $16,    %%xmm3      \n\t"
-                          "cvtdq2ps   %%xmm2, %%xmm2      \n\t"
-                          "punpckhwd  %%xmm4, %%xmm6      \n\t"
-                          "psrad      $16,    %%xmm5      \n\t"
-                          "mulps      %%xmm7, %%xmm2      \n\t"
-                          "cvtdq2ps   %%xmm3, %%xmm3      \n\t"
-                          "psrad      $16,    %%xmm6      \n\t"
-                          "mulps      %%xmm7, %%xmm3      \n\t"
-                          "cvtdq2ps   %%xmm5, %%xmm5      \n\t"
-                          "movups     %%xmm2, (%0)        \n\t"
-                          "cvtdq2ps   %%xmm6, %%xmm6      \n\t"
-                          "mulps      %%xmm7, %%xmm5      \n\t"
-                          "movups     %%xmm3, 16(%0)      \n\t"
-                          "mulps      %%xmm7, %%xmm6      \n\t"
-                          "movups     %%xmm5, 32(%0)      \n\t"
-                          "add        $32, %1             \n\t"
-                          "movups     %%xmm6, 48(%0)      \n\t"
-                          "add        $64, %0             \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out),"+r"(in)
-                          :"c"(loops), "r"(f)
-                          :"xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (; i < len; i++)
-        *out++ = *in++ * f;
-    return len << 2;
-}
-
-static inline short clip_short(int a)
-{
-    if ((a+0x8000) & ~0xFFFF)
-        return (a>>31) ^ 0x7FFF;
-    return a;
-}
-
-static int fromFloat16(short* out, const float* in, int len)
-{
-    int i = 0;
-    float f = (1<<15);
-
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm7          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "movups     (%1), %%xmm1        \n\t"
-                          "movups     16(%1), %%xmm2      \n\t"
-                          "mulps      %%xmm7, %%xmm1      \n\t"
-                          "movups     32(%1), %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm2      \n\t"
-                          "cvtps2dq   %%xmm1, %%xmm1      \n\t"
-                          "movups     48(%1), %%xmm4      \n\t"
-                          "mulps      %%xmm7, %%xmm3      \n\t"
-                          "cvtps2dq   %%xmm2, %%xmm2      \n\t"
-                          "mulps      %%xmm7, %%xmm4      \n\t"
-                          "cvtps2dq   %%xmm3, %%xmm3      \n\t"
-                          "cvtps2dq   %%xmm4, %%xmm4      \n\t"
-                          "packssdw   %%xmm2, %%xmm1      \n\t"
-                          "packssdw   %%xmm4, %%xmm3      \n\t"
-                          "add        $64,    %1          \n\t"
-                          "movdqu     %%xmm1, (%0)        \n\t"
-                          "movdqu     %%xmm3, 16(%0)      \n\t"
-                          "add        $32,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out),"+r"(in)
-                          :"c"(loops), "r"(f)
-                          :"xmm1","xmm2","xmm3","xmm4","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (;i < len;i++)
-        *out++ = clip_short(lrintf(*in++ * f));
-    return len << 1;
-}
-
 static int toFloat32(AudioFormat format, float* out, const int* in, int len)
 {
-    int i = 0;
     int bits = AudioOutputSettings::FormatToBits(format);
     float f = 1.0F / ((uint)(1<<(bits-1)));
     int shift = 32 - bits;
@@ -334,190 +52,18 @@ static int toFloat32(AudioFormat format, float* out, const int* in, int len)
     if (format == FORMAT_S24LSB)
         shift = 0;
 
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm7          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "movd       %4, %%xmm6          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "movdqu     (%1),   %%xmm1      \n\t"
-                          "movdqu     16(%1), %%xmm2      \n\t"
-                          "psrad      %%xmm6, %%xmm1      \n\t"
-                          "movdqu     32(%1), %%xmm3      \n\t"
-                          "cvtdq2ps   %%xmm1, %%xmm1      \n\t"
-                          "psrad      %%xmm6, %%xmm2      \n\t"
-                          "movdqu     48(%1), %%xmm4      \n\t"
-                          "cvtdq2ps   %%xmm2, %%xmm2      \n\t"
-                          "psrad      %%xmm6, %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm1      \n\t"
-                          "psrad      %%xmm6, %%xmm4      \n\t"
-                          "cvtdq2ps   %%xmm3, %%xmm3      \n\t"
-                          "movups     %%xmm1, (%0)        \n\t"
-                          "mulps      %%xmm7, %%xmm2      \n\t"
-                          "cvtdq2ps   %%xmm4, %%xmm4      \n\t"
-                          "movups     %%xmm2, 16(%0)      \n\t"
-                          "mulps      %%xmm7, %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm4      \n\t"
-                          "movups     %%xmm3, 32(%0)      \n\t"
-                          "add        $64,    %1          \n\t"
-                          "movups     %%xmm4, 48(%0)      \n\t"
-                          "add        $64,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out),"+r"(in)
-                          :"c"(loops), "r"(f), "r"(shift)
-                          :"xmm1","xmm2","xmm3","xmm4","xmm6","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (; i < len; i++)
-        *out++ = (*in++ >> shift) * f;
-    return len << 2;
+    return AudioKernels::Get().m_toFloat32(out, in, len, shift, f);
 }
 
 static int fromFloat32(AudioFormat format, int* out, const float* in, int len)
 {
-    int i = 0;
     int bits = AudioOutputSettings::FormatToBits(format);
-    float f = (uint)(1<<(bits-1));
     int shift = 32 - bits;
 
     if (format == FORMAT_S24LSB)
         shift = 0;
 
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        float o = 0.99999995;
-        float mo = -1;
-        int loops = len >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-                          "movd       %3, %%xmm7          \n\t"
-                          "movss      %4, %%xmm5          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "movss      %5, %%xmm6          \n\t"
-                          "punpckldq  %%xmm5, %%xmm5      \n\t"
-                          "punpckldq  %%xmm6, %%xmm6      \n\t"
-                          "movd       %6, %%xmm0          \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm5, %%xmm5      \n\t"
-                          "punpckldq  %%xmm6, %%xmm6      \n\t"
-                          "1:                             \n\t"
-                          "movups     (%1), %%xmm1        \n\t"
-                          "movups     16(%1), %%xmm2      \n\t"
-                          "minps      %%xmm5, %%xmm1      \n\t"
-                          "movups     32(%1), %%xmm3      \n\t"
-                          "maxps      %%xmm6, %%xmm1      \n\t"
-                          "movups     48(%1), %%xmm4      \n\t"
-                          "mulps      %%xmm7, %%xmm1      \n\t"
-                          "minps      %%xmm5, %%xmm2      \n\t"
-                          "cvtps2dq   %%xmm1, %%xmm1      \n\t"
-                          "maxps      %%xmm6, %%xmm2      \n\t"
-                          "pslld      %%xmm0, %%xmm1      \n\t"
-                          "minps      %%xmm5, %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm2      \n\t"
-                          "movdqu     %%xmm1, (%0)        \n\t"
-                          "cvtps2dq   %%xmm2, %%xmm2      \n\t"
-                          "maxps      %%xmm6, %%xmm3      \n\t"
-                          "minps      %%xmm5, %%xmm4      \n\t"
-                          "pslld      %%xmm0, %%xmm2      \n\t"
-                          "mulps      %%xmm7, %%xmm3      \n\t"
-                          "maxps      %%xmm6, %%xmm4      \n\t"
-                          "movdqu     %%xmm2, 16(%0)      \n\t"
-                          "cvtps2dq   %%xmm3, %%xmm3      \n\t"
-                          "mulps      %%xmm7, %%xmm4      \n\t"
-                          "pslld      %%xmm0, %%xmm3      \n\t"
-                          "cvtps2dq   %%xmm4, %%xmm4      \n\t"
-                          "movdqu     %%xmm3, 32(%0)      \n\t"
-                          "pslld      %%xmm0, %%xmm4      \n\t"
-                          "add        $64,    %1          \n\t"
-                          "movdqu     %%xmm4, 48(%0)      \n\t"
-                          "add        $64,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out), "+r"(in)
-                          :"c"(loops), "r"(f), "m"(o), "m"(mo), "r"(shift)
-                          :"xmm0","xmm1","xmm2","xmm3","xmm4","xmm5","xmm6","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    uint range = 1<<(bits-1);
-    for (; i < len; i++)
-    {
-        float valf = *in++;
-
-        if (valf >= 1.0F)
-        {
-            *out++ = (range - 128) << shift;
-            continue;
-        }
-        if (valf <= -1.0F)
-        {
-            *out++ = (-range) << shift;
-            continue;
-        }
-        *out++ = lrintf(valf * f) << shift;
-    }
-    return len << 2;
-}
-
-static int fromFloatFLT(float* out, const float* in, int len)
-{
-    int i = 0;
-
-#if ARCH_X86
-    if (sse_check() && len >= 16)
-    {
-        int loops = len >> 4;
-        float o = 1;
-        float mo = -1;
-        i = loops << 4;
-
-        __asm__ volatile (
-                          "movss      %3, %%xmm6          \n\t"
-                          "movss      %4, %%xmm7          \n\t"
-                          "punpckldq  %%xmm6, %%xmm6      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "punpckldq  %%xmm6, %%xmm6      \n\t"
-                          "punpckldq  %%xmm7, %%xmm7      \n\t"
-                          "1:                             \n\t"
-                          "movups     (%1), %%xmm1        \n\t"
-                          "movups     16(%1), %%xmm2      \n\t"
-                          "minps      %%xmm6, %%xmm1      \n\t"
-                          "movups     32(%1), %%xmm3      \n\t"
-                          "maxps      %%xmm7, %%xmm1      \n\t"
-                          "minps      %%xmm6, %%xmm2      \n\t"
-                          "movups     48(%1), %%xmm4      \n\t"
-                          "maxps      %%xmm7, %%xmm2      \n\t"
-                          "movups     %%xmm1, (%0)        \n\t"
-                          "minps      %%xmm6, %%xmm3      \n\t"
-                          "movups     %%xmm2, 16(%0)      \n\t"
-                          "maxps      %%xmm7, %%xmm3      \n\t"
-                          "minps      %%xmm6, %%xmm4      \n\t"
-                          "movups     %%xmm3, 32(%0)      \n\t"
-                          "maxps      %%xmm7, %%xmm4      \n\t"
-                          "add        $64,    %1          \n\t"
-                          "movups     %%xmm4, 48(%0)      \n\t"
-                          "add        $64,    %0          \n\t"
-                          "sub        $1, %%ecx           \n\t"
-                          "jnz        1b                  \n\t"
-                          :"+r"(out), "+r"(in)
-                          :"c"(loops), "m"(o), "m"(mo)
-                          :"xmm1","xmm2","xmm3","xmm4","xmm6","xmm7"
-                          );
-    }
-#endif //ARCH_x86
-    for (;i < len;i++)
-        *out++ = clipcheck(*in++);
-    return len << 2;
+    return AudioKernels::Get().m_fromFloat32(out, in, len, shift, bits);
 }
 
 /**
@@ -534,9 +80,9 @@ int AudioConvert::toFloat(AudioFormat format, void* out, const void* in,
     switch (format)
     {
         case FORMAT_U8:
-            return toFloat8((float*)out,  (uchar*)in, bytes);
+            return AudioKernels::Get().m_toFloat8((float*)out, (uchar*)in, bytes);
         case FORMAT_S16:
-            return toFloat16((float*)out, (short*)in, bytes >> 1);
+            return AudioKernels::Get().m_toFloat16((float*)out, (short*)in, bytes >> 1);
         case FORMAT_S24:
         case FORMAT_S24LSB:
         case FORMAT_S32:
@@ -564,15 +110,15 @@ int AudioConvert::fromFloat(AudioFormat format, void* out, const void* in,
     switch (format)
     {
         case FORMAT_U8:
-            return fromFloat8((uchar*)out, (float*)in, bytes >> 2);
+            return AudioKernels::Get().m_fromFloat8((uchar*)out, (float*)in, bytes >> 2);
         case FORMAT_S16:
-            return fromFloat16((short*)out, (float*)in, bytes >> 2);
+            return AudioKernels::Get().m_fromFloat16((short*)out, (float*)in, bytes >> 2);
         case FORMAT_S24:
         case FORMAT_S24LSB:
         case FORMAT_S32:
             return fromFloat32(format, (int*)out, (float*)in, bytes >> 2);
         case FORMAT_FLT:
-            return fromFloatFLT((float*)out, (float*)in, bytes >> 2);
+            return AudioKernels::Get().m_fromFloatFLT((float*)out, (float*)in, bytes >> 2);
         case FORMAT_NONE:
         default:
             return 0;
@@ -772,7 +318,15 @@ void AudioConvert::DeinterleaveSamples(AudioFormat format, int channels,
     }
 
     int bits = AudioOutputSettings::FormatToBits(format);
-    if (bits == 8)
+    if (channels == 2 && bits == 16)
+    {
+        AudioKernels::Get().m_deinterleave16((short*)output, (const short*)input, data_size/sizeof(short)/2);
+    }
+    else if (channels == 2 && bits > 16)
+    {
+        AudioKernels::Get().m_deinterleave32((int*)output, (const int*)input, data_size/sizeof(int)/2);
+    }
+    else if (bits == 8)
     {
         tDeinterleaveSample((char*)output, (const char*)input, channels, data_size/sizeof(char)/channels);
     }
@@ -834,7 +388,17 @@ void AudioConvert::InterleaveSamples(AudioFormat format, int channels,
                                         int data_size)
 {
     int bits = AudioOutputSettings::FormatToBits(format);
-    if (bits == 8)
+    if (channels == 2 && bits == 16)
+    {
+        const auto* const* planes = (const short*  const*)input;
+        AudioKernels::Get().m_interleave16((short*)output, planes[0], planes[1], data_size/sizeof(short)/2);
+    }
+    else if (channels == 2 && bits > 16)
+    {
+        const auto* const* planes = (const int*  const*)input;
+        AudioKernels::Get().m_interleave32((int*)output, planes[0], planes[1], data_size/sizeof(int)/2);
+    }
+    else if (bits == 8)
     {
         tInterleaveSample((char*)output, (const char*)nullptr, channels, data_size/sizeof(char)/channels,
                           (const char*  const*)input);
@@ -860,7 +424,19 @@ void AudioConvert::InterleaveSamples(AudioFormat format, int channels,
                                         int data_size)
 {
     int bits = AudioOutputSettings::FormatToBits(format);
-    if (bits == 8)
+    if (channels == 2 && bits == 16)
+    {
+        int frames = data_size/sizeof(short)/2;
+        const auto* in = (const short*)input;
+        AudioKernels::Get().m_interleave16((short*)output, in, in + frames, frames);
+    }
+    else if (channels == 2 && bits > 16)
+    {
+        int frames = data_size/sizeof(int)/2;
+        const auto* in = (const int*)input;
+        AudioKernels::Get().m_interleave32((int*)output, in, in + frames, frames);
+    }
+    else if (bits == 8)
     {
         tInterleaveSample((char*)output, (const char*)input, channels, data_size/sizeof(char)/channels);
     }
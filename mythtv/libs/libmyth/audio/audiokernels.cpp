@@ -0,0 +1,979 @@
+#include <algorithm>
+#include <cmath>
+
+#include "mythconfig.h"
+#include "mythlogging.h"
+#include "audiokernels.h"
+
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if ARCH_X86 && HAVE_SSE2
+#include <emmintrin.h>
+#define SSE2_TARGET __attribute__((target("sse2")))
+#if HAVE_AVX2
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif HAVE_INTRINSICS_NEON
+#if ARCH_AARCH64
+#include "libavutil/aarch64/cpu.h"
+#elif ARCH_ARM
+#include "libavutil/arm/cpu.h"
+#endif
+#include <arm_neon.h>
+#endif
+
+#define LOC QString("AudioKernels: ")
+
+#if !HAVE_LRINTF
+static av_always_inline av_const long int lrintf(float x)
+{
+    return (int)(rint(x));
+}
+#endif /* HAVE_LRINTF */
+
+/*
+ * Scalar reference kernels. The SIMD kernels below handle whole vectors and
+ * leave any remainder to these.
+ */
+
+static inline uint8_t clip_uchar(int a)
+{
+    if (a&(~0xFF))
+        return (-a)>>31;
+    return a;
+}
+
+static inline int16_t clip_short(int a)
+{
+    if ((a+0x8000) & ~0xFFFF)
+        return (a>>31) ^ 0x7FFF;
+    return a;
+}
+
+static inline float clipcheck(float f)
+{
+    if (f > 1.0F) f = 1.0F;
+    else if (f < -1.0F) f = -1.0F;
+    return f;
+}
+
+static int toFloat8C(float *Out, const uint8_t *In, int Len)
+{
+    float f = 1.0F / ((1<<7));
+    for (int i = 0; i < Len; i++)
+        Out[i] = (In[i] - 0x80) * f;
+    return Len << 2;
+}
+
+static int fromFloat8C(uint8_t *Out, const float *In, int Len)
+{
+    float f = (1<<7);
+    for (int i = 0; i < Len; i++)
+        Out[i] = clip_uchar(lrintf(In[i] * f) + 0x80);
+    return Len;
+}
+
+static int toFloat16C(float *Out, const int16_t *In, int Len)
+{
+    float f = 1.0F / ((1<<15));
+    for (int i = 0; i < Len; i++)
+        Out[i] = In[i] * f;
+    return Len << 2;
+}
+
+static int fromFloat16C(int16_t *Out, const float *In, int Len)
+{
+    float f = (1<<15);
+    for (int i = 0; i < Len; i++)
+        Out[i] = clip_short(lrintf(In[i] * f));
+    return Len << 1;
+}
+
+static int toFloat32C(float *Out, const int32_t *In, int Len, int Shift, float Scale)
+{
+    for (int i = 0; i < Len; i++)
+        Out[i] = (In[i] >> Shift) * Scale;
+    return Len << 2;
+}
+
+static int fromFloat32C(int32_t *Out, const float *In, int Len, int Shift, int Bits)
+{
+    uint range = 1U << (Bits - 1);
+    auto f = static_cast<float>(range);
+    for (int i = 0; i < Len; i++)
+    {
+        float valf = In[i];
+
+        if (valf >= 1.0F)
+        {
+            Out[i] = static_cast<int32_t>((range - 128) << Shift);
+            continue;
+        }
+        if (valf <= -1.0F)
+        {
+            Out[i] = static_cast<int32_t>((-range) << Shift);
+            continue;
+        }
+        Out[i] = static_cast<int32_t>(lrintf(valf * f) << Shift);
+    }
+    return Len << 2;
+}
+
+static int fromFloatFLTC(float *Out, const float *In, int Len)
+{
+    for (int i = 0; i < Len; i++)
+        Out[i] = clipcheck(In[i]);
+    return Len << 2;
+}
+
+static void scaleC(float *Buffer, int Len, float Gain)
+{
+    for (int i = 0; i < Len; i++)
+        Buffer[i] *= Gain;
+}
+
+template <class AudioDataType>
+static void tDeinterleaveC(AudioDataType *Out, const AudioDataType *In, int Frames)
+{
+    for (int i = 0; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+template <class AudioDataType>
+static void tInterleaveC(AudioDataType *Out, const AudioDataType *Left,
+                         const AudioDataType *Right, int Frames)
+{
+    for (int i = 0; i < Frames; i++)
+    {
+        Out[(i << 1)]     = Left[i];
+        Out[(i << 1) + 1] = Right[i];
+    }
+}
+
+/// Mutes one channel of a stereo pair by copying the other over it.
+template <class AudioDataType>
+static void tMuteChannelC(AudioDataType *Buffer, int Channel, int Frames)
+{
+    for (int i = 0; i < Frames; i++)
+        Buffer[(i << 1) + Channel] = Buffer[(i << 1) + 1 - Channel];
+}
+
+static AudioKernels MakeScalar(void)
+{
+    AudioKernels kernels;
+    kernels.m_name           = "C";
+    kernels.m_toFloat8       = toFloat8C;
+    kernels.m_fromFloat8     = fromFloat8C;
+    kernels.m_toFloat16      = toFloat16C;
+    kernels.m_fromFloat16    = fromFloat16C;
+    kernels.m_toFloat32      = toFloat32C;
+    kernels.m_fromFloat32    = fromFloat32C;
+    kernels.m_fromFloatFLT   = fromFloatFLTC;
+    kernels.m_scale          = scaleC;
+    kernels.m_deinterleave16 = tDeinterleaveC<int16_t>;
+    kernels.m_deinterleave32 = tDeinterleaveC<int32_t>;
+    kernels.m_interleave16   = tInterleaveC<int16_t>;
+    kernels.m_interleave32   = tInterleaveC<int32_t>;
+    kernels.m_muteChannel16  = tMuteChannelC<int16_t>;
+    kernels.m_muteChannel32  = tMuteChannelC<int32_t>;
+    return kernels;
+}
+
+#if ARCH_X86 && HAVE_SSE2
+/*
+ * SSE2 kernels. cvtps2dq rounds to nearest even, as lrintf does in the
+ * default rounding mode, and the saturating packs match clip_short and
+ * clip_uchar.
+ */
+
+SSE2_TARGET static int toFloat8SSE2(float *Out, const uint8_t *In, int Len)
+{
+    const __m128  scale = _mm_set1_ps(1.0F / ((1<<7)));
+    const __m128i bias  = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i zero  = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= Len; i += 16)
+    {
+        // u - 0x80 as a signed byte, then sign extended to 32 bits
+        __m128i s  = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(In + i)), bias);
+        __m128i lo = _mm_unpacklo_epi8(zero, s);
+        __m128i hi = _mm_unpackhi_epi8(zero, s);
+        __m128i v0 = _mm_srai_epi32(_mm_unpacklo_epi16(zero, lo), 24);
+        __m128i v1 = _mm_srai_epi32(_mm_unpackhi_epi16(zero, lo), 24);
+        __m128i v2 = _mm_srai_epi32(_mm_unpacklo_epi16(zero, hi), 24);
+        __m128i v3 = _mm_srai_epi32(_mm_unpackhi_epi16(zero, hi), 24);
+        _mm_storeu_ps(Out + i,      _mm_mul_ps(_mm_cvtepi32_ps(v0), scale));
+        _mm_storeu_ps(Out + i + 4,  _mm_mul_ps(_mm_cvtepi32_ps(v1), scale));
+        _mm_storeu_ps(Out + i + 8,  _mm_mul_ps(_mm_cvtepi32_ps(v2), scale));
+        _mm_storeu_ps(Out + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(v3), scale));
+    }
+    toFloat8C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+SSE2_TARGET static int fromFloat8SSE2(uint8_t *Out, const float *In, int Len)
+{
+    const __m128  scale = _mm_set1_ps(1<<7);
+    const __m128i bias  = _mm_set1_epi16(0x80);
+    int i = 0;
+    for (; i + 16 <= Len; i += 16)
+    {
+        __m128i a  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i),      scale));
+        __m128i b  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i + 4),  scale));
+        __m128i c  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i + 8),  scale));
+        __m128i d  = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i + 12), scale));
+        __m128i ab = _mm_adds_epi16(_mm_packs_epi32(a, b), bias);
+        __m128i cd = _mm_adds_epi16(_mm_packs_epi32(c, d), bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i), _mm_packus_epi16(ab, cd));
+    }
+    fromFloat8C(Out + i, In + i, Len - i);
+    return Len;
+}
+
+SSE2_TARGET static int toFloat16SSE2(float *Out, const int16_t *In, int Len)
+{
+    const __m128 scale = _mm_set1_ps(1.0F / ((1<<15)));
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m128i s  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps(Out + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(Out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    toFloat16C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+SSE2_TARGET static int fromFloat16SSE2(int16_t *Out, const float *In, int Len)
+{
+    const __m128 scale = _mm_set1_ps(1<<15);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i),     scale));
+        __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(In + i + 4), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i), _mm_packs_epi32(a, b));
+    }
+    fromFloat16C(Out + i, In + i, Len - i);
+    return Len << 1;
+}
+
+SSE2_TARGET static int toFloat32SSE2(float *Out, const int32_t *In, int Len, int Shift, float Scale)
+{
+    const __m128  scale = _mm_set1_ps(Scale);
+    const __m128i shift = _mm_cvtsi32_si128(Shift);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+    {
+        __m128i v = _mm_sra_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(In + i)), shift);
+        _mm_storeu_ps(Out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+    toFloat32C(Out + i, In + i, Len - i, Shift, Scale);
+    return Len << 2;
+}
+
+SSE2_TARGET static int fromFloat32SSE2(int32_t *Out, const float *In, int Len, int Shift, int Bits)
+{
+    uint range = 1U << (Bits - 1);
+    const __m128  scale = _mm_set1_ps(static_cast<float>(range));
+    const __m128  one   = _mm_set1_ps(1.0F);
+    const __m128  mone  = _mm_set1_ps(-1.0F);
+    const __m128i maxv  = _mm_set1_epi32(static_cast<int32_t>((range - 128) << Shift));
+    const __m128i minv  = _mm_set1_epi32(static_cast<int32_t>((-range) << Shift));
+    const __m128i shift = _mm_cvtsi32_si128(Shift);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+    {
+        __m128  v    = _mm_loadu_ps(In + i);
+        __m128i high = _mm_castps_si128(_mm_cmpge_ps(v, one));
+        __m128i low  = _mm_castps_si128(_mm_cmple_ps(v, mone));
+        __m128i res  = _mm_sll_epi32(_mm_cvtps_epi32(_mm_mul_ps(v, scale)), shift);
+        res = _mm_or_si128(_mm_andnot_si128(high, res), _mm_and_si128(high, maxv));
+        res = _mm_or_si128(_mm_andnot_si128(low, res),  _mm_and_si128(low, minv));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i), res);
+    }
+    fromFloat32C(Out + i, In + i, Len - i, Shift, Bits);
+    return Len << 2;
+}
+
+SSE2_TARGET static int fromFloatFLTSSE2(float *Out, const float *In, int Len)
+{
+    const __m128 one  = _mm_set1_ps(1.0F);
+    const __m128 mone = _mm_set1_ps(-1.0F);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+        _mm_storeu_ps(Out + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(In + i), mone), one));
+    fromFloatFLTC(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+SSE2_TARGET static void scaleSSE2(float *Buffer, int Len, float Gain)
+{
+    const __m128 gain = _mm_set1_ps(Gain);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+        _mm_storeu_ps(Buffer + i, _mm_mul_ps(_mm_loadu_ps(Buffer + i), gain));
+    scaleC(Buffer + i, Len - i, Gain);
+}
+
+SSE2_TARGET static void deinterleave16SSE2(int16_t *Out, const int16_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        // Each 32 bit word holds the left sample in its low half
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In + (i << 1)));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(In + (i << 1) + 8));
+        __m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                    _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+        __m128i r = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i), l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + Frames + i), r);
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+SSE2_TARGET static void deinterleave32SSE2(int32_t *Out, const int32_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        __m128 a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(In + (i << 1))));
+        __m128 b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(In + (i << 1) + 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i),
+                         _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + Frames + i),
+                         _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+SSE2_TARGET static void interleave16SSE2(int16_t *Out, const int16_t *Left,
+                                         const int16_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Right + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + (i << 1)),     _mm_unpacklo_epi16(l, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + (i << 1) + 8), _mm_unpackhi_epi16(l, r));
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+SSE2_TARGET static void interleave32SSE2(int32_t *Out, const int32_t *Left,
+                                         const int32_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Left + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Right + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + (i << 1)),     _mm_unpacklo_epi32(l, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + (i << 1) + 4), _mm_unpackhi_epi32(l, r));
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+SSE2_TARGET static void muteChannel16SSE2(int16_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        auto *ptr = reinterpret_cast<__m128i*>(Buffer + (i << 1));
+        __m128i v = _mm_loadu_si128(ptr);
+        if (Channel == 0)
+        {
+            __m128i r = _mm_srli_epi32(v, 16);
+            v = _mm_or_si128(r, _mm_slli_epi32(r, 16));
+        }
+        else
+        {
+            __m128i l = _mm_slli_epi32(v, 16);
+            v = _mm_or_si128(l, _mm_srli_epi32(l, 16));
+        }
+        _mm_storeu_si128(ptr, v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+SSE2_TARGET static void muteChannel32SSE2(int32_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 2 <= Frames; i += 2)
+    {
+        auto *ptr = reinterpret_cast<__m128i*>(Buffer + (i << 1));
+        __m128i v = _mm_loadu_si128(ptr);
+        if (Channel == 0)
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 1, 1));
+        else
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 0, 0));
+        _mm_storeu_si128(ptr, v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+static AudioKernels MakeSSE2(void)
+{
+    AudioKernels kernels     = MakeScalar();
+    kernels.m_name           = "SSE2";
+    kernels.m_toFloat8       = toFloat8SSE2;
+    kernels.m_fromFloat8     = fromFloat8SSE2;
+    kernels.m_toFloat16      = toFloat16SSE2;
+    kernels.m_fromFloat16    = fromFloat16SSE2;
+    kernels.m_toFloat32      = toFloat32SSE2;
+    kernels.m_fromFloat32    = fromFloat32SSE2;
+    kernels.m_fromFloatFLT   = fromFloatFLTSSE2;
+    kernels.m_scale          = scaleSSE2;
+    kernels.m_deinterleave16 = deinterleave16SSE2;
+    kernels.m_deinterleave32 = deinterleave32SSE2;
+    kernels.m_interleave16   = interleave16SSE2;
+    kernels.m_interleave32   = interleave32SSE2;
+    kernels.m_muteChannel16  = muteChannel16SSE2;
+    kernels.m_muteChannel32  = muteChannel32SSE2;
+    return kernels;
+}
+
+#if HAVE_AVX2
+/*
+ * AVX2 kernels. The 256 bit packs and unpacks work within each 128 bit lane,
+ * so their results are put back in order with a cross lane permute.
+ */
+
+AVX2_TARGET static int toFloat8AVX2(float *Out, const uint8_t *In, int Len)
+{
+    const __m256  scale = _mm256_set1_ps(1.0F / ((1<<7)));
+    const __m256i bias  = _mm256_set1_epi32(0x80);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(In + i)));
+        v = _mm256_sub_epi32(v, bias);
+        _mm256_storeu_ps(Out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    toFloat8C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+AVX2_TARGET static int fromFloat8AVX2(uint8_t *Out, const float *In, int Len)
+{
+    const __m256  scale = _mm256_set1_ps(1<<7);
+    const __m256i bias  = _mm256_set1_epi16(0x80);
+    int i = 0;
+    for (; i + 16 <= Len; i += 16)
+    {
+        __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(In + i),     scale));
+        __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(In + i + 8), scale));
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        p = _mm256_adds_epi16(p, bias);
+        __m128i r = _mm_packus_epi16(_mm256_castsi256_si128(p), _mm256_extracti128_si256(p, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + i), r);
+    }
+    fromFloat8C(Out + i, In + i, Len - i);
+    return Len;
+}
+
+AVX2_TARGET static int toFloat16AVX2(float *Out, const int16_t *In, int Len)
+{
+    const __m256 scale = _mm256_set1_ps(1.0F / ((1<<15)));
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(In + i)));
+        _mm256_storeu_ps(Out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    toFloat16C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+AVX2_TARGET static int fromFloat16AVX2(int16_t *Out, const float *In, int Len)
+{
+    const __m256 scale = _mm256_set1_ps(1<<15);
+    int i = 0;
+    for (; i + 16 <= Len; i += 16)
+    {
+        __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(In + i),     scale));
+        __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(In + i + 8), scale));
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i), p);
+    }
+    fromFloat16C(Out + i, In + i, Len - i);
+    return Len << 1;
+}
+
+AVX2_TARGET static int toFloat32AVX2(float *Out, const int32_t *In, int Len, int Shift, float Scale)
+{
+    const __m256  scale = _mm256_set1_ps(Scale);
+    const __m128i shift = _mm_cvtsi32_si128(Shift);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m256i v = _mm256_sra_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + i)), shift);
+        _mm256_storeu_ps(Out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    toFloat32C(Out + i, In + i, Len - i, Shift, Scale);
+    return Len << 2;
+}
+
+AVX2_TARGET static int fromFloat32AVX2(int32_t *Out, const float *In, int Len, int Shift, int Bits)
+{
+    uint range = 1U << (Bits - 1);
+    const __m256  scale = _mm256_set1_ps(static_cast<float>(range));
+    const __m256  one   = _mm256_set1_ps(1.0F);
+    const __m256  mone  = _mm256_set1_ps(-1.0F);
+    const __m256i maxv  = _mm256_set1_epi32(static_cast<int32_t>((range - 128) << Shift));
+    const __m256i minv  = _mm256_set1_epi32(static_cast<int32_t>((-range) << Shift));
+    const __m128i shift = _mm_cvtsi32_si128(Shift);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        __m256  v    = _mm256_loadu_ps(In + i);
+        __m256i high = _mm256_castps_si256(_mm256_cmp_ps(v, one, _CMP_GE_OQ));
+        __m256i low  = _mm256_castps_si256(_mm256_cmp_ps(v, mone, _CMP_LE_OQ));
+        __m256i res  = _mm256_sll_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(v, scale)), shift);
+        res = _mm256_blendv_epi8(res, maxv, high);
+        res = _mm256_blendv_epi8(res, minv, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i), res);
+    }
+    fromFloat32C(Out + i, In + i, Len - i, Shift, Bits);
+    return Len << 2;
+}
+
+AVX2_TARGET static int fromFloatFLTAVX2(float *Out, const float *In, int Len)
+{
+    const __m256 one  = _mm256_set1_ps(1.0F);
+    const __m256 mone = _mm256_set1_ps(-1.0F);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+        _mm256_storeu_ps(Out + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(In + i), mone), one));
+    fromFloatFLTC(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+AVX2_TARGET static void scaleAVX2(float *Buffer, int Len, float Gain)
+{
+    const __m256 gain = _mm256_set1_ps(Gain);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+        _mm256_storeu_ps(Buffer + i, _mm256_mul_ps(_mm256_loadu_ps(Buffer + i), gain));
+    scaleC(Buffer + i, Len - i, Gain);
+}
+
+AVX2_TARGET static void deinterleave16AVX2(int16_t *Out, const int16_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 16 <= Frames; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + (i << 1)));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + (i << 1) + 16));
+        __m256i l = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16),
+                                       _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+        __m256i r = _mm256_packs_epi32(_mm256_srai_epi32(a, 16), _mm256_srai_epi32(b, 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i), _mm256_permute4x64_epi64(l, 0xD8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + Frames + i), _mm256_permute4x64_epi64(r, 0xD8));
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+AVX2_TARGET static void deinterleave32AVX2(int32_t *Out, const int32_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        __m256 a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + (i << 1))));
+        __m256 b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(In + (i << 1) + 8)));
+        __m256d l = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m256d r = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + i),
+                            _mm256_castpd_si256(_mm256_permute4x64_pd(l, 0xD8)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + Frames + i),
+                            _mm256_castpd_si256(_mm256_permute4x64_pd(r, 0xD8)));
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+AVX2_TARGET static void interleave16AVX2(int16_t *Out, const int16_t *Left,
+                                         const int16_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 16 <= Frames; i += 16)
+    {
+        __m256i l  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Left + i));
+        __m256i r  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Right + i));
+        __m256i lo = _mm256_unpacklo_epi16(l, r);
+        __m256i hi = _mm256_unpackhi_epi16(l, r);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + (i << 1)),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + (i << 1) + 16),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+AVX2_TARGET static void interleave32AVX2(int32_t *Out, const int32_t *Left,
+                                         const int32_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        __m256i l  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Left + i));
+        __m256i r  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Right + i));
+        __m256i lo = _mm256_unpacklo_epi32(l, r);
+        __m256i hi = _mm256_unpackhi_epi32(l, r);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + (i << 1)),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + (i << 1) + 8),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+AVX2_TARGET static void muteChannel16AVX2(int16_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        auto *ptr = reinterpret_cast<__m256i*>(Buffer + (i << 1));
+        __m256i v = _mm256_loadu_si256(ptr);
+        if (Channel == 0)
+        {
+            __m256i r = _mm256_srli_epi32(v, 16);
+            v = _mm256_or_si256(r, _mm256_slli_epi32(r, 16));
+        }
+        else
+        {
+            __m256i l = _mm256_slli_epi32(v, 16);
+            v = _mm256_or_si256(l, _mm256_srli_epi32(l, 16));
+        }
+        _mm256_storeu_si256(ptr, v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+AVX2_TARGET static void muteChannel32AVX2(int32_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        auto *ptr = reinterpret_cast<__m256i*>(Buffer + (i << 1));
+        __m256i v = _mm256_loadu_si256(ptr);
+        if (Channel == 0)
+            v = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 1, 1));
+        else
+            v = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 0, 0));
+        _mm256_storeu_si256(ptr, v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+static AudioKernels MakeAVX2(void)
+{
+    AudioKernels kernels     = MakeScalar();
+    kernels.m_name           = "AVX2";
+    kernels.m_toFloat8       = toFloat8AVX2;
+    kernels.m_fromFloat8     = fromFloat8AVX2;
+    kernels.m_toFloat16      = toFloat16AVX2;
+    kernels.m_fromFloat16    = fromFloat16AVX2;
+    kernels.m_toFloat32      = toFloat32AVX2;
+    kernels.m_fromFloat32    = fromFloat32AVX2;
+    kernels.m_fromFloatFLT   = fromFloatFLTAVX2;
+    kernels.m_scale          = scaleAVX2;
+    kernels.m_deinterleave16 = deinterleave16AVX2;
+    kernels.m_deinterleave32 = deinterleave32AVX2;
+    kernels.m_interleave16   = interleave16AVX2;
+    kernels.m_interleave32   = interleave32AVX2;
+    kernels.m_muteChannel16  = muteChannel16AVX2;
+    kernels.m_muteChannel32  = muteChannel32AVX2;
+    return kernels;
+}
+#endif // HAVE_AVX2
+
+#elif HAVE_INTRINSICS_NEON
+/*
+ * NEON kernels. 32 bit ARM has no round to nearest conversion from float,
+ * so the conversions from float are only replaced on AArch64.
+ */
+
+static int toFloat8NEON(float *Out, const uint8_t *In, int Len)
+{
+    const int16x8_t bias = vdupq_n_s16(0x80);
+    const float scale = 1.0F / ((1<<7));
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        int16x8_t s = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(In + i))), bias);
+        vst1q_f32(Out + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))),  scale));
+        vst1q_f32(Out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale));
+    }
+    toFloat8C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+static int toFloat16NEON(float *Out, const int16_t *In, int Len)
+{
+    const float scale = 1.0F / ((1<<15));
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        int16x8_t s = vld1q_s16(In + i);
+        vst1q_f32(Out + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))),  scale));
+        vst1q_f32(Out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale));
+    }
+    toFloat16C(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+static int toFloat32NEON(float *Out, const int32_t *In, int Len, int Shift, float Scale)
+{
+    const int32x4_t shift = vdupq_n_s32(-Shift);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+        vst1q_f32(Out + i, vmulq_n_f32(vcvtq_f32_s32(vshlq_s32(vld1q_s32(In + i), shift)), Scale));
+    toFloat32C(Out + i, In + i, Len - i, Shift, Scale);
+    return Len << 2;
+}
+
+#if ARCH_AARCH64
+static int fromFloat8NEON(uint8_t *Out, const float *In, int Len)
+{
+    const int16x8_t bias = vdupq_n_s16(0x80);
+    const float scale = (1<<7);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(In + i),     scale));
+        int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(In + i + 4), scale));
+        int16x8_t s = vqaddq_s16(vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)), bias);
+        vst1_u8(Out + i, vqmovun_s16(s));
+    }
+    fromFloat8C(Out + i, In + i, Len - i);
+    return Len;
+}
+
+static int fromFloat16NEON(int16_t *Out, const float *In, int Len)
+{
+    const float scale = (1<<15);
+    int i = 0;
+    for (; i + 8 <= Len; i += 8)
+    {
+        int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(In + i),     scale));
+        int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(In + i + 4), scale));
+        vst1q_s16(Out + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+    }
+    fromFloat16C(Out + i, In + i, Len - i);
+    return Len << 1;
+}
+
+static int fromFloat32NEON(int32_t *Out, const float *In, int Len, int Shift, int Bits)
+{
+    uint range = 1U << (Bits - 1);
+    const auto        scale = static_cast<float>(range);
+    const float32x4_t one   = vdupq_n_f32(1.0F);
+    const float32x4_t mone  = vdupq_n_f32(-1.0F);
+    const int32x4_t   maxv  = vdupq_n_s32(static_cast<int32_t>((range - 128) << Shift));
+    const int32x4_t   minv  = vdupq_n_s32(static_cast<int32_t>((-range) << Shift));
+    const int32x4_t   shift = vdupq_n_s32(Shift);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+    {
+        float32x4_t v = vld1q_f32(In + i);
+        int32x4_t res = vshlq_s32(vcvtnq_s32_f32(vmulq_n_f32(v, scale)), shift);
+        res = vbslq_s32(vcgeq_f32(v, one), maxv, res);
+        res = vbslq_s32(vcleq_f32(v, mone), minv, res);
+        vst1q_s32(Out + i, res);
+    }
+    fromFloat32C(Out + i, In + i, Len - i, Shift, Bits);
+    return Len << 2;
+}
+#endif // ARCH_AARCH64
+
+static int fromFloatFLTNEON(float *Out, const float *In, int Len)
+{
+    const float32x4_t one  = vdupq_n_f32(1.0F);
+    const float32x4_t mone = vdupq_n_f32(-1.0F);
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+        vst1q_f32(Out + i, vminq_f32(vmaxq_f32(vld1q_f32(In + i), mone), one));
+    fromFloatFLTC(Out + i, In + i, Len - i);
+    return Len << 2;
+}
+
+static void scaleNEON(float *Buffer, int Len, float Gain)
+{
+    int i = 0;
+    for (; i + 4 <= Len; i += 4)
+        vst1q_f32(Buffer + i, vmulq_n_f32(vld1q_f32(Buffer + i), Gain));
+    scaleC(Buffer + i, Len - i, Gain);
+}
+
+static void deinterleave16NEON(int16_t *Out, const int16_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        int16x8x2_t v = vld2q_s16(In + (i << 1));
+        vst1q_s16(Out + i, v.val[0]);
+        vst1q_s16(Out + Frames + i, v.val[1]);
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+static void deinterleave32NEON(int32_t *Out, const int32_t *In, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        int32x4x2_t v = vld2q_s32(In + (i << 1));
+        vst1q_s32(Out + i, v.val[0]);
+        vst1q_s32(Out + Frames + i, v.val[1]);
+    }
+    for (; i < Frames; i++)
+    {
+        Out[i]          = In[(i << 1)];
+        Out[Frames + i] = In[(i << 1) + 1];
+    }
+}
+
+static void interleave16NEON(int16_t *Out, const int16_t *Left,
+                             const int16_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        int16x8x2_t v { { vld1q_s16(Left + i), vld1q_s16(Right + i) } };
+        vst2q_s16(Out + (i << 1), v);
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+static void interleave32NEON(int32_t *Out, const int32_t *Left,
+                             const int32_t *Right, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        int32x4x2_t v { { vld1q_s32(Left + i), vld1q_s32(Right + i) } };
+        vst2q_s32(Out + (i << 1), v);
+    }
+    tInterleaveC(Out + (i << 1), Left + i, Right + i, Frames - i);
+}
+
+static void muteChannel16NEON(int16_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 8 <= Frames; i += 8)
+    {
+        int16x8x2_t v = vld2q_s16(Buffer + (i << 1));
+        v.val[Channel] = v.val[1 - Channel];
+        vst2q_s16(Buffer + (i << 1), v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+static void muteChannel32NEON(int32_t *Buffer, int Channel, int Frames)
+{
+    int i = 0;
+    for (; i + 4 <= Frames; i += 4)
+    {
+        int32x4x2_t v = vld2q_s32(Buffer + (i << 1));
+        v.val[Channel] = v.val[1 - Channel];
+        vst2q_s32(Buffer + (i << 1), v);
+    }
+    tMuteChannelC(Buffer + (i << 1), Channel, Frames - i);
+}
+
+static AudioKernels MakeNEON(void)
+{
+    AudioKernels kernels     = MakeScalar();
+    kernels.m_name           = "NEON";
+    kernels.m_toFloat8       = toFloat8NEON;
+    kernels.m_toFloat16      = toFloat16NEON;
+    kernels.m_toFloat32      = toFloat32NEON;
+#if ARCH_AARCH64
+    kernels.m_fromFloat8     = fromFloat8NEON;
+    kernels.m_fromFloat16    = fromFloat16NEON;
+    kernels.m_fromFloat32    = fromFloat32NEON;
+#endif
+    kernels.m_fromFloatFLT   = fromFloatFLTNEON;
+    kernels.m_scale          = scaleNEON;
+    kernels.m_deinterleave16 = deinterleave16NEON;
+    kernels.m_deinterleave32 = deinterleave32NEON;
+    kernels.m_interleave16   = interleave16NEON;
+    kernels.m_interleave32   = interleave32NEON;
+    kernels.m_muteChannel16  = muteChannel16NEON;
+    kernels.m_muteChannel32  = muteChannel32NEON;
+    return kernels;
+}
+#endif
+
+/// \brief Returns the scalar kernels, which every other set must match.
+const AudioKernels& AudioKernels::Scalar(void)
+{
+    static const AudioKernels s_scalar = MakeScalar();
+    return s_scalar;
+}
+
+/// \brief Returns every set of kernels this CPU can run, scalar first and best last.
+std::vector<const AudioKernels*> AudioKernels::Available(void)
+{
+    std::vector<const AudioKernels*> result { &Scalar() };
+    int flags = av_get_cpu_flags();
+#if ARCH_X86 && HAVE_SSE2
+    static const AudioKernels s_sse2 = MakeSSE2();
+    if (flags & AV_CPU_FLAG_SSE2)
+        result.push_back(&s_sse2);
+#if HAVE_AVX2
+    static const AudioKernels s_avx2 = MakeAVX2();
+    if (flags & AV_CPU_FLAG_AVX2)
+        result.push_back(&s_avx2);
+#endif
+#elif HAVE_INTRINSICS_NEON
+    static const AudioKernels s_neon = MakeNEON();
+    if (have_neon(flags))
+        result.push_back(&s_neon);
+#else
+    (void)flags;
+#endif
+    return result;
+}
+
+/// \brief Returns the best set of kernels for this CPU, chosen on the first call.
+const AudioKernels& AudioKernels::Get(void)
+{
+    static const AudioKernels& s_kernels = []() -> const AudioKernels&
+    {
+        const AudioKernels* best = Available().back();
+        LOG(VB_AUDIO, LOG_INFO, LOC + QString("Using %1 kernels").arg(best->m_name));
+        return *best;
+    }();
+    return s_kernels;
+}
@@ -0,0 +1,43 @@
+#ifndef AUDIOKERNELS_H
+#define AUDIOKERNELS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "mythexp.h"
+
+/*! \struct AudioKernels
+ *  \brief The sample conversion, interleaving and volume routines behind
+ *  AudioConvert and AudioOutputUtil.
+ *
+ *  One set of kernels is chosen for the CPU the first time Get() is called.
+ *  Every set produces output that is bit identical to the scalar set for
+ *  samples in the range [-2.0, 2.0]. Lengths are in samples, and the
+ *  conversions return the number of bytes written. The interleaving and
+ *  channel muting kernels only handle stereo.
+*/
+struct MPUBLIC AudioKernels
+{
+    const char *m_name { nullptr };
+
+    int  (*m_toFloat8)      (float *Out, const uint8_t *In, int Len) { nullptr };
+    int  (*m_fromFloat8)    (uint8_t *Out, const float *In, int Len) { nullptr };
+    int  (*m_toFloat16)     (float *Out, const int16_t *In, int Len) { nullptr };
+    int  (*m_fromFloat16)   (int16_t *Out, const float *In, int Len) { nullptr };
+    int  (*m_toFloat32)     (float *Out, const int32_t *In, int Len, int Shift, float Scale) { nullptr };
+    int  (*m_fromFloat32)   (int32_t *Out, const float *In, int Len, int Shift, int Bits) { nullptr };
+    int  (*m_fromFloatFLT)  (float *Out, const float *In, int Len) { nullptr };
+    void (*m_scale)         (float *Buffer, int Len, float Gain) { nullptr };
+    void (*m_deinterleave16)(int16_t *Out, const int16_t *In, int Frames) { nullptr };
+    void (*m_deinterleave32)(int32_t *Out, const int32_t *In, int Frames) { nullptr };
+    void (*m_interleave16)  (int16_t *Out, const int16_t *Left, const int16_t *Right, int Frames) { nullptr };
+    void (*m_interleave32)  (int32_t *Out, const int32_t *Left, const int32_t *Right, int Frames) { nullptr };
+    void (*m_muteChannel16) (int16_t *Buffer, int Channel, int Frames) { nullptr };
+    void (*m_muteChannel32) (int32_t *Buffer, int Channel, int Frames) { nullptr };
+
+    static const AudioKernels& Get(void);
+    static const AudioKernels& Scalar(void);
+    static std::vector<const AudioKernels*> Available(void);
+};
+
+#endif // AUDIOKERNELS_H
@@ -143,6 +143,9 @@ class MPUBLIC AudioOutput : public VolumeBase, public OutputListeners
     /// report amount of audio buffered in milliseconds.
     virtual std::chrono::milliseconds GetAudioBufferedTime(void) { return 0ms; }
 
+    /// report the timecode at the end of the audio added so far.
+    virtual std::chrono::milliseconds GetAudioQueuedTime(void) { return 0ms; }
+
     virtual void SetSourceBitrate(int /*rate*/ ) { }
 
     QString GetError(void)   const { return m_lastError; }
@@ -480,6 +480,11 @@ bool AudioOutputALSA::OpenDevice()
 
     uint period_time = 4; // aim for an interrupt every (1/4th of buffer_time)
 
+    // mmap output sizes the buffer, and so the periods, from a latency target
+    m_mmap = gCoreContext->GetBoolSetting("ALSAMMap", false);
+    if (m_mmap)
+        buffer_time = gCoreContext->GetNumSetting("ALSALatencyTarget", 100) * 1000;
+
     err = SetParameters(m_pcmHandle, format, m_channels, m_sampleRate,
                         buffer_time, period_time);
     if (err < 0)
@@ -565,7 +570,8 @@ void AudioOutputALSA::WriteAudio(uchar *aubuf, int size)
 
     while (frames > 0)
     {
-        int lw = snd_pcm_writei(m_pcmHandle, tmpbuf, frames);
+        int lw = m_mmap ? snd_pcm_mmap_writei(m_pcmHandle, tmpbuf, frames)
+                        : snd_pcm_writei(m_pcmHandle, tmpbuf, frames);
 
         if (lw >= 0)
         {
@@ -626,6 +632,119 @@ void AudioOutputALSA::WriteAudio(uchar *aubuf, int size)
     }
 }
 
+/**
+ * Recover from an xrun or suspend during mmap output.
+ * The stream then needs starting again once there's audio in it.
+ */
+bool AudioOutputALSA::RecoverMMap(int err)
+{
+    VBAUDIO(QString("mmap output: recovering from %1").arg(snd_strerror(err)));
+    err = snd_pcm_recover(m_pcmHandle, err, 1);
+    if (err < 0)
+    {
+        AERROR("mmap output: unable to recover");
+        return false;
+    }
+    m_mmapStart = true;
+    return true;
+}
+
+/**
+ * mmap output: wait until there is room for size bytes in the device buffer
+ * and return where they go, so that the output thread converts the audio
+ * straight into it. avail_min is one period, so snd_pcm_wait returns as each
+ * period finishes playing. size is reduced if the space wraps around the end
+ * of the buffer.
+ */
+unsigned char *AudioOutputALSA::BeginDirectWrite(int &size)
+{
+    if (!m_mmap || m_pcmHandle == nullptr)
+        return nullptr;
+
+    auto frames = static_cast<snd_pcm_uframes_t>(size / m_outputBytesPerFrame);
+    while (true)
+    {
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(m_pcmHandle);
+        if (avail < 0)
+        {
+            RecoverMMap(static_cast<int>(avail));
+            return nullptr;
+        }
+        if (static_cast<snd_pcm_uframes_t>(avail) >= frames)
+            break;
+
+        // The buffer is full, so make sure it's playing
+        if (m_mmapStart)
+        {
+            m_mmapStart = false;
+            snd_pcm_start(m_pcmHandle);
+        }
+
+        // On a timeout let WriteAudio deal with the device
+        int err = snd_pcm_wait(m_pcmHandle, 100);
+        if (err == 0)
+            return nullptr;
+        if (err < 0)
+        {
+            RecoverMMap(err);
+            return nullptr;
+        }
+    }
+
+    const snd_pcm_channel_area_t *areas = nullptr;
+    int err = snd_pcm_mmap_begin(m_pcmHandle, &areas, &m_mmapOffset, &frames);
+    if (err < 0)
+    {
+        RecoverMMap(err);
+        return nullptr;
+    }
+
+    // Interleaved, so the first area covers all of the channels
+    m_mmapArea = static_cast<unsigned char *>(areas[0].addr) +
+                 (areas[0].first >> 3) + (m_mmapOffset * (areas[0].step >> 3));
+    size = static_cast<int>(frames) * m_outputBytesPerFrame;
+    return m_mmapArea;
+}
+
+/**
+ * mmap output: hand the first size bytes returned by BeginDirectWrite to the
+ * device, starting the stream if it isn't running yet.
+ */
+void AudioOutputALSA::CommitDirectWrite(int size)
+{
+    if (m_pcmHandle == nullptr)
+        return;
+
+    auto frames = static_cast<snd_pcm_uframes_t>(size / m_outputBytesPerFrame);
+
+    //Audio received is in SMPTE channel order, reorder to ALSA unless passthru
+    if (frames > 0 && !m_passthru && (m_channels == 6 || m_channels == 8))
+    {
+        ReorderSmpteToAlsa(m_mmapArea, static_cast<uint>(frames), m_outputFormat,
+                           m_channels - 6);
+    }
+
+    snd_pcm_sframes_t committed =
+        snd_pcm_mmap_commit(m_pcmHandle, m_mmapOffset, frames);
+    if (committed < 0)
+    {
+        RecoverMMap(static_cast<int>(committed));
+        return;
+    }
+    if (static_cast<snd_pcm_uframes_t>(committed) < frames)
+    {
+        VBAUDIO(QString("CommitDirectWrite: short commit %1 of %2 frames")
+                .arg(committed).arg(frames));
+    }
+
+    // Unlike writes, mmap commits don't start the stream
+    if (committed > 0 && m_mmapStart)
+    {
+        m_mmapStart = false;
+        snd_pcm_start(m_pcmHandle);
+    }
+}
+
 int AudioOutputALSA::GetBufferedOnSoundcard(void) const
 {
     if (m_pcmHandle == nullptr)
@@ -683,10 +802,24 @@ int AudioOutputALSA::SetParameters(snd_pcm_t *handle, snd_pcm_format_t format,
     int err = snd_pcm_hw_params_any(handle, params);
     CHECKERR("No playback configurations available");
 
-    /* set the interleaved read/write format */
-    err = snd_pcm_hw_params_set_access(handle, params,
-                                       SND_PCM_ACCESS_RW_INTERLEAVED);
-    CHECKERR(QString("Interleaved RW audio not available"));
+    /* set the interleaved mmap or read/write format */
+    if (m_mmap)
+    {
+        err = snd_pcm_hw_params_set_access(handle, params,
+                                           SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        if (err < 0)
+        {
+            VBWARN(QString("Interleaved mmap audio not available (%1), "
+                           "using read/write").arg(snd_strerror(err)));
+            m_mmap = false;
+        }
+    }
+    if (!m_mmap)
+    {
+        err = snd_pcm_hw_params_set_access(handle, params,
+                                           SND_PCM_ACCESS_RW_INTERLEAVED);
+        CHECKERR(QString("Interleaved RW audio not available"));
+    }
 
     /* set the sample format */
     err = snd_pcm_hw_params_set_format(handle, params, format);
@@ -800,7 +933,9 @@ int AudioOutputALSA::SetParameters(snd_pcm_t *handle, snd_pcm_format_t format,
 
     /* set member variables */
     m_soundcardBufferSize = buffer_size * m_outputBytesPerFrame;
-    m_fragmentSize = (period_size >> 1) * m_outputBytesPerFrame;
+    // mmap output fills a whole period as soon as one has been played
+    m_fragmentSize = (m_mmap ? period_size : period_size >> 1) *
+                     m_outputBytesPerFrame;
 
     /* get the current swparams */
     err = snd_pcm_sw_params_current(handle, swparams);
@@ -820,7 +955,9 @@ int AudioOutputALSA::SetParameters(snd_pcm_t *handle, snd_pcm_format_t format,
 
     err = snd_pcm_prepare(handle);
     CHECKERR("Unable to prepare the PCM");
+    m_mmapStart = true;
 
+    VBAUDIO(QString("Using %1 output").arg(m_mmap ? "mmap" : "read/write"));
     return 0;
 }
 
@@ -27,6 +27,8 @@ class AudioOutputALSA : public AudioOutputBase
     void WriteAudio(unsigned char *aubuf, int size) override; // AudioOutputBase
     int  GetBufferedOnSoundcard(void) const override; // AudioOutputBase
     AudioOutputSettings* GetOutputSettings(bool passthrough) override; // AudioOutputBase
+    unsigned char *BeginDirectWrite(int &size) override; // AudioOutputBase
+    void CommitDirectWrite(int size) override; // AudioOutputBase
 
   private:
     int TryOpenDevice(int open_mode, bool try_ac3);
@@ -36,6 +38,7 @@ class AudioOutputALSA : public AudioOutputBase
                              uint channels, uint rate, uint buffer_time,
                              uint period_time);
     static QByteArray *GetELD(int card, int device, int subdevice);
+    bool RecoverMMap(int err);
     // Volume related
     bool OpenMixer(void);
 
@@ -45,6 +48,11 @@ class AudioOutputALSA : public AudioOutputBase
     int          m_card       {-1};
     int          m_device     {-1};
     int          m_subdevice  {-1};
+    // mmap output, see BeginDirectWrite()
+    bool              m_mmap       {false};
+    bool              m_mmapStart  {false};
+    snd_pcm_uframes_t m_mmapOffset {0};
+    unsigned char    *m_mmapArea   {nullptr};
     QMutex       m_killAudioLock;
     QString      m_lastDevice;
 
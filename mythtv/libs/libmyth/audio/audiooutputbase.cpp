@@ -9,6 +9,7 @@
 
 // Qt headers
 #include <QMutexLocker>
+#include <QThread>
 
 // MythTV headers
 #include "compat.h"
@@ -42,6 +43,28 @@
 #define UPMIX_CHANNEL_MASK ((1<<1)|(1<<2)|(1<<5)|1<<7)
 #define IS_VALID_UPMIX_CHANNEL(ch) ((1 << (ch)) & UPMIX_CHANNEL_MASK)
 
+// m_audioTime packs a 48 bit timecode with a 16 bit reset generation
+static constexpr int      kAudioTimeBits { 48 };
+static constexpr uint64_t kAudioTimeMask { (1ULL << kAudioTimeBits) - 1 };
+
+static inline uint64_t PackAudioTime(uint64_t generation, std::chrono::milliseconds timecode)
+{
+    return (generation << kAudioTimeBits) |
+           (static_cast<uint64_t>(timecode.count()) & kAudioTimeMask);
+}
+
+static inline uint64_t AudioTimeGeneration(uint64_t packed)
+{
+    return packed >> kAudioTimeBits;
+}
+
+static inline std::chrono::milliseconds AudioTimeTimecode(uint64_t packed)
+{
+    // sign extend
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(packed << (64 - kAudioTimeBits)) >> (64 - kAudioTimeBits));
+}
+
 const char *AudioOutputBase::quality_string(int q)
 {
     switch(q)
@@ -75,6 +98,12 @@ AudioOutputBase::AudioOutputBase(const AudioSettings &settings) :
             m_srcQuality = QUALITY_HIGH;
 
         VBAUDIO(QString("SRC quality = %1").arg(quality_string(m_srcQuality)));
+
+        m_srcBackend = static_cast<AudioResampler::Backend>(
+            gCoreContext->GetNumSetting("SRCResampler", AudioResampler::kLibSampleRate));
+        if (m_srcBackend != AudioResampler::kSwResample)
+            m_srcBackend = AudioResampler::kLibSampleRate;
+        VBAUDIO(QString("SRC resampler = %1").arg(AudioResampler::BackendToString(m_srcBackend)));
     }
 }
 
@@ -318,11 +347,23 @@ void AudioOutputBase::SetStretchFactorLocked(float lstretchfactor)
         m_pSoundStretch->setSampleRate(m_sampleRate);
         m_pSoundStretch->setChannels(channels);
         m_pSoundStretch->setTempo(m_stretchFactor);
+        // Share the full overlap search between cores for multichannel
+        // audio. All channels still get the same splice point. SoundTouch
+        // only threads the full search, never the quick seek.
+        int threads = 1;
+        if (channels > 2)
+        {
+            threads = std::clamp(QThread::idealThreadCount(), 1, channels / 2);
+            m_pSoundStretch->setSetting(SETTING_THREADS, threads);
+            VBAUDIO(QString("Time stretch using %1 threads for %2 channels")
+                    .arg(threads).arg(channels));
+        }
 #if ARCH_ARM || defined(Q_OS_ANDROID)
-        // use less demanding settings for Raspberry pi
+        // use less demanding settings for Raspberry pi, but rather spread
+        // the full search over several cores than quick seek on one
         m_pSoundStretch->setSetting(SETTING_SEQUENCE_MS, 82);
         m_pSoundStretch->setSetting(SETTING_USE_AA_FILTER, 0);
-        m_pSoundStretch->setSetting(SETTING_USE_QUICKSEEK, 1);
+        m_pSoundStretch->setSetting(SETTING_USE_QUICKSEEK, threads > 1 ? 0 : 1);
 #else
         m_pSoundStretch->setSetting(SETTING_SEQUENCE_MS, 35);
 #endif
@@ -336,7 +377,8 @@ void AudioOutputBase::SetStretchFactorLocked(float lstretchfactor)
             m_previousBpf = m_bytesPerFrame;
             m_bytesPerFrame = m_sourceChannels *
                               AudioOutputSettings::SampleSize(FORMAT_FLT);
-            m_audbufTimecode = m_audioTime = 0ms;
+            m_audbufTimecode = 0ms;
+            ResetAudiotime();
             m_framesBuffered = 0;
             m_waud = m_raud = 0;
             m_resetActive.Ref();
@@ -597,7 +639,6 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
     KillAudio();
 
     QMutexLocker lock(&m_audioBufLock);
-    QMutexLocker lockav(&m_avsyncLock);
 
     m_waud = m_raud = 0;
     m_resetActive.Clear();
@@ -678,25 +719,22 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
     {
         m_sampleRate = dest_rate;
 
-        VBGENERAL(QString("Resampling from %1 kHz to %2 kHz with quality %3")
+        VBGENERAL(QString("Resampling from %1 kHz to %2 kHz with %3 quality %4")
                 .arg(settings.m_sampleRate/1000).arg(m_sampleRate/1000)
+                .arg(AudioResampler::BackendToString(m_srcBackend))
                 .arg(quality_string(m_srcQuality)));
 
         int chans = m_needsDownmix ? m_configuredChannels : m_sourceChannels;
 
-        int error = 0;
-        m_srcCtx = src_new(2-m_srcQuality, chans, &error);
-        if (error)
+        m_resampler = AudioResampler::Create(m_srcBackend, m_srcQuality, chans,
+                                             settings.m_sampleRate, m_sampleRate);
+        if (!m_resampler)
         {
-            Error(QObject::tr("Error creating resampler: %1")
-                  .arg(src_strerror(error)));
-            m_srcCtx = nullptr;
+            Error(QObject::tr("Error creating resampler"));
             return;
         }
 
-        m_srcData.src_ratio = (double)m_sampleRate / settings.m_sampleRate;
-        m_srcData.data_in   = m_srcIn;
-        int newsize        = (int)(kAudioSRCInputSize * m_srcData.src_ratio + 15)
+        int newsize        = (int)(kAudioSRCInputSize * m_resampler->Ratio() + 15)
                              & ~0xf;
 
         if (m_kAudioSRCOutputSize < newsize)
@@ -706,9 +744,6 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
             delete[] m_srcOut;
             m_srcOut = new float[m_kAudioSRCOutputSize];
         }
-        m_srcData.data_out       = m_srcOut;
-        m_srcData.output_frames  = m_kAudioSRCOutputSize / chans;
-        m_srcData.end_of_input = 0;
     }
 
     if (m_enc)
@@ -776,7 +811,8 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
         .arg(m_mainDevice).arg(m_channels).arg(m_sourceChannels).arg(m_sampleRate)
         .arg(m_outputSettings->FormatToString(m_outputFormat)).arg(m_reEnc));
 
-    m_audbufTimecode = m_audioTime = 0ms;
+    m_audbufTimecode = 0ms;
+    ResetAudiotime();
     m_framesBuffered = 0;
     m_currentSeconds = -1s;
     m_sourceBitRate = -1;
@@ -886,11 +922,8 @@ void AudioOutputBase::KillAudio()
         m_upmixer = nullptr;
     }
 
-    if (m_srcCtx)
-    {
-        src_delete(m_srcCtx);
-        m_srcCtx = nullptr;
-    }
+    delete m_resampler;
+    m_resampler = nullptr;
 
     m_needsUpmix = m_needResampler = m_enc = false;
 
@@ -924,9 +957,9 @@ void AudioOutputBase::PauseUntilBuffered()
 void AudioOutputBase::Reset()
 {
     QMutexLocker lock(&m_audioBufLock);
-    QMutexLocker lockav(&m_avsyncLock);
 
-    m_audbufTimecode = m_audioTime = 0ms;
+    m_audbufTimecode = 0ms;
+    ResetAudiotime();
     m_framesBuffered = 0;
     if (m_encoder)
     {
@@ -935,7 +968,7 @@ void AudioOutputBase::Reset()
     }
     else
     {
-        m_waud = m_raud;        // empty ring buffer
+        m_waud = m_raud.load(); // empty ring buffer
     }
     m_resetActive.Ref();
     m_currentSeconds = -1s;
@@ -961,10 +994,25 @@ void AudioOutputBase::Reset()
  */
 void AudioOutputBase::SetTimecode(std::chrono::milliseconds timecode)
 {
-    m_audbufTimecode = m_audioTime = timecode;
+    m_audbufTimecode = timecode;
+    ResetAudiotime(timecode);
     m_framesBuffered = (timecode.count() * m_sourceSampleRate) / 1000;
 }
 
+/**
+ * Set the timecode of the audio leaving the soundcard, discarding any
+ * later time GetAudiotime() is still calculating from the old buffer.
+ * Callers set m_audbufTimecode first.
+ */
+void AudioOutputBase::ResetAudiotime(std::chrono::milliseconds timecode)
+{
+    uint64_t oldpacked = m_audioTime.load();
+    while (!m_audioTime.compare_exchange_weak(oldpacked,
+               PackAudioTime(AudioTimeGeneration(oldpacked) + 1, timecode)))
+    {
+    }
+}
+
 /**
  * Set the effective DSP rate
  *
@@ -982,9 +1030,13 @@ void AudioOutputBase::SetEffDsp(int dsprate)
  */
 inline int AudioOutputBase::audiolen() const
 {
-    if (m_waud >= m_raud)
-        return m_waud - m_raud;
-    return kAudioRingBufferSize - (m_raud - m_waud);
+    // Acquire both so that whichever thread is asking sees the data the
+    // other has finished with
+    uint waud = m_waud.load(std::memory_order_acquire);
+    uint raud = m_raud.load(std::memory_order_acquire);
+    if (waud >= raud)
+        return waud - raud;
+    return kAudioRingBufferSize - (raud - waud);
 }
 
 /**
@@ -1017,7 +1069,10 @@ int AudioOutputBase::audioready() const
  */
 std::chrono::milliseconds AudioOutputBase::GetAudiotime(void)
 {
-    if (m_audbufTimecode == 0ms || !m_configureSucceeded)
+    // Read before m_audbufTimecode, which resets set first
+    uint64_t oldpacked = m_audioTime.load();
+    std::chrono::milliseconds audbuftimecode = m_audbufTimecode.load();
+    if (audbuftimecode == 0ms || !m_configureSucceeded)
         return 0ms;
 
     // output bits per 10 frames
@@ -1046,10 +1101,11 @@ std::chrono::milliseconds AudioOutputBase::GetAudiotime(void)
        'm_effStretchFactor' is stretch factor * 100,000
 
        'totalbuffer' is the total # of bytes in our audio buffer, and the
-       sound card's buffer. */
-
+       sound card's buffer.
 
-    QMutexLocker lockav(&m_avsyncLock);
+       This is called from the output thread and for A/V sync without any
+       locking, so 'm_audioTime' is only ever moved forward atomically, and
+       only within the reset generation it was read in. */
 
     int64_t soundcard_buffer = GetBufferedOnSoundcard(); // bytes
 
@@ -1057,27 +1113,36 @@ std::chrono::milliseconds AudioOutputBase::GetAudiotime(void)
        scaled appropriately if output format != internal format */
     int64_t main_buffer = audioready();
 
-    std::chrono::milliseconds oldaudiotime = m_audioTime;
-
     /* timecode is the stretch adjusted version
        of major post-stretched buffer contents
        processing latencies are catered for in AddData/SetAudiotime
        to eliminate race */
 
-    m_audioTime = m_audbufTimecode - std::chrono::milliseconds(m_effDsp && obpf ?
+    std::chrono::milliseconds audiotime = audbuftimecode - std::chrono::milliseconds(m_effDsp && obpf ?
         ((main_buffer + soundcard_buffer) * int64_t(m_effStretchFactor)
         * 80 / int64_t(m_effDsp) / obpf) : 0);
 
     /* audiotime should never go backwards, but we might get a negative
        value if GetBufferedOnSoundcard() isn't updated by the driver very
        quickly (e.g. ALSA) */
-    if (m_audioTime < oldaudiotime)
-        m_audioTime = oldaudiotime;
+    uint64_t generation = AudioTimeGeneration(oldpacked);
+    while (true)
+    {
+        std::chrono::milliseconds oldaudiotime = AudioTimeTimecode(oldpacked);
+        if (AudioTimeGeneration(oldpacked) != generation || audiotime <= oldaudiotime)
+        {
+            // reset since audbuftimecode was read, or not moving forward
+            audiotime = oldaudiotime;
+            break;
+        }
+        if (m_audioTime.compare_exchange_weak(oldpacked, PackAudioTime(generation, audiotime)))
+            break;
+    }
 
     VBAUDIOTS(QString("GetAudiotime audt=%1 abtc=%2 mb=%3 sb=%4 tb=%5 "
                       "sr=%6 obpf=%7 bpf=%8 esf=%9 edsp=%10 sbr=%11")
-              .arg(m_audioTime.count())                // 1
-              .arg(m_audbufTimecode.count())           // 2
+              .arg(audiotime.count())                  // 1
+              .arg(audbuftimecode.count())             // 2
               .arg(main_buffer)                        // 3
               .arg(soundcard_buffer)                   // 4
               .arg(main_buffer+soundcard_buffer)       // 5
@@ -1087,7 +1152,7 @@ std::chrono::milliseconds AudioOutputBase::GetAudiotime(void)
               .arg(m_effDsp).arg(m_sourceBitRate)      // 10, 11
               );
 
-    return m_audioTime;
+    return audiotime;
 }
 
 /**
@@ -1099,7 +1164,7 @@ void AudioOutputBase::SetAudiotime(int frames, std::chrono::milliseconds timecod
 {
     int64_t processframes_stretched   = 0;
     int64_t processframes_unstretched = 0;
-    std::chrono::milliseconds old_audbuf_timecode = m_audbufTimecode;
+    std::chrono::milliseconds old_audbuf_timecode = m_audbufTimecode.load();
 
     if (!m_configureSucceeded)
         return;
@@ -1118,19 +1183,20 @@ void AudioOutputBase::SetAudiotime(int frames, std::chrono::milliseconds timecod
         processframes_stretched -= m_encoder->Buffered();
     }
 
-    m_audbufTimecode =
+    std::chrono::milliseconds audbuftimecode =
         timecode + std::chrono::milliseconds(m_effDsp ? ((frames + processframes_unstretched) * 100000 +
                     (processframes_stretched * m_effStretchFactor)
                    ) / m_effDsp : 0);
+    m_audbufTimecode = audbuftimecode;
 
     // check for timecode wrap and reset audiotime if detected
     // timecode will always be monotonic asc if not seeked and reset
     // happens if seek or pause happens
-    if (m_audbufTimecode < old_audbuf_timecode)
-        m_audioTime = 0ms;
+    if (audbuftimecode < old_audbuf_timecode)
+        ResetAudiotime();
 
     VBAUDIOTS(QString("SetAudiotime atc=%1 tc=%2 f=%3 pfu=%4 pfs=%5")
-              .arg(m_audbufTimecode.count())
+              .arg(audbuftimecode.count())
               .arg(timecode.count())
               .arg(frames)
               .arg(processframes_unstretched)
@@ -1147,7 +1213,7 @@ void AudioOutputBase::SetAudiotime(int frames, std::chrono::milliseconds timecod
  */
 std::chrono::milliseconds AudioOutputBase::GetAudioBufferedTime(void)
 {
-    std::chrono::milliseconds ret = m_audbufTimecode - GetAudiotime();
+    std::chrono::milliseconds ret = m_audbufTimecode.load() - GetAudiotime();
     // Pulse can give us values that make this -ve
     if (ret < 0ms)
         return 0ms;
@@ -1195,104 +1261,133 @@ int AudioOutputBase::CheckFreeSpace(int &frames)
     frames = afree / bpf;
     len = frames * bpf;
 
-    if (!m_srcCtx)
+    if (!m_resampler)
         return len;
 
-    int error = src_reset(m_srcCtx);
-    if (error)
+    if (!m_resampler->Reset())
     {
-        VBERROR(QString("Error occurred while resetting resampler: %1")
-                .arg(src_strerror(error)));
-        m_srcCtx = nullptr;
+        delete m_resampler;
+        m_resampler = nullptr;
     }
 
     return len;
 }
 
 /**
- * Copy frames into the audiobuffer, upmixing en route if necessary
+ * Copy frames into the audiobuffer, wrapping at the end
  *
- * Returns the number of frames written, which may be less than requested
- * if the upmixer buffered some (or all) of them
+ * Returns the number of bytes written, which may be less than requested
+ * if the audiobuffer is full
  */
-int AudioOutputBase::CopyWithUpmix(char *buffer, int frames, uint &org_waud)
+int AudioOutputBase::CopyToBuffer(const char *buffer, int frames, uint &org_waud)
 {
     int len   = CheckFreeSpace(frames);
     int bdiff = kAudioRingBufferSize - org_waud;
-    int bpf   = m_bytesPerFrame;
+    int num   = len;
     int off   = 0;
 
-    if (!m_needsUpmix)
+    if (bdiff <= num)
     {
-        int num  = len;
+        memcpy(WPOS, buffer, bdiff);
+        num -= bdiff;
+        off = bdiff;
+        org_waud = 0;
+    }
+    if (num > 0)
+        memcpy(WPOS, buffer + off, num);
+    org_waud = (org_waud + num) % kAudioRingBufferSize;
+    return len;
+}
 
-        if (bdiff <= num)
-        {
-            memcpy(WPOS, buffer, bdiff);
-            num -= bdiff;
-            off = bdiff;
-            org_waud = 0;
-        }
-        if (num > 0)
-            memcpy(WPOS, buffer + off, num);
-        org_waud = (org_waud + num) % kAudioRingBufferSize;
-        return len;
+/**
+ * Apply software volume to a block of processed float frames while it is
+ * still in cache and copy it into the audiobuffer
+ *
+ * Returns the number of bytes written
+ */
+int AudioOutputBase::VolumeAndCopy(float *buffer, int frames, uint &org_waud,
+                                   bool music)
+{
+    if (m_internalVol && SWVolume())
+    {
+        AudioOutputUtil::AdjustVolume(buffer, frames * m_bytesPerFrame, m_volume,
+                                      music, m_needsUpmix && m_upmixer);
+    }
+    return CopyToBuffer(reinterpret_cast<char *>(buffer), frames, org_waud);
+}
+
+/**
+ * Time stretch a block of float frames if required, handing the output on
+ * in blocks of at most kAudioProcessBlockSize samples
+ *
+ * Returns the number of bytes written to the audiobuffer
+ */
+int AudioOutputBase::StretchAndCopy(float *buffer, int frames, uint &org_waud,
+                                    bool music)
+{
+    if (!m_pSoundStretch)
+        return VolumeAndCopy(buffer, frames, org_waud, music);
+
+    // does not change the timecode, only the number of samples
+    m_pSoundStretch->putSamples((STST *)buffer, frames);
+
+    int maxframes = kAudioProcessBlockSize / (m_bytesPerFrame / sizeof(float));
+    int len       = 0;
+    int received  = 0;
+    while ((received = m_pSoundStretch->receiveSamples((STST *)m_stretchBuf.data(),
+                                                       maxframes)) > 0)
+    {
+        len += VolumeAndCopy(m_stretchBuf.data(), received, org_waud, music);
     }
+    return len;
+}
+
+/**
+ * Upmix a block of float frames if required, handing the output on in
+ * blocks of at most kAudioProcessBlockSize samples
+ *
+ * On return frames holds the number of upmixed frames, which may be less
+ * than given if the upmixer buffered some (or all) of them. Returns the
+ * number of bytes written to the audiobuffer
+ */
+int AudioOutputBase::UpmixAndCopy(float *buffer, int &frames, uint &org_waud,
+                                  bool music)
+{
+    if (!m_needsUpmix)
+        return StretchAndCopy(buffer, frames, org_waud, music);
+
+    int maxframes = kAudioProcessBlockSize / (m_bytesPerFrame / sizeof(float));
+    int len       = 0;
 
     // Convert mono to stereo as most devices can't accept mono
     if (!m_upmixer)
     {
         // we're always in the case
         // m_configuredChannels == 2 && m_sourceChannels == 1
-        int bdFrames = bdiff / bpf;
-        if (bdFrames <= frames)
+        for (int i = 0; i < frames; i += maxframes)
         {
-            AudioOutputUtil::MonoToStereo(WPOS, buffer, bdFrames);
-            frames -= bdFrames;
-            off = bdFrames * sizeof(float); // 1 channel of floats
-            org_waud = 0;
+            int num = std::min(frames - i, maxframes);
+            AudioOutputUtil::MonoToStereo(m_upmixBuf.data(), buffer + i, num);
+            len += StretchAndCopy(m_upmixBuf.data(), num, org_waud, music);
         }
-        if (frames > 0)
-            AudioOutputUtil::MonoToStereo(WPOS, buffer + off, frames);
-
-        org_waud = (org_waud + frames * bpf) % kAudioRingBufferSize;
         return len;
     }
 
     // Upmix to 6ch via FreeSurround
-    // Calculate frame size of input
-    off =  m_processing ? sizeof(float) : AudioOutputSettings::SampleSize(m_format);
-    off *= m_sourceChannels;
-
-    int i = 0;
-    len = 0;
+    int i     = 0;
+    int total = 0;
     while (i < frames)
     {
-        i += m_upmixer->putFrames(buffer + i * off, frames - i, m_sourceChannels);
-        int nFrames = m_upmixer->numFrames();
-        if (!nFrames)
-            continue;
-
-        len += CheckFreeSpace(nFrames);
-
-        int bdFrames = (kAudioRingBufferSize - org_waud) / bpf;
-        if (bdFrames < nFrames)
+        i += m_upmixer->putFrames(buffer + i * m_sourceChannels, frames - i,
+                                  m_sourceChannels);
+        int nFrames = 0;
+        while ((nFrames = m_upmixer->receiveFrames(m_upmixBuf.data(), maxframes)) > 0)
         {
-            if ((org_waud % bpf) != 0)
-            {
-                VBERROR(QString("Upmixing: org_waud = %1 (bpf = %2)")
-                        .arg(org_waud)
-                        .arg(bpf));
-            }
-            m_upmixer->receiveFrames((float *)(WPOS), bdFrames);
-            nFrames -= bdFrames;
-            org_waud = 0;
+            total += nFrames;
+            len   += StretchAndCopy(m_upmixBuf.data(), nFrames, org_waud, music);
         }
-        if (nFrames > 0)
-            m_upmixer->receiveFrames((float *)(WPOS), nFrames);
-
-        org_waud = (org_waud + nFrames * bpf) % kAudioRingBufferSize;
     }
+    frames = total;
     return len;
 }
 
@@ -1344,6 +1439,7 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
     uint org_waud = m_waud;
     int  afree    = audiofree();
     int  used     = kAudioRingBufferSize - afree;
+    bool inPlace  = false;
 
     if (m_passthru && m_spdifEnc)
     {
@@ -1358,17 +1454,25 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
                 "Passthrough activated with audio processing. Dropping audio");
             return false;
         }
-        // mux into an IEC958 packet
-        m_spdifEnc->WriteFrame((unsigned char *)in_buffer, len);
-        len = m_spdifEnc->GetProcessedSize();
-        if (len > 0)
+        // mux into an IEC958 packet, straight into the audiobuffer when the
+        // largest possible burst fits in the space before it wraps
+        if (afree > SPDIFEncoder::kMaxBurstSize &&
+            kAudioRingBufferSize - org_waud >=
+            static_cast<uint>(SPDIFEncoder::kMaxBurstSize))
+        {
+            len = m_spdifEnc->WriteFrameDirect((unsigned char *)in_buffer, len,
+                                               WPOS);
+            in_buffer = WPOS;
+            inPlace = true;
+        }
+        else
         {
+            m_spdifEnc->WriteFrame((unsigned char *)in_buffer, len);
+            len = m_spdifEnc->GetProcessedSize();
             in_buffer = m_spdifEnc->GetProcessedBuffer();
             m_spdifEnc->Reset();
-            frames = len / m_sourceBytesPerFrame;
         }
-        else
-            frames = 0;
+        frames = len > 0 ? len / m_sourceBytesPerFrame : 0;
     }
     m_lengthLastData = millisecondsFromFloat
         ((double)(len * 1000) / (m_sourceSampleRate * m_sourceBytesPerFrame));
@@ -1412,8 +1516,8 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
             len = (len * m_configuredChannels ) / m_sourceChannels;
 
         // Check we have enough space to write the data
-        if (m_needResampler && m_srcCtx)
-            len = lround(ceil(static_cast<double>(len) * m_srcData.src_ratio));
+        if (m_needResampler && m_resampler)
+            len = lround(ceil(static_cast<double>(len) * m_resampler->Ratio()));
 
         if (m_needsUpmix)
             len = (len * m_configuredChannels ) / m_sourceChannels;
@@ -1436,7 +1540,9 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
 
     int frames_remaining = frames;
     int frames_final = 0;
-    int maxframes = (kAudioSRCInputSize / m_sourceChannels) & ~0xf;
+    // Keep each block of floats small enough to stay in cache through all
+    // of the processing stages
+    int maxframes = (kAudioProcessBlockSize / m_sourceChannels) & ~0xf;
     int offset = 0;
 
     while(frames_remaining > 0)
@@ -1469,17 +1575,13 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
         }
 
         // Resample if necessary
-        if (m_needResampler && m_srcCtx)
+        if (m_needResampler && m_resampler)
         {
-            m_srcData.input_frames = frames;
-            int error = src_process(m_srcCtx, &m_srcData);
-
-            if (error)
-                VBERROR(QString("Error occurred while resampling audio: %1")
-                        .arg(src_strerror(error)));
-
+            frames = m_resampler->Process(m_srcIn, frames, m_srcOut,
+                                          m_kAudioSRCOutputSize / m_resampler->Channels());
             buffer = m_srcOut;
-            frames = m_srcData.output_frames_gen;
+            if (frames < 0)
+                frames = 0;
         }
         else if (m_processing)
             buffer = m_srcIn;
@@ -1488,15 +1590,28 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
            timecode of the first - add the time in ms that the frames added
            represent */
 
-        // Copy samples into audiobuffer, with upmix if necessary
-        if ((len = CopyWithUpmix((char *)buffer, frames, org_waud)) <= 0)
+        // Copy samples into audiobuffer, running the remaining float stages
+        // (upmix, time stretch and volume) block by block on the way
+        if (m_processing)
         {
-            continue;
+            len = UpmixAndCopy((float *)buffer, frames, org_waud, music);
+        }
+        else if (inPlace)
+        {
+            // The IEC958 burst was muxed straight into the audiobuffer
+            org_waud = (org_waud + len) % kAudioRingBufferSize;
+        }
+        else
+        {
+            len = CopyToBuffer((char *)buffer, frames, org_waud);
+            frames = len / bpf;
         }
 
-        frames = len / bpf;
         frames_final += frames;
 
+        if (len <= 0)
+            continue;
+
         int bdiff = kAudioRingBufferSize - m_waud;
         if ((len % bpf) != 0 && bdiff < len)
         {
@@ -1511,57 +1626,6 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
                     .arg(bpf));
         }
 
-        if (m_pSoundStretch)
-        {
-            // does not change the timecode, only the number of samples
-            org_waud     = m_waud;
-            int bdFrames = bdiff / bpf;
-
-            if (bdiff < len)
-            {
-                m_pSoundStretch->putSamples((STST *)(WPOS), bdFrames);
-                m_pSoundStretch->putSamples((STST *)ABUF, (len - bdiff) / bpf);
-            }
-            else
-                m_pSoundStretch->putSamples((STST *)(WPOS), frames);
-
-            int nFrames = m_pSoundStretch->numSamples();
-            if (nFrames > frames)
-                CheckFreeSpace(nFrames);
-
-            len = nFrames * bpf;
-
-            if (nFrames > bdFrames)
-            {
-                nFrames -= m_pSoundStretch->receiveSamples((STST *)(WPOS),
-                                                         bdFrames);
-                org_waud = 0;
-            }
-            if (nFrames > 0)
-                nFrames = m_pSoundStretch->receiveSamples((STST *)(WPOS),
-                                                        nFrames);
-
-            org_waud = (org_waud + nFrames * bpf) % kAudioRingBufferSize;
-        }
-
-        if (m_internalVol && SWVolume())
-        {
-            org_waud    = m_waud;
-            int num     = len;
-
-            if (bdiff <= num)
-            {
-                AudioOutputUtil::AdjustVolume(WPOS, bdiff, m_volume,
-                                              music, m_needsUpmix && m_upmixer);
-                num -= bdiff;
-                org_waud = 0;
-            }
-            if (num > 0)
-                AudioOutputUtil::AdjustVolume(WPOS, num, m_volume,
-                                              music, m_needsUpmix && m_upmixer);
-            org_waud = (org_waud + num) % kAudioRingBufferSize;
-        }
-
         if (m_encoder)
         {
             org_waud            = m_waud;
@@ -1591,7 +1655,8 @@ bool AudioOutputBase::AddData(void *in_buffer, int in_len,
             org_waud = (org_waud + to_get) % kAudioRingBufferSize;
         }
 
-        m_waud = org_waud;
+        // Publish the new samples to the output thread
+        m_waud.store(org_waud, std::memory_order_release);
     }
 
     SetAudiotime(frames_final, timecode);
@@ -1662,7 +1727,7 @@ void AudioOutputBase::OutputAudioLoop(void)
             }
 
             m_actuallyPaused = true;
-            m_audioTime = 0ms; // mark 'audiotime' as invalid.
+            ResetAudiotime(); // mark 'audiotime' as invalid.
 
             WriteAudio(zeros, zero_fragment_size);
             continue;
@@ -1701,14 +1766,25 @@ void AudioOutputBase::OutputAudioLoop(void)
         // delay setting raud until after phys buffer is filled
         // so GetAudiotime will be accurate without locking
         m_resetActive.TestAndDeref();
-        volatile uint next_raud = m_raud;
-        if (GetAudioData(fragment, m_fragmentSize, true, &next_raud))
+        uint next_raud = m_raud.load();
+        int direct_size = m_fragmentSize;
+        uchar *direct = BeginDirectWrite(direct_size);
+        if (direct)
+        {
+            int size = GetAudioData(direct, direct_size, true, &next_raud);
+            if (m_resetActive.TestAndDeref())
+                size = 0;
+            CommitDirectWrite(size);
+            if (size && !m_resetActive.TestAndDeref())
+                m_raud.store(next_raud, std::memory_order_release);
+        }
+        else if (GetAudioData(fragment, m_fragmentSize, true, &next_raud))
         {
             if (!m_resetActive.TestAndDeref())
             {
                 WriteAudio(fragment, m_fragmentSize);
                 if (!m_resetActive.TestAndDeref())
-                    m_raud = next_raud;
+                    m_raud.store(next_raud, std::memory_order_release);
             }
         }
 #ifdef AUDIOTSTESTING
@@ -1733,18 +1809,18 @@ void AudioOutputBase::OutputAudioLoop(void)
  * available. Returns the number of bytes copied.
  */
 int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
-                                  volatile uint *local_raud)
+                                  uint *local_raud)
 {
 
-#define LRPOS (&m_audioBuffer[*local_raud])
+#define LRPOS (&m_audioBuffer[raud])
     // re-check audioready() in case things changed.
     // for example, ClearAfterSeek() might have run
     int avail_size   = audioready();
     int frag_size    = size;
     int written_size = size;
 
-    if (local_raud == nullptr)
-        local_raud = &m_raud;
+    // Without a local read position, publish the new one when done
+    uint raud = local_raud ? *local_raud : m_raud.load(std::memory_order_acquire);
 
     if (!full_buffer && (size > avail_size))
     {
@@ -1756,7 +1832,7 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
     if (!avail_size || (frag_size > avail_size))
         return 0;
 
-    int bdiff = kAudioRingBufferSize - m_raud;
+    int bdiff = kAudioRingBufferSize - raud;
 
     int obytes = AudioOutputSettings::SampleSize(m_outputFormat);
 
@@ -1785,7 +1861,7 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
         }
 
         frag_size -= bdiff;
-        *local_raud = 0;
+        raud = 0;
     }
     if (frag_size > 0)
     {
@@ -1800,7 +1876,11 @@ int AudioOutputBase::GetAudioData(uchar *buffer, int size, bool full_buffer,
         }
     }
 
-    *local_raud += frag_size;
+    raud += frag_size;
+    if (local_raud)
+        *local_raud = raud;
+    else
+        m_raud.store(raud, std::memory_order_release);
 
     // Mute individual channels through mono->stereo duplication
     MuteState mute_state = GetMuteState();
@@ -4,6 +4,9 @@
 // POSIX headers
 #include <sys/time.h> // for struct timeval
 
+// C++ headers
+#include <atomic>
+
 // Qt headers
 #include <QString>
 #include <QMutex>
@@ -13,8 +16,7 @@
 #include "audiooutput.h"
 #include "mythlogging.h"
 #include "mthread.h"
-
-#include "samplerate.h"
+#include "audioresampler.h"
 
 #define VBAUDIO(str)   LOG(VB_AUDIO, LOG_INFO, LOC + (str))
 #define VBAUDIOTS(str) LOG(VB_AUDIO | VB_TIMESTAMP, LOG_INFO, LOC + (str))
@@ -104,6 +106,8 @@ class AudioOutputBase : public AudioOutput, public MThread
 
     std::chrono::milliseconds GetAudiotime(void) override; // AudioOutput
     std::chrono::milliseconds GetAudioBufferedTime(void) override; // AudioOutput
+    std::chrono::milliseconds GetAudioQueuedTime(void) override // AudioOutput
+        { return m_audbufTimecode; }
 
     // Send output events showing current progress
     virtual void Status(void);
@@ -119,6 +123,10 @@ class AudioOutputBase : public AudioOutput, public MThread
 
     static const uint kAudioSRCInputSize = 16384;
 
+    /// Float samples processed per block by AddData, small enough for the
+    /// block to stay in cache from conversion through to the audiobuffer
+    static const uint kAudioProcessBlockSize = 4096;
+
     /// Audio Buffer Size -- should be divisible by 32,24,16,12,10,8,6,4,2..
     // In other words, divisible by 96.
     static const uint kAudioRingBufferSize   = 10239936U;
@@ -139,6 +147,16 @@ class AudioOutputBase : public AudioOutput, public MThread
     // Default implementation only supports 2ch s16le at 48kHz
     virtual AudioOutputSettings* GetOutputSettings(bool /*digital*/)
         { return new AudioOutputSettings; }
+    /**
+     * Devices that can expose their own buffer implement these so the output
+     * thread converts straight from the audiobuffer into it rather than into
+     * a fragment for WriteAudio. BeginDirectWrite waits for room and returns
+     * up to size contiguous bytes of the device buffer, updating size, or
+     * nullptr to fall back to WriteAudio. CommitDirectWrite hands the first
+     * size bytes of it to the device.
+     */
+    virtual unsigned char *BeginDirectWrite(int &/*size*/) { return nullptr; }
+    virtual void CommitDirectWrite(int /*size*/) {}
     // You need to call this from any implementation in the dtor.
     void KillAudio(void);
 
@@ -147,7 +165,7 @@ class AudioOutputBase : public AudioOutput, public MThread
     virtual void StopOutputThread(void);
 
     int GetAudioData(uchar *buffer, int buf_size, bool full_buffer,
-                     volatile uint *local_raud = nullptr);
+                     uint *local_raud = nullptr);
 
     void OutputAudioLoop(void);
 
@@ -211,6 +229,7 @@ class AudioOutputBase : public AudioOutput, public MThread
         QUALITY_HIGH     =  2,
     };
     int  m_srcQuality                              {QUALITY_MEDIUM};
+    AudioResampler::Backend m_srcBackend           {AudioResampler::kLibSampleRate};
     long m_sourceBitRate                           {-1};
     int  m_sourceSampleRate                        {0};
 
@@ -218,14 +237,18 @@ class AudioOutputBase : public AudioOutput, public MThread
     bool SetupPassthrough(AVCodecID codec, int codec_profile,
                           int &samplerate_tmp, int &channels_tmp);
     AudioOutputSettings* OutputSettings(bool digital = true);
-    int CopyWithUpmix(char *buffer, int frames, uint &org_waud);
+    int CopyToBuffer(const char *buffer, int frames, uint &org_waud);
+    int VolumeAndCopy(float *buffer, int frames, uint &org_waud, bool music);
+    int StretchAndCopy(float *buffer, int frames, uint &org_waud, bool music);
+    int UpmixAndCopy(float *buffer, int &frames, uint &org_waud, bool music);
     void SetAudiotime(int frames, std::chrono::milliseconds timecode);
+    void ResetAudiotime(std::chrono::milliseconds timecode = 0ms);
     AudioOutputSettings       *m_outputSettingsRaw         {nullptr};
     AudioOutputSettings       *m_outputSettings            {nullptr};
     AudioOutputSettings       *m_outputSettingsDigitalRaw  {nullptr};
     AudioOutputSettings       *m_outputSettingsDigital     {nullptr};
     bool                       m_needResampler             {false};
-    SRC_STATE                 *m_srcCtx                    {nullptr};
+    AudioResampler            *m_resampler                 {nullptr};
     soundtouch::SoundTouch    *m_pSoundStretch             {nullptr};
     AudioOutputDigitalEncoder *m_encoder                   {nullptr};
     FreeSurround              *m_upmixer                   {nullptr};
@@ -248,30 +271,32 @@ class AudioOutputBase : public AudioOutput, public MThread
 
     /**
      *  Writes to the audiobuffer, reconfigures and audiobuffer resets can only
-     *  take place while holding this lock
+     *  take place while holding this lock. The output thread never takes it.
      */
     QMutex            m_audioBufLock;
 
-    /**
-     *  must hold avsync_lock to read or write 'audiotime' and
-     *  'audiotime_updated'
-     */
-    QMutex            m_avsyncLock;
-
     /**
      * timecode of audio leaving the soundcard (same units as timecodes)
+     * Read and updated without locking by the output thread, AddData and
+     * the A/V sync queries. The low 48 bits hold the timecode and the high
+     * 16 bits a generation that ResetAudiotime() increments, so that
+     * GetAudiotime() can't move a time computed before a reset past it.
      */
-    std::chrono::milliseconds m_audioTime                 {0ms};
+    std::atomic<uint64_t> m_audioTime                     {0};
 
     /**
      * Audio circular buffer
+     * There is a single writer (AddData) and a single reader (the output
+     * thread). The writer publishes m_waud with release semantics once the
+     * data is in place, and the reader publishes m_raud likewise once it
+     * has finished with the data, so neither needs a lock.
      */
-    volatile uint     m_raud                              {0}; // read position
-    volatile uint     m_waud                              {0}; // write position
+    std::atomic<uint> m_raud                              {0}; // read position
+    std::atomic<uint> m_waud                              {0}; // write position
     /**
      * timecode of audio most recently placed into buffer
      */
-    std::chrono::milliseconds m_audbufTimecode            {0ms};
+    std::atomic<std::chrono::milliseconds> m_audbufTimecode {0ms};
     AsyncLooseLock    m_resetActive;
 
     QMutex            m_killAudioLock                     {QMutex::NonRecursive};
@@ -281,12 +306,13 @@ class AudioOutputBase : public AudioOutput, public MThread
     float            *m_srcIn;
 
     // All actual buffers
-    SRC_DATA          m_srcData                           {};
     uint              m_memoryCorruptionTest0             {0xdeadbeef};
     alignas(16) std::array<float,kAudioSRCInputSize> m_srcInBuf {};
     uint              m_memoryCorruptionTest1             {0xdeadbeef};;
     float            *m_srcOut                            {nullptr};
     int               m_kAudioSRCOutputSize               {0};
+    alignas(16) std::array<float,kAudioProcessBlockSize> m_upmixBuf {};
+    alignas(16) std::array<float,kAudioProcessBlockSize> m_stretchBuf {};
     uint              m_memoryCorruptionTest2             {0xdeadbeef};;
     /**
      * main audio buffer
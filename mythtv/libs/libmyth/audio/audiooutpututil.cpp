@@ -6,6 +6,7 @@
 #include "mythlogging.h"
 #include "audiooutpututil.h"
 #include "audioconvert.h"
+#include "audiokernels.h"
 #include "bswap.h"
 #include "mythaverror.h"
 
@@ -18,48 +19,14 @@ extern "C" {
 
 #define ISALIGN(x) (((unsigned long)(x) & 0xf) == 0)
 
-#if ARCH_X86
-static int has_sse2 = -1;
-
-// Check cpuid for SSE2 support on x86 / x86_64
-static inline bool sse_check()
-{
-    if (has_sse2 != -1)
-        return (bool)has_sse2;
-    __asm__(
-        // -fPIC - we may not clobber ebx/rbx
-#if ARCH_X86_64
-        "push       %%rbx               \n\t"
-#else
-        "push       %%ebx               \n\t"
-#endif
-        "mov        $1, %%eax           \n\t"
-        "cpuid                          \n\t"
-        "and        $0x4000000, %%edx   \n\t"
-        "shr        $26, %%edx          \n\t"
-#if ARCH_X86_64
-        "pop        %%rbx               \n\t"
-#else
-        "pop        %%ebx               \n\t"
-#endif
-        :"=d"(has_sse2)
-        ::"%eax","%ecx"
-    );
-    return (bool)has_sse2;
-}
-#endif //ARCH_x86
-
 /**
  * Returns true if platform has an FPU.
- * for the time being, this test is limited to testing if SSE2 is supported
+ * for the time being, this test is limited to testing if SIMD versions of
+ * the audio kernels are in use
  */
 bool AudioOutputUtil::has_hardware_fpu()
 {
-#if ARCH_X86
-    return sse_check();
-#else
-    return false;
-#endif
+    return &AudioKernels::Get() != &AudioKernels::Scalar();
 }
 
 /**
@@ -104,7 +71,6 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
     float g     = volume / 100.0F;
     auto *fptr  = (float *)buf;
     int samples = len >> 2;
-    int i       = 0;
 
     // Should be exponential - this'll do
     g *= g;
@@ -120,40 +86,7 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
     if (g == 1.0F)
         return;
 
-#if ARCH_X86
-    if (sse_check() && samples >= 16)
-    {
-        int loops = samples >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-            "movss      %2, %%xmm0          \n\t"
-            "punpckldq  %%xmm0, %%xmm0      \n\t"
-            "punpckldq  %%xmm0, %%xmm0      \n\t"
-            "1:                             \n\t"
-            "movups     (%0), %%xmm1        \n\t"
-            "movups     16(%0), %%xmm2      \n\t"
-            "mulps      %%xmm0, %%xmm1      \n\t"
-            "movups     32(%0), %%xmm3      \n\t"
-            "mulps      %%xmm0, %%xmm2      \n\t"
-            "movups     48(%0), %%xmm4      \n\t"
-            "mulps      %%xmm0, %%xmm3      \n\t"
-            "movups     %%xmm1, (%0)        \n\t"
-            "mulps      %%xmm0, %%xmm4      \n\t"
-            "movups     %%xmm2, 16(%0)      \n\t"
-            "movups     %%xmm3, 32(%0)      \n\t"
-            "movups     %%xmm4, 48(%0)      \n\t"
-            "add        $64,    %0          \n\t"
-            "sub        $1, %%ecx           \n\t"
-            "jnz        1b                  \n\t"
-            :"+r"(fptr)
-            :"c"(loops),"m"(g)
-            :"xmm0","xmm1","xmm2","xmm3","xmm4"
-        );
-    }
-#endif //ARCH_X86
-    for (; i < samples; i++)
-        *fptr++ *= g;
+    AudioKernels::Get().m_scale(fptr, samples, g);
 }
 
 template <class AudioDataType>
@@ -181,7 +114,11 @@ void AudioOutputUtil::MuteChannel(int obits, int channels, int ch,
 {
     int frames = bytes / ((obits >> 3) * channels);
 
-    if (obits == 8)
+    if (channels == 2 && obits == 16)
+        AudioKernels::Get().m_muteChannel16((short *)buffer, ch, frames);
+    else if (channels == 2 && obits > 16)
+        AudioKernels::Get().m_muteChannel32((int *)buffer, ch, frames);
+    else if (obits == 8)
         tMuteChannel((uchar *)buffer, channels, ch, frames);
     else if (obits == 16)
         tMuteChannel((short *)buffer, channels, ch, frames);
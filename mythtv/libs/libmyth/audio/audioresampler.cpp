@@ -0,0 +1,212 @@
+// Std
+#include <algorithm>
+#include <array>
+#include <string>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythaverror.h"
+#include "audioresampler.h"
+
+#include "samplerate.h"
+
+extern "C" {
+#include "libavutil/channel_layout.h"
+#include "libavutil/opt.h"
+#include "libswresample/swresample.h"
+}
+
+#define LOC QString("Resampler: ")
+
+/// \brief Resampling with libsamplerate's sinc converters.
+class AudioResamplerSRC : public AudioResampler
+{
+  public:
+    AudioResamplerSRC(int Channels, int InRate, int OutRate)
+      : AudioResampler(Channels, InRate, OutRate) {}
+
+    ~AudioResamplerSRC() override
+    {
+        if (m_ctx)
+            src_delete(m_ctx);
+    }
+
+    bool Init(int Quality)
+    {
+        int error = 0;
+        m_ctx = src_new(2 - Quality, m_channels, &error);
+        if (error)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error creating resampler: %1")
+                .arg(src_strerror(error)));
+            m_ctx = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    int Process(const float *In, int InFrames, float *Out, int OutFrames) override
+    {
+        SRC_DATA data {};
+        data.data_in       = In;
+        data.input_frames  = InFrames;
+        data.data_out      = Out;
+        data.output_frames = OutFrames;
+        data.src_ratio     = m_ratio;
+        int error = src_process(m_ctx, &data);
+        if (error)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error occurred while resampling audio: %1")
+                .arg(src_strerror(error)));
+            return -1;
+        }
+        return static_cast<int>(data.output_frames_gen);
+    }
+
+    bool Reset(void) override
+    {
+        int error = src_reset(m_ctx);
+        if (error)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error occurred while resetting resampler: %1")
+                .arg(src_strerror(error)));
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    SRC_STATE *m_ctx { nullptr };
+};
+
+/*! \brief Resampling with FFmpeg's libswresample.
+ *
+ * The quality presets trade the length of the polyphase filter against
+ * CPU. Medium uses the libswresample defaults.
+*/
+class AudioResamplerSWR : public AudioResampler
+{
+  public:
+    AudioResamplerSWR(int Channels, int InRate, int OutRate)
+      : AudioResampler(Channels, InRate, OutRate),
+        m_inRate(InRate),
+        m_outRate(OutRate)
+    {
+    }
+
+    ~AudioResamplerSWR() override
+    {
+        swr_free(&m_ctx);
+    }
+
+    bool Init(int Quality)
+    {
+        struct Preset { int m_filterSize; int m_phaseShift; double m_cutoff; };
+        static constexpr std::array<Preset,3> kPresets
+        {{
+            { 16,  8, 0.90 }, // low
+            { 32, 10, 0.97 }, // medium
+            { 64, 12, 0.98 }  // high
+        }};
+        const Preset & preset = kPresets.at(static_cast<size_t>(std::clamp(Quality, 0, 2)));
+
+        int64_t layout = av_get_default_channel_layout(m_channels);
+        m_ctx = swr_alloc_set_opts(nullptr, layout, AV_SAMPLE_FMT_FLT, m_outRate,
+                                   layout, AV_SAMPLE_FMT_FLT, m_inRate, 0, nullptr);
+        if (!m_ctx)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Error allocating resampler context");
+            return false;
+        }
+        av_opt_set_int(m_ctx, "filter_size", preset.m_filterSize, 0);
+        av_opt_set_int(m_ctx, "phase_shift", preset.m_phaseShift, 0);
+        av_opt_set_int(m_ctx, "linear_interp", 1, 0);
+        av_opt_set_double(m_ctx, "cutoff", preset.m_cutoff, 0);
+        int ret = swr_init(m_ctx);
+        if (ret < 0)
+        {
+            std::string error;
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error initializing resampler: %1")
+                .arg(av_make_error_stdstring(error, ret)));
+            swr_free(&m_ctx);
+            return false;
+        }
+        return true;
+    }
+
+    int Process(const float *In, int InFrames, float *Out, int OutFrames) override
+    {
+        const auto *in = reinterpret_cast<const uint8_t*>(In);
+        auto *out = reinterpret_cast<uint8_t*>(Out);
+        int frames = swr_convert(m_ctx, &out, OutFrames, &in, InFrames);
+        if (frames < 0)
+        {
+            std::string error;
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error occurred while resampling audio: %1")
+                .arg(av_make_error_stdstring(error, frames)));
+            return -1;
+        }
+        return frames;
+    }
+
+    bool Reset(void) override
+    {
+        // Re-initialising drops any buffered samples and the filter history
+        int ret = swr_init(m_ctx);
+        if (ret < 0)
+        {
+            std::string error;
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("Error occurred while resetting resampler: %1")
+                .arg(av_make_error_stdstring(error, ret)));
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    SwrContext *m_ctx     { nullptr };
+    int         m_inRate  { 0 };
+    int         m_outRate { 0 };
+};
+
+AudioResampler::AudioResampler(int Channels, int InRate, int OutRate)
+  : m_channels(Channels),
+    m_ratio(static_cast<double>(OutRate) / InRate)
+{
+}
+
+QString AudioResampler::BackendToString(Backend Type)
+{
+    switch (Type)
+    {
+        case kLibSampleRate: return "libsamplerate";
+        case kSwResample:    return "swresample";
+    }
+    return "unknown";
+}
+
+/// \brief Returns a resampler using the given backend, or nullptr on failure.
+AudioResampler* AudioResampler::Create(Backend Type, int Quality, int Channels,
+                                       int InRate, int OutRate)
+{
+    if (Channels < 1 || InRate < 1 || OutRate < 1)
+        return nullptr;
+
+    LOG(VB_AUDIO, LOG_INFO, LOC + QString("Creating %1 resampler: %2 channels %3Hz->%4Hz quality %5")
+        .arg(BackendToString(Type)).arg(Channels).arg(InRate).arg(OutRate).arg(Quality));
+
+    if (Type == kSwResample)
+    {
+        auto *resampler = new AudioResamplerSWR(Channels, InRate, OutRate);
+        if (resampler->Init(Quality))
+            return resampler;
+        delete resampler;
+        return nullptr;
+    }
+
+    auto *resampler = new AudioResamplerSRC(Channels, InRate, OutRate);
+    if (resampler->Init(Quality))
+        return resampler;
+    delete resampler;
+    return nullptr;
+}
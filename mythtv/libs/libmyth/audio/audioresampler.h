@@ -0,0 +1,53 @@
+#ifndef AUDIORESAMPLER_H
+#define AUDIORESAMPLER_H
+
+// Std
+#include <cstdint>
+
+// Qt
+#include <QString>
+
+// MythTV
+#include "mythexp.h"
+
+/*! \class AudioResampler
+ *  \brief Converts interleaved float audio from one sample rate to another.
+ *
+ *  Two backends are available: libsamplerate, and FFmpeg's libswresample,
+ *  whose SIMD filters are much cheaper when resampling many channels or
+ *  at high rates. Quality is one of the AudioOutputBase SRC qualities, i.e.
+ *  0 (fastest) to 2 (best).
+*/
+class MPUBLIC AudioResampler
+{
+  public:
+    enum Backend : std::uint8_t
+    {
+        kLibSampleRate = 0,
+        kSwResample    = 1
+    };
+
+    static AudioResampler* Create(Backend Type, int Quality, int Channels,
+                                  int InRate, int OutRate);
+    static QString BackendToString(Backend Type);
+    virtual ~AudioResampler() = default;
+
+    double  Ratio    (void) const { return m_ratio; }
+    int     Channels (void) const { return m_channels; }
+
+    /// \brief Resamples up to InFrames frames into Out, returning the number of frames written or -1.
+    virtual int  Process (const float *In, int InFrames, float *Out, int OutFrames) = 0;
+    /// \brief Discards any buffered input, e.g. after a seek.
+    virtual bool Reset   (void) = 0;
+
+  protected:
+    AudioResampler(int Channels, int InRate, int OutRate);
+
+    int    m_channels { 2 };
+    double m_ratio    { 1.0 };
+
+  private:
+    Q_DISABLE_COPY(AudioResampler)
+};
+
+#endif // AUDIORESAMPLER_H
@@ -112,6 +112,57 @@ void SPDIFEncoder::WriteFrame(unsigned char *data, int size)
     }
 }
 
+/**
+ * Encode data through created muxer, writing the IEC 61937 burst straight
+ * into dest rather than the internal buffer, which saves copying it out again
+ * with GetData.
+ * unsigned char data: pointer to data to encode
+ * int           size: size of data to encode
+ * unsigned char dest: where to write the burst, with room for kMaxBurstSize
+ *                     bytes
+ * Returns the number of bytes written to dest, which is 0 while the muxer is
+ * still collecting frames (TrueHD), or -1 on error.
+ */
+int SPDIFEncoder::WriteFrameDirect(unsigned char *data, int size,
+                                   unsigned char *dest)
+{
+    if ((m_oc == nullptr) || (m_oc->pb == nullptr))
+    {
+        LOG(VB_AUDIO, LOG_ERR, LOC + "WriteFrameDirect");
+        return -1;
+    }
+
+    // Every frame is flushed out through funcIO as it is written, so the I/O
+    // context's own buffer is empty here and can be swapped for dest while
+    // the frame is muxed.
+    AVIOContext   *pb         = m_oc->pb;
+    unsigned char *buffer     = pb->buffer;
+    int            bufferSize = pb->buffer_size;
+
+    pb->buffer      = dest;
+    pb->buf_ptr     = dest;
+    pb->buf_ptr_max = dest;
+    pb->buf_end     = dest + kMaxBurstSize;
+    pb->buffer_size = kMaxBurstSize;
+    m_direct        = true;
+    m_overflow      = false;
+    m_size          = 0;
+
+    WriteFrame(data, size);
+    avio_flush(pb);
+
+    pb->buffer      = buffer;
+    pb->buf_ptr     = buffer;
+    pb->buf_ptr_max = buffer;
+    pb->buf_end     = buffer + bufferSize;
+    pb->buffer_size = bufferSize;
+    m_direct        = false;
+
+    int written = m_overflow ? -1 : static_cast<int>(m_size);
+    m_size = 0;
+    return written;
+}
+
 /**
  * Retrieve encoded data and copy it in the provided buffer.
  * Return -1 if there is no data to retrieve.
@@ -187,6 +238,19 @@ int SPDIFEncoder::funcIO(void *opaque, unsigned char *buf, int size)
         return 0;
     }
 
+    if (enc->m_direct)
+    {
+        // The burst is already in place. A second flush means it was larger
+        // than kMaxBurstSize and has wrapped over itself.
+        if (enc->m_size > 0)
+        {
+            LOG(VB_AUDIO, LOG_ERR, LOC + "funcIO: burst too large");
+            enc->m_overflow = true;
+        }
+        enc->m_size += size;
+        return size;
+    }
+
     memcpy(enc->m_oc->pb->buffer + enc->m_size, buf, size);
     enc->m_size += size;
     return size;
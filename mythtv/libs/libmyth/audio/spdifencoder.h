@@ -14,9 +14,14 @@ extern "C" {
 class MPUBLIC SPDIFEncoder
 {
   public:
+    /// Largest IEC 61937 burst the spdif muxer writes for one frame: a DTS-HD
+    /// burst with the longest (16384 frame) repetition period.
+    static const int kMaxBurstSize = 65536;
+
     SPDIFEncoder(const QString& muxer, AVCodecID codec_id);
     ~SPDIFEncoder();
     void WriteFrame(unsigned char *data, int size);
+    int  WriteFrameDirect(unsigned char *data, int size, unsigned char *dest);
     int  GetData(unsigned char *buffer, size_t &dest_size);
     int  GetProcessedSize();
     unsigned char *GetProcessedBuffer();
@@ -32,6 +37,8 @@ class MPUBLIC SPDIFEncoder
     bool                m_complete {false};
     AVFormatContext    *m_oc       {nullptr};
     long                m_size     {0};
+    bool                m_direct   {false};
+    bool                m_overflow {false};
 };
 
 #endif
@@ -31,6 +31,8 @@ contains(INCLUDEPATH, /usr/X11R6/include) {
 HEADERS += audio/audiooutput.h audio/audiooutputbase.h audio/audiooutputnull.h
 HEADERS += audio/audiooutpututil.h audio/audiooutputdownmix.h
 HEADERS += audio/audioconvert.h
+HEADERS += audio/audiokernels.h
+HEADERS += audio/audioresampler.h
 HEADERS += audio/audiooutputdigitalencoder.h audio/spdifencoder.h
 HEADERS += audio/audiosettings.h audio/audiooutputsettings.h audio/pink.h
 HEADERS += audio/volumebase.h audio/eldutils.h
@@ -51,6 +53,7 @@ HEADERS += remoteutil.h
 HEADERS += rawsettingseditor.h
 HEADERS += programinfo.h          programinfoupdater.h
 HEADERS += programtypes.h         recordingtypes.h
+HEADERS += recordingseekindex.h
 HEADERS += rssparse.h
 HEADERS += guistartup.h
 
@@ -59,6 +62,8 @@ SOURCES += audio/spdifencoder.cpp audio/audiooutputdigitalencoder.cpp
 SOURCES += audio/audiooutputnull.cpp
 SOURCES += audio/audiooutpututil.cpp audio/audiooutputdownmix.cpp
 SOURCES += audio/audioconvert.cpp
+SOURCES += audio/audiokernels.cpp
+SOURCES += audio/audioresampler.cpp
 SOURCES += audio/audiosettings.cpp audio/audiooutputsettings.cpp audio/pink.cpp
 SOURCES += audio/volumebase.cpp audio/eldutils.cpp
 SOURCES += audio/audiooutputgraph.cpp
@@ -77,6 +82,7 @@ SOURCES += remoteutil.cpp
 SOURCES += rawsettingseditor.cpp
 SOURCES += programinfo.cpp        programinfoupdater.cpp
 SOURCES += programtypes.cpp       recordingtypes.cpp
+SOURCES += recordingseekindex.cpp
 SOURCES += rssparse.cpp
 SOURCES += guistartup.cpp
 
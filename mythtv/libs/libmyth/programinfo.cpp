@@ -20,6 +20,7 @@ using std::min;
 
 // MythTV headers
 #include "programinfoupdater.h"
+#include "recordingseekindex.h"
 #include "mythcorecontext.h"
 #include "mythscheduler.h"
 #include "mythmiscutil.h"
@@ -3660,6 +3661,24 @@ void ProgramInfo::ClearPositionMap(MarkTypes type) const
                       " AND type = :TYPE ;");
         query.bindValue(":CHANID", m_chanId);
         query.bindValue(":STARTTIME", m_recStartTs);
+
+        // The seek index written by the recorder is stale once the
+        // position map is cleared for rebuilding (transcode, commflag).
+        if (type == MARK_KEYFRAME || type == MARK_GOP_START ||
+            type == MARK_GOP_BYFRAME)
+        {
+            // Resolve a bare basename once, then reuse it for the rest
+            // of the position map types
+            QString path = m_pathname;
+            if (!IsLocal())
+            {
+                StorageGroup sgroup(m_storageGroup);
+                path = sgroup.FindFile(QueryBasename());
+                if (!IsPathSet() && !path.isEmpty())
+                    m_pathname = path;
+            }
+            RecordingSeekIndex::Remove(path);
+        }
     }
     else
     {
@@ -0,0 +1,290 @@
+// C++ headers
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <sys/stat.h>
+
+// MythTV headers
+#include "recordingseekindex.h"
+#include "mythlogging.h"
+
+#define LOC QString("SeekIndex(%1): ").arg(m_file.fileName())
+
+namespace
+{
+struct SeekIndexHeader
+{
+    std::array<char,8> magic;
+    uint32_t           version;
+    int32_t            markType;
+};
+
+const std::array<char,8> kSeekIndexMagic { 'M','Y','T','H','S','E','E','K' };
+const uint32_t           kSeekIndexVersion { 1 };
+}
+
+static_assert(sizeof(SeekIndexHeader) == 16, "SeekIndexHeader must be packed");
+static_assert(sizeof(RecordingSeekIndex::Entry) == 24, "Entry must be packed");
+
+QString RecordingSeekIndex::IndexFilename(const QString &recording)
+{
+    return recording + ".seekidx";
+}
+
+/// Removes the seek index of a recording whose position map is being
+/// replaced, so that readers fall back to the database.
+bool RecordingSeekIndex::Remove(const QString &recording)
+{
+    if (recording.isEmpty() || recording.startsWith("myth://"))
+        return false;
+
+    QString filename = IndexFilename(recording);
+    if (!QFile::exists(filename))
+        return true;
+    return QFile::remove(filename);
+}
+
+/** \brief Creates a new, empty index for the recording, replacing
+ *         any existing one.
+ *
+ *  The old file is unlinked rather than truncated, since a player may
+ *  still have it mapped.
+ */
+bool RecordingSeekIndex::Create(const QString &recording, MarkTypes type)
+{
+    Close();
+
+    m_file.setFileName(IndexFilename(recording));
+    if (m_file.exists())
+        m_file.remove();
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + "Unable to create: " +
+            m_file.errorString());
+        return false;
+    }
+
+    SeekIndexHeader header {kSeekIndexMagic, kSeekIndexVersion,
+                            static_cast<int32_t>(type)};
+    if (m_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) !=
+        sizeof(header) || !m_file.flush())
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + "Unable to write header: " +
+            m_file.errorString());
+        Close();
+        return false;
+    }
+
+    m_writing  = true;
+    m_markType = type;
+    return true;
+}
+
+/** \brief Appends the keyframes in posMap, which must all follow the
+ *         ones already written, with their durations from durMap.
+ */
+bool RecordingSeekIndex::Append(const frm_pos_map_t &posMap,
+                                const frm_pos_map_t &durMap)
+{
+    if (!m_writing || posMap.empty())
+        return m_writing;
+
+    std::vector<Entry> entries;
+    entries.reserve(posMap.size());
+    for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+        entries.push_back({it.key(), *it, durMap.value(it.key(), -1)});
+
+    // Write all entries at once, so a concurrent reader at most sees
+    // a partial entry at the end of the file.
+    qint64 len = entries.size() * sizeof(Entry);
+    if (m_file.write(reinterpret_cast<const char*>(entries.data()), len) != len ||
+        !m_file.flush())
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + "Unable to append: " +
+            m_file.errorString());
+        return false;
+    }
+
+    m_entryCount += entries.size();
+    return true;
+}
+
+/** \brief Opens and maps the index of the recording for reading.
+ */
+bool RecordingSeekIndex::Open(const QString &recording)
+{
+    Close();
+
+    if (recording.isEmpty() || recording.startsWith("myth://"))
+        return false;
+
+    m_file.setFileName(IndexFilename(recording));
+    return OpenFile();
+}
+
+bool RecordingSeekIndex::OpenFile(void)
+{
+    if (!m_file.exists() || !m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    SeekIndexHeader header {};
+    if (m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) !=
+        sizeof(header) || header.magic != kSeekIndexMagic ||
+        header.version != kSeekIndexVersion)
+    {
+        LOG(VB_PLAYBACK, LOG_WARNING, LOC + "Invalid header, ignoring");
+        Close();
+        return false;
+    }
+
+    m_markType = static_cast<MarkTypes>(header.markType);
+    if (!Map())
+    {
+        Close();
+        return false;
+    }
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Opened with %1 entries")
+        .arg(m_entryCount));
+    return true;
+}
+
+/** \brief Remaps the index if the recorder has appended to it since
+ *         it was opened.
+ *
+ *  If the recorder has started a new index in its place, that is opened
+ *  instead and the generation is incremented, since the entries may not
+ *  follow on from the old ones. The index is closed if there is none.
+ *  \return true if there are new entries.
+ */
+bool RecordingSeekIndex::Refresh(void)
+{
+    if (m_writing || !m_file.isOpen())
+        return false;
+
+    if (IsReplaced())
+    {
+        LOG(VB_PLAYBACK, LOG_INFO, LOC + "Replaced, reopening");
+        uint generation = m_generation;
+        QString filename = m_file.fileName();
+        Close();
+        m_file.setFileName(filename);
+        OpenFile();
+        m_generation = generation + 1;
+        return true;
+    }
+
+    uint64_t old_count = m_entryCount;
+    uint64_t new_count = (m_file.size() - sizeof(SeekIndexHeader)) / sizeof(Entry);
+    if (new_count <= old_count)
+        return false;
+
+    return Map() && (m_entryCount > old_count);
+}
+
+/// \return true if the file has been unlinked, replaced or truncated
+///         since it was opened.
+bool RecordingSeekIndex::IsReplaced(void)
+{
+    uint64_t mapped = sizeof(SeekIndexHeader) + (m_entryCount * sizeof(Entry));
+    if (m_file.size() < static_cast<qint64>(mapped))
+        return true;
+
+    struct stat opened {};
+    struct stat named {};
+    if (fstat(m_file.handle(), &opened) != 0)
+        return false;
+    if (stat(m_file.fileName().toLocal8Bit().constData(), &named) != 0)
+        return true;
+    return (opened.st_dev != named.st_dev) || (opened.st_ino != named.st_ino);
+}
+
+bool RecordingSeekIndex::Map(void)
+{
+    if (m_map)
+    {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_entries = nullptr;
+        m_entryCount = 0;
+    }
+
+    qint64 size = m_file.size();
+    if (size < static_cast<qint64>(sizeof(SeekIndexHeader)))
+        return false;
+
+    uint64_t count = (size - sizeof(SeekIndexHeader)) / sizeof(Entry);
+    if (count == 0)
+        return true;
+
+    m_map = m_file.map(0, sizeof(SeekIndexHeader) + (count * sizeof(Entry)));
+    if (!m_map)
+    {
+        LOG(VB_PLAYBACK, LOG_ERR, LOC + "Unable to map: " +
+            m_file.errorString());
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const Entry*>(m_map + sizeof(SeekIndexHeader));
+    m_entryCount = count;
+
+    // FindByDuration() can only binary search durations that are all
+    // known and never go backwards, so check the new entries once.
+    for (; m_checkedCount < count && m_durations; m_checkedCount++)
+    {
+        int64_t duration = m_entries[m_checkedCount].duration;
+        m_durations = (duration >= m_lastDuration);
+        m_lastDuration = duration;
+    }
+    m_checkedCount = count;
+
+    return true;
+}
+
+/// \return number of the last entry with an index <= index, or -1
+int64_t RecordingSeekIndex::FindByIndex(int64_t index) const
+{
+    const Entry *end = m_entries + m_entryCount;
+    const Entry *it = std::upper_bound(m_entries, end, index,
+        [](int64_t val, const Entry &e) { return val < e.index; });
+    return (it - m_entries) - 1;
+}
+
+/// \return number of the last entry with an offset <= offset, or -1
+int64_t RecordingSeekIndex::FindByOffset(int64_t offset) const
+{
+    const Entry *end = m_entries + m_entryCount;
+    const Entry *it = std::upper_bound(m_entries, end, offset,
+        [](int64_t val, const Entry &e) { return val < e.offset; });
+    return (it - m_entries) - 1;
+}
+
+/// \return number of the last entry with a duration <= duration, or -1,
+///         or -1 if not every entry has a duration, see HasDurations()
+int64_t RecordingSeekIndex::FindByDuration(int64_t duration) const
+{
+    if (!HasDurations())
+        return -1;
+
+    const Entry *end = m_entries + m_entryCount;
+    const Entry *it = std::upper_bound(m_entries, end, duration,
+        [](int64_t val, const Entry &e) { return val < e.duration; });
+    return (it - m_entries) - 1;
+}
+
+void RecordingSeekIndex::Close(void)
+{
+    if (m_map)
+        m_file.unmap(m_map);
+    m_map = nullptr;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_writing = false;
+    m_markType = MARK_UNSET;
+    m_durations = true;
+    m_checkedCount = 0;
+    m_lastDuration = 0;
+    if (m_file.isOpen())
+        m_file.close();
+}
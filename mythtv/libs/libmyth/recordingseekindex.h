@@ -0,0 +1,81 @@
+#ifndef RECORDING_SEEK_INDEX_H
+#define RECORDING_SEEK_INDEX_H
+
+// C++ headers
+#include <cstdint> // for [u]int[32,64]_t
+
+// Qt headers
+#include <QString>
+#include <QFile>
+
+// Myth
+#include "mythexp.h"
+#include "programtypes.h"
+
+/** \class RecordingSeekIndex
+ *  \brief Append-only binary seek index stored next to a recording.
+ *
+ *  The recorder appends one fixed size entry per keyframe as it saves
+ *  its position map, and the decoder memory maps the file and binary
+ *  searches it, so starting playback and seeking in a long recording
+ *  does not have to read the recordedseek table back from MySQL.
+ *
+ *  The file is a 16 byte header (magic, version and the MarkTypes of
+ *  the position map) followed by Entry records in ascending index
+ *  order, all in host byte order. A partially written trailing entry
+ *  is ignored by readers.
+ */
+class MPUBLIC RecordingSeekIndex
+{
+  public:
+    struct Entry
+    {
+        int64_t index;    ///< position map key (keyframe or frame number)
+        int64_t offset;   ///< byte offset in the recording
+        int64_t duration; ///< milliseconds, or -1 if not known
+    };
+
+    RecordingSeekIndex() = default;
+    ~RecordingSeekIndex() { Close(); }
+
+    static QString IndexFilename(const QString &recording);
+    static bool    Remove(const QString &recording);
+
+    // Writing
+    bool Create(const QString &recording, MarkTypes type);
+    bool Append(const frm_pos_map_t &posMap, const frm_pos_map_t &durMap);
+
+    // Reading
+    bool Open(const QString &recording);
+    bool Refresh(void);
+    MarkTypes GetMarkType(void) const { return m_markType; }
+    uint      GetGeneration(void) const { return m_generation; }
+    uint64_t  GetEntryCount(void) const { return m_entryCount; }
+    bool      HasDurations(void) const { return m_durations && m_entryCount; }
+    Entry     GetEntry(uint64_t num) const { return m_entries[num]; }
+    int64_t   FindByIndex(int64_t index) const;
+    int64_t   FindByOffset(int64_t offset) const;
+    int64_t   FindByDuration(int64_t duration) const;
+
+    QString GetFilename(void) const { return m_file.fileName(); }
+    bool IsOpen(void) const { return m_file.isOpen(); }
+    void Close(void);
+
+  private:
+    bool OpenFile(void);
+    bool IsReplaced(void);
+    bool Map(void);
+
+    QFile         m_file;
+    bool          m_writing      {false};
+    MarkTypes     m_markType     {MARK_UNSET};
+    uint          m_generation   {0};
+    uchar        *m_map          {nullptr};
+    const Entry  *m_entries      {nullptr};
+    uint64_t      m_entryCount   {0};
+    bool          m_durations    {true};
+    uint64_t      m_checkedCount {0};
+    int64_t       m_lastDuration {0};
+};
+
+#endif // RECORDING_SEEK_INDEX_H
@@ -3,6 +3,7 @@ include (../../../settings.pro)
 TEMPLATE = subdirs
 
 SUBDIRS += $$files(test_*)
+!using_alsa:SUBDIRS -= test_audiooutputalsa
 
 unittest.target = test
 unittest.commands = ../../../programs/scripts/unittests.sh
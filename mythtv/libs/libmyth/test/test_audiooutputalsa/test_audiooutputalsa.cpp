@@ -0,0 +1,3 @@
+#include "test_audiooutputalsa.h"
+
+QTEST_APPLESS_MAIN(TestAudioOutputALSA)
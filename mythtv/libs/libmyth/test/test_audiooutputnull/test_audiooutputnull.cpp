@@ -0,0 +1,3 @@
+#include "test_audiooutputnull.h"
+
+QTEST_APPLESS_MAIN(TestAudioOutputNull)
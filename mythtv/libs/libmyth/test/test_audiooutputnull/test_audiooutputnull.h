@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include "mythcorecontext.h"
+#include "audiooutputnull.h"
+
+using namespace std::chrono_literals;
+
+/*
+ * A null output that opens successfully and blocks in WriteAudio for as
+ * long as each fragment would take to play, like a real device, so that
+ * the output thread runs. It records how late the output thread is in
+ * coming back for each fragment, and everything written.
+*/
+class PacedOutputNull : public AudioOutputNULL
+{
+  public:
+    static constexpr int kFragmentFrames = 480; // 10ms at 48kHz
+    static constexpr std::chrono::milliseconds kFragmentTime { 10ms };
+
+    explicit PacedOutputNull(const AudioSettings &Settings)
+      : AudioOutputNULL(Settings) {}
+
+    ~PacedOutputNull() override
+    {
+        KillAudio();
+    }
+
+    std::vector<std::chrono::microseconds> Lateness(void)
+    {
+        QMutexLocker locker(&m_latenessLock);
+        return m_lateness;
+    }
+
+    std::vector<unsigned char> Written(void)
+    {
+        QMutexLocker locker(&m_latenessLock);
+        return m_written;
+    }
+
+  protected:
+    bool OpenDevice(void) override
+    {
+        AudioOutputNULL::OpenDevice();
+        m_fragmentSize = kFragmentFrames * m_outputBytesPerFrame;
+        m_soundcardBufferSize = m_fragmentSize * 4;
+        return true;
+    }
+
+    void WriteAudio(unsigned char* aubuf, int size) override
+    {
+        {
+            QMutexLocker locker(&m_latenessLock);
+            m_written.insert(m_written.end(), aubuf, aubuf + size);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (size == m_fragmentSize)
+        {
+            if (m_started)
+            {
+                QMutexLocker locker(&m_latenessLock);
+                m_lateness.push_back(std::max(0us,
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - m_deadline)));
+            }
+            else
+            {
+                m_deadline = now;
+                m_started = true;
+            }
+        }
+        m_deadline = std::max(m_deadline, now) + std::chrono::microseconds(
+            1000000LL * size / (m_outputBytesPerFrame * 48000));
+        std::this_thread::sleep_until(m_deadline);
+    }
+
+    int GetBufferedOnSoundcard(void) const override
+    {
+        return 0;
+    }
+
+  private:
+    bool m_started { false };
+    std::chrono::steady_clock::time_point m_deadline;
+    QMutex m_latenessLock;
+    std::vector<std::chrono::microseconds> m_lateness;
+    std::vector<unsigned char> m_written;
+};
+
+class TestAudioOutputNull: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    // called at the beginning of these sets of tests
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+    }
+
+    static void Processing_data(void)
+    {
+        QTest::addColumn<bool>("volume");
+        QTest::addColumn<float>("stretch");
+        QTest::addColumn<int>("upmix");
+
+        QTest::newRow("copy")                 << false << 1.0F << 1;
+        QTest::newRow("volume")               << true  << 1.0F << 1;
+        QTest::newRow("volume+stretch")       << true  << 1.5F << 1;
+        QTest::newRow("upmix+volume")         << true  << 1.0F << 2;
+        QTest::newRow("upmix+stretch+volume") << true  << 1.5F << 2;
+    }
+
+    /*
+     * Measures the cost of the float processing stages in AddData, feeding
+     * two seconds of stereo audio in 10ms packets with the output paused,
+     * and reports how much ends up in the audiobuffer.
+    */
+    static void Processing(void)
+    {
+        QFETCH(bool, volume);
+        QFETCH(float, stretch);
+        QFETCH(int, upmix);
+
+        AudioSettings settings("NULL", "NULL", FORMAT_S16, 2, AV_CODEC_ID_NONE,
+                               48000, AUDIOOUTPUT_VIDEO, false, false, upmix);
+        settings.m_init = false;
+        PacedOutputNull output(settings);
+        output.SWVolume(volume);
+        output.Reconfigure(settings);
+        QVERIFY(output.GetError().isEmpty());
+        QCOMPARE(output.IsUpmixing(), upmix == 2);
+        output.SetStretchFactor(stretch);
+        output.Pause(true);
+
+        static constexpr int kFrames  = PacedOutputNull::kFragmentFrames;
+        static constexpr int kPackets = 200;
+        std::vector<int16_t> samples(kFrames * 2);
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> distribution(-16384, 16383);
+        for (auto & sample : samples)
+            sample = static_cast<int16_t>(distribution(generator));
+
+        uint fill = 0;
+        uint total = 0;
+        QBENCHMARK
+        {
+            output.Reset();
+            std::chrono::milliseconds timecode = 0ms;
+            for (int i = 0; i < kPackets; ++i)
+            {
+                output.AddData(samples.data(), static_cast<int>(samples.size() * sizeof(int16_t)),
+                               timecode, kFrames);
+                timecode += 10ms;
+            }
+            output.GetBufferStatus(fill, total);
+        }
+        QVERIFY(fill > 0);
+        qInfo() << "Input bytes" << kPackets * samples.size() * sizeof(int16_t)
+                << "audiobuffer bytes" << fill;
+    }
+
+    /*
+     * Feeds the ring buffer from one thread while another hammers the A/V
+     * sync queries, as the decoder and video output threads do, and reports
+     * how late the output thread is in writing each fragment.
+    */
+    static void OutputJitter(void)
+    {
+        AudioSettings settings("NULL", "NULL", FORMAT_S16, 2, AV_CODEC_ID_NONE,
+                               48000, AUDIOOUTPUT_VIDEO, false, false);
+        settings.m_init = false;
+        PacedOutputNull output(settings);
+        output.Reconfigure(settings);
+        QVERIFY(output.GetError().isEmpty());
+        output.Pause(false);
+
+        std::atomic_bool stop { false };
+        std::thread producer([&]()
+        {
+            static constexpr int kFrames = PacedOutputNull::kFragmentFrames;
+            std::vector<int16_t> samples(kFrames * 2, 0);
+            std::chrono::milliseconds timecode = 0ms;
+            auto next = std::chrono::steady_clock::now();
+            while (!stop)
+            {
+                // Keep about 100ms ahead of the output
+                if (output.GetAudioBufferedTime() < 100ms)
+                {
+                    output.AddData(samples.data(), static_cast<int>(samples.size() * sizeof(int16_t)),
+                                   timecode, kFrames);
+                    timecode += 10ms;
+                    continue;
+                }
+                next += 2ms;
+                std::this_thread::sleep_until(next);
+            }
+        });
+
+        std::atomic<int64_t> queries { 0 };
+        std::thread sync([&]()
+        {
+            while (!stop)
+            {
+                output.GetAudiotime();
+                output.GetAudioBufferedTime();
+                ++queries;
+                std::this_thread::yield();
+            }
+        });
+
+        std::this_thread::sleep_for(2s);
+        stop = true;
+        producer.join();
+        sync.join();
+        output.Pause(true);
+
+        // The output thread must have kept going, 2s is 200 fragments
+        std::vector<std::chrono::microseconds> lateness = output.Lateness();
+        QVERIFY(lateness.size() > 20);
+        QVERIFY(queries > 0);
+
+        // How late it was depends on the machine's load, so only report it
+        std::chrono::microseconds total = 0us;
+        for (auto late : lateness)
+            total += late;
+        std::chrono::microseconds average = total / static_cast<int64_t>(lateness.size());
+        std::sort(lateness.begin(), lateness.end());
+        std::chrono::microseconds p99 = lateness[lateness.size() * 99 / 100];
+        std::chrono::microseconds worst = lateness.back();
+        qInfo() << "Fragments" << lateness.size() << "sync queries" << queries.load()
+                << "lateness avg" << average.count() << "us 99%" << p99.count()
+                << "us max" << worst.count() << "us";
+    }
+
+    /*
+     * Hands the output over from one producer thread to another without
+     * draining it, as mythmusic's decoders do between tracks. The second
+     * starts at the timecode the first one queued up to, and every sample
+     * must come out once and in order.
+    */
+    static void Handover(void)
+    {
+        AudioSettings settings("NULL", "NULL", FORMAT_S16, 2, AV_CODEC_ID_NONE,
+                               48000, AUDIOOUTPUT_MUSIC, false, false);
+        settings.m_init = false;
+        PacedOutputNull output(settings);
+        output.Reconfigure(settings);
+        QVERIFY(output.GetError().isEmpty());
+        output.Pause(false);
+
+        // two 500ms tracks of a ramp that never hits zero
+        static constexpr int kFrames  = PacedOutputNull::kFragmentFrames;
+        static constexpr int kPackets = 50;
+        std::vector<int16_t> ramp(static_cast<size_t>(kFrames) * 2 * kPackets * 2);
+        for (size_t i = 0; i < ramp.size(); i++)
+            ramp[i] = static_cast<int16_t>(1 + ((i / 2) % 30000));
+
+        // decode packets, staying up to 100ms ahead like avfDecoder
+        auto feed = [&](int First, int Last)
+        {
+            for (int i = First; i < Last; )
+            {
+                if (output.GetAudioBufferedTime() >= 100ms)
+                {
+                    std::this_thread::sleep_for(2ms);
+                    continue;
+                }
+                output.AddData(&ramp[static_cast<size_t>(i) * kFrames * 2],
+                               kFrames * 2 * static_cast<int>(sizeof(int16_t)),
+                               -1ms, kFrames);
+                i++;
+            }
+        };
+
+        std::thread first([&]() { feed(0, kPackets); });
+        first.join();
+
+        // the first track has ended, without draining, and the next one
+        // starts where it left off, like in avfDecoder::run()
+        std::chrono::milliseconds start = 0ms;
+        std::thread second([&]()
+        {
+            start = output.GetAudioQueuedTime();
+            feed(kPackets, kPackets * 2);
+        });
+        second.join();
+        output.Drain();
+        output.Pause(true);
+
+        qInfo() << "Next track starts at" << start.count() << "ms";
+        QVERIFY(start >= 500ms - PacedOutputNull::kFragmentTime);
+        QVERIFY(start <= 500ms + PacedOutputNull::kFragmentTime);
+
+        // Drain leaves up to a fragment behind, and silence leads
+        std::vector<unsigned char> written = output.Written();
+        size_t begin = 0;
+        while (begin < written.size() && written[begin] == 0)
+            begin++;
+        begin &= ~static_cast<size_t>(3);
+        size_t size = written.size() - begin;
+        size_t total = ramp.size() * sizeof(int16_t);
+        QVERIFY(size + (kFrames * 4) >= total);
+        QVERIFY(size <= total);
+        QVERIFY(memcmp(written.data() + begin, ramp.data(), size) == 0);
+    }
+};
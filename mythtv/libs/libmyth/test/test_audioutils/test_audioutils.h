@@ -19,11 +19,17 @@
  */
 
 #include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
 
 #include <QtTest/QtTest>
 
 #include "mythcorecontext.h"
 #include "audiooutpututil.h"
+#include "audiokernels.h"
+#include "audioresampler.h"
 #include "pink.h"
 
 #define SSEALIGN 16     // for 16 bytes memory alignment
@@ -918,6 +924,247 @@ class TestAudioUtils: public QObject
         av_free(arrayf3);
     }
 
+    static void Kernels_data(void)
+    {
+        QTest::addColumn<int>("KERNELS");
+        std::vector<const AudioKernels*> available = AudioKernels::Available();
+        for (size_t i = 0; i < available.size(); i++)
+            QTest::newRow(available[i]->m_name) << static_cast<int>(i);
+    }
+
+    // test every kernel is bit exact with the C reference, including the
+    // remainders left over by the SIMD loops
+    static void Kernels(void)
+    {
+        QFETCH(int, KERNELS);
+        const auto & ref = AudioKernels::Scalar();
+        const auto & test = *AudioKernels::Available().at(static_cast<size_t>(KERNELS));
+
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> floats(-2.0F, 2.0F);
+        std::uniform_int_distribution<int32_t> ints(INT32_MIN, INT32_MAX);
+
+        for (int len : { 0, 1, 3, 7, 15, 16, 17, 31, 33, 63, 1023, 4096 })
+        {
+            std::vector<float> input(static_cast<size_t>(len));
+            std::vector<int32_t> input32(static_cast<size_t>(len));
+            std::vector<int16_t> input16(static_cast<size_t>(len));
+            std::vector<uint8_t> input8(static_cast<size_t>(len));
+            // boundaries and values half way between two integers
+            static const std::array<float,8> kSpecial
+                { -1.0F, 1.0F, -0.5F, 0.5F, 0.0F, 0.5F / 128, 1.5F / 32768, 1.0F - 1.0F / 65536 };
+            for (int i = 0; i < len; i++)
+            {
+                input[i]   = (i % 5 == 0) ? kSpecial[(i / 5) % kSpecial.size()] : floats(generator);
+                input32[i] = ints(generator);
+                input16[i] = static_cast<int16_t>(input32[i]);
+                input8[i]  = static_cast<uint8_t>(input32[i]);
+            }
+
+            std::vector<float> outf1(input.size());
+            std::vector<float> outf2(input.size());
+            std::vector<int32_t> out321(input.size());
+            std::vector<int32_t> out322(input.size());
+            std::vector<int16_t> out161(input.size());
+            std::vector<int16_t> out162(input.size());
+            std::vector<uint8_t> out81(input.size());
+            std::vector<uint8_t> out82(input.size());
+
+            QCOMPARE(test.m_toFloat8(outf2.data(), input8.data(), len),
+                     ref.m_toFloat8(outf1.data(), input8.data(), len));
+            QVERIFY(outf1 == outf2);
+            QCOMPARE(test.m_fromFloat8(out82.data(), input.data(), len),
+                     ref.m_fromFloat8(out81.data(), input.data(), len));
+            QVERIFY(out81 == out82);
+            QCOMPARE(test.m_toFloat16(outf2.data(), input16.data(), len),
+                     ref.m_toFloat16(outf1.data(), input16.data(), len));
+            QVERIFY(outf1 == outf2);
+            QCOMPARE(test.m_fromFloat16(out162.data(), input.data(), len),
+                     ref.m_fromFloat16(out161.data(), input.data(), len));
+            QVERIFY(out161 == out162);
+
+            // S32, S24 and S24LSB
+            for (auto [shift, bits] : { std::pair(0, 32), std::pair(8, 24), std::pair(0, 24) })
+            {
+                float scale = 1.0F / static_cast<float>(1U << (bits - 1));
+                QCOMPARE(test.m_toFloat32(outf2.data(), input32.data(), len, shift, scale),
+                         ref.m_toFloat32(outf1.data(), input32.data(), len, shift, scale));
+                QVERIFY(outf1 == outf2);
+                QCOMPARE(test.m_fromFloat32(out322.data(), input.data(), len, shift, bits),
+                         ref.m_fromFloat32(out321.data(), input.data(), len, shift, bits));
+                QVERIFY(out321 == out322);
+            }
+
+            QCOMPARE(test.m_fromFloatFLT(outf2.data(), input.data(), len),
+                     ref.m_fromFloatFLT(outf1.data(), input.data(), len));
+            QVERIFY(outf1 == outf2);
+
+            outf1 = input;
+            outf2 = input;
+            ref.m_scale(outf1.data(), len, 0.7F);
+            test.m_scale(outf2.data(), len, 0.7F);
+            QVERIFY(outf1 == outf2);
+
+            // stereo, so len is taken as the number of samples and len / 2 as frames
+            int frames = len / 2;
+            ref.m_deinterleave16(out161.data(), input16.data(), frames);
+            test.m_deinterleave16(out162.data(), input16.data(), frames);
+            QVERIFY(out161 == out162);
+            ref.m_deinterleave32(out321.data(), input32.data(), frames);
+            test.m_deinterleave32(out322.data(), input32.data(), frames);
+            QVERIFY(out321 == out322);
+            ref.m_interleave16(out161.data(), input16.data(), input16.data() + frames, frames);
+            test.m_interleave16(out162.data(), input16.data(), input16.data() + frames, frames);
+            QVERIFY(out161 == out162);
+            ref.m_interleave32(out321.data(), input32.data(), input32.data() + frames, frames);
+            test.m_interleave32(out322.data(), input32.data(), input32.data() + frames, frames);
+            QVERIFY(out321 == out322);
+            for (int channel : { 0, 1 })
+            {
+                out161 = out162 = input16;
+                ref.m_muteChannel16(out161.data(), channel, frames);
+                test.m_muteChannel16(out162.data(), channel, frames);
+                QVERIFY(out161 == out162);
+                out321 = out322 = input32;
+                ref.m_muteChannel32(out321.data(), channel, frames);
+                test.m_muteChannel32(out322.data(), channel, frames);
+                QVERIFY(out321 == out322);
+            }
+        }
+    }
+
+    static void KernelsSpeed_data(void)
+    {
+        Kernels_data();
+    }
+
+    // a stereo S16 round trip through float with a volume change
+    static void KernelsSpeed(void)
+    {
+        QFETCH(int, KERNELS);
+        const auto & kernels = *AudioKernels::Available().at(static_cast<size_t>(KERNELS));
+
+        static constexpr int kFrames = 4096;
+        std::vector<int16_t> samples(kFrames * 2);
+        std::vector<int16_t> planar(kFrames * 2);
+        std::vector<float> floats(kFrames * 2);
+        std::mt19937 generator(1234);
+        std::uniform_int_distribution<int> ints(INT16_MIN, INT16_MAX);
+        for (auto & sample : samples)
+            sample = static_cast<int16_t>(ints(generator));
+
+        QBENCHMARK
+        {
+            for (int i = 0; i < 32; i++)
+            {
+                kernels.m_deinterleave16(planar.data(), samples.data(), kFrames);
+                kernels.m_interleave16(samples.data(), planar.data(), planar.data() + kFrames, kFrames);
+                kernels.m_toFloat16(floats.data(), samples.data(), kFrames * 2);
+                kernels.m_scale(floats.data(), kFrames * 2, 1.0F);
+                kernels.m_fromFloat16(samples.data(), floats.data(), kFrames * 2);
+            }
+        }
+    }
+
+    static void Resampler_data(void)
+    {
+        QTest::addColumn<int>("BACKEND");
+        QTest::addColumn<int>("QUALITY");
+        QTest::addColumn<int>("INRATE");
+        QTest::addColumn<int>("OUTRATE");
+        for (auto backend : { AudioResampler::kLibSampleRate, AudioResampler::kSwResample })
+        {
+            for (int quality : { 0, 1, 2 })
+            {
+                for (auto [in, out] : { std::pair(44100, 48000), std::pair(96000, 192000) })
+                {
+                    QString name = QString("%1 quality %2 %3->%4")
+                        .arg(AudioResampler::BackendToString(backend)).arg(quality).arg(in).arg(out);
+                    QTest::newRow(name.toLocal8Bit().constData())
+                        << static_cast<int>(backend) << quality << in << out;
+                }
+            }
+        }
+    }
+
+    // 8 channels of a 1kHz tone, fed in AudioOutputBase sized chunks
+    static void Resampler(void)
+    {
+        QFETCH(int, BACKEND);
+        QFETCH(int, QUALITY);
+        QFETCH(int, INRATE);
+        QFETCH(int, OUTRATE);
+
+        static constexpr int kChannels = 8;
+        static constexpr int kChunk = 16384 / kChannels;
+        std::unique_ptr<AudioResampler> resampler
+            { AudioResampler::Create(static_cast<AudioResampler::Backend>(BACKEND),
+                                     QUALITY, kChannels, INRATE, OUTRATE) };
+        QVERIFY(resampler);
+        QCOMPARE(resampler->Ratio(), static_cast<double>(OUTRATE) / INRATE);
+
+        std::vector<float> input(static_cast<size_t>(kChunk * kChannels));
+        std::vector<float> output(static_cast<size_t>(lround(kChunk * resampler->Ratio() + 64) * kChannels));
+        int outframes = static_cast<int>(output.size()) / kChannels;
+        int total = 0;
+        for (int done = 0; done < INRATE; done += kChunk)
+        {
+            for (int i = 0; i < kChunk; i++)
+            {
+                float sample = 0.5F * std::sin(2.0F * static_cast<float>(M_PI) * 1000.0F * (done + i) / INRATE);
+                for (int j = 0; j < kChannels; j++)
+                    input[static_cast<size_t>(i * kChannels + j)] = sample;
+            }
+            int frames = resampler->Process(input.data(), kChunk, output.data(), outframes);
+            QVERIFY(frames >= 0);
+            for (int i = 0; i < frames * kChannels; i++)
+                QVERIFY(std::fabs(output[static_cast<size_t>(i)]) < 0.6F);
+            total += frames;
+        }
+
+        // About a second of audio, less whatever is still in the filter
+        int expected = lround((INRATE + kChunk - 1) / kChunk * kChunk * resampler->Ratio());
+        QVERIFY(total <= expected + 1);
+        QVERIFY(total >= expected - 1024);
+
+        QVERIFY(resampler->Reset());
+    }
+
+    static void ResamplerSpeed_data(void)
+    {
+        Resampler_data();
+    }
+
+    // The time taken to resample one second of 8 channel audio
+    static void ResamplerSpeed(void)
+    {
+        QFETCH(int, BACKEND);
+        QFETCH(int, QUALITY);
+        QFETCH(int, INRATE);
+        QFETCH(int, OUTRATE);
+
+        static constexpr int kChannels = 8;
+        static constexpr int kChunk = 16384 / kChannels;
+        std::unique_ptr<AudioResampler> resampler
+            { AudioResampler::Create(static_cast<AudioResampler::Backend>(BACKEND),
+                                     QUALITY, kChannels, INRATE, OUTRATE) };
+        QVERIFY(resampler);
+
+        std::vector<float> input(static_cast<size_t>(kChunk * kChannels));
+        std::vector<float> output(static_cast<size_t>(lround(kChunk * resampler->Ratio() + 64) * kChannels));
+        int outframes = static_cast<int>(output.size()) / kChannels;
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> floats(-0.5F, 0.5F);
+        for (auto & sample : input)
+            sample = floats(generator);
+
+        QBENCHMARK
+        {
+            for (int done = 0; done < INRATE; done += kChunk)
+                resampler->Process(input.data(), kChunk, output.data(), outframes);
+        }
+    }
+
     static void PinkNoiseGenerator(void)
     {
         constexpr int kPinkTestSize = 1024;
@@ -0,0 +1,3 @@
+#include "test_freesurround.h"
+
+QTEST_APPLESS_MAIN(TestFreeSurround)
@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include "mythcorecontext.h"
+#include "el_processor.h"
+#include "freesurround.h"
+
+using cdouble = std::complex<double>;
+
+/*
+ * A direct, double precision version of the FreeSurround spectral decoder
+ * in simple steering mode: one real transform per input channel and one
+ * inverse transform per output channel, with the phases taken from atan2
+ * and the signals rebuilt with std::polar.
+*/
+class ReferenceDecoder
+{
+  public:
+    explicit ReferenceDecoder(unsigned N)
+      : m_n(N), m_halfN(N / 2)
+    {
+        for (auto & buffer : m_inbuf)
+            buffer.resize(m_n, 0.0);
+        for (auto & buffer : m_outbuf)
+            buffer.resize(m_n, 0.0);
+        for (auto & filter : m_filter)
+            filter.resize(m_n, 0.0);
+        m_wnd.resize(m_n);
+        for (unsigned k = 0; k < m_n; k++)
+            m_wnd[k] = std::sqrt(0.5 * (1 - std::cos(2 * M_PI * k / m_n)) / m_n);
+        unsigned cutoff = (30 * m_n) / 48000;
+        for (unsigned f = 0; f <= m_halfN; f++)
+            m_filter[5][f] = f < cutoff ? 0.5 * std::sqrt(0.5) : 0.0;
+    }
+
+    void SetPhaseMode(unsigned Mode)
+    {
+        static const std::array<std::array<double,2>,4> kModes
+            {{ {0,0}, {0,M_PI}, {M_PI,0}, {-M_PI/2,M_PI/2} }};
+        m_phaseOffsetL = kModes.at(Mode)[0];
+        m_phaseOffsetR = kModes.at(Mode)[1];
+    }
+
+    // Same layout as fsurround_decoder::getInputBuffers
+    std::array<double*,2> Input(void)
+    {
+        return { &m_inbuf[0][m_currentBuf * m_halfN], &m_inbuf[1][m_currentBuf * m_halfN] };
+    }
+
+    // Same layout as fsurround_decoder::getOutputBuffers
+    double* Output(int Channel)
+    {
+        return &m_outbuf.at(static_cast<size_t>(Channel))[m_currentBuf * m_halfN];
+    }
+
+    void Decode(double CenterWidth, double Dimension, double AdaptionRate)
+    {
+        unsigned second = m_currentBuf * m_halfN;
+        m_currentBuf ^= 1;
+        unsigned first = m_currentBuf * m_halfN;
+
+        std::vector<cdouble> left(m_n);
+        std::vector<cdouble> right(m_n);
+        for (unsigned k = 0; k < m_halfN; k++)
+        {
+            left[k]            = m_inbuf[0][first + k]  * m_wnd[k];
+            right[k]           = m_inbuf[1][first + k]  * m_wnd[k];
+            left[m_halfN + k]  = m_inbuf[0][second + k] * m_wnd[m_halfN + k];
+            right[m_halfN + k] = m_inbuf[1][second + k] * m_wnd[m_halfN + k];
+        }
+        FFT(left.data(), m_n, -1);
+        FFT(right.data(), m_n, -1);
+
+        static constexpr double kCenterLevel = 0.5 * M_SQRT1_2;
+        static constexpr double kBalance = (0.8165 - 0.5774) / (0.8165 + 0.5774);
+        static constexpr double kLevel = 1 / (0.8165 + 0.5774);
+        std::array<std::vector<cdouble>,6> signals;
+        for (auto & signal : signals)
+            signal.resize(m_halfN + 1, 0.0);
+
+        for (unsigned f = 0; f < m_halfN; f++)
+        {
+            double ampL   = std::abs(left[f]);
+            double ampR   = std::abs(right[f]);
+            double phaseL = std::arg(left[f]);
+            double phaseR = std::arg(right[f]);
+
+            double ampDiff = (ampL + ampR < 0.000001) ? 0 : (ampR - ampL) / (ampR + ampL);
+            ampDiff = std::clamp(ampDiff, -1.0, 1.0);
+            double phaseDiff = phaseL - phaseR;
+            if (phaseDiff < -M_PI)
+                phaseDiff += 2 * M_PI;
+            if (phaseDiff > M_PI)
+                phaseDiff -= 2 * M_PI;
+            phaseDiff = std::abs(phaseDiff);
+
+            double x = ampDiff;
+            double y = 1 - (phaseDiff / M_PI) * 2;
+            if (std::abs(x) > kBalance)
+            {
+                double frontness = (std::abs(x) - kBalance) / (1 - kBalance);
+                y = (1 - frontness) * y + frontness;
+            }
+            y = std::clamp(y - Dimension, -1.0, 1.0);
+            x = std::clamp(x * ((1 + y) / 2 + (1 - y) / 2), -1.0, 1.0);
+
+            double l     = (1 - x) / 2;
+            double r     = (1 + x) / 2;
+            double front = (1 + y) / 2;
+            double back  = (1 - y) / 2;
+            std::array<double,5> volume {
+                front * (l * CenterWidth + std::max(0.0, -x) * (1 - CenterWidth)),
+                front * kCenterLevel * ((1 - std::abs(x)) * (1 - CenterWidth)),
+                front * (r * CenterWidth + std::max(0.0, x) * (1 - CenterWidth)),
+                back * kLevel * std::clamp((1 - (x / kBalance)) / 2, 0.0, 1.0),
+                back * kLevel * std::clamp((1 + (x / kBalance)) / 2, 0.0, 1.0)
+            };
+            for (size_t c = 0; c < 5; c++)
+                m_filter.at(c)[f] = (1 - AdaptionRate) * m_filter.at(c)[f] + AdaptionRate * volume.at(c);
+
+            double amp = ampL + ampR;
+            signals[0][f] = std::polar(amp, phaseL);
+            signals[2][f] = std::polar(amp, phaseR);
+            signals[1][f] = signals[0][f] + signals[2][f];
+            signals[3][f] = std::polar(amp, phaseL + m_phaseOffsetL);
+            signals[4][f] = std::polar(amp, phaseR + m_phaseOffsetR);
+            signals[5][f] = left[f] + right[f];
+        }
+
+        for (size_t c = 0; c < 6; c++)
+        {
+            std::vector<cdouble> spectrum(m_n);
+            for (unsigned f = 0; f <= m_halfN; f++)
+                spectrum[f] = signals.at(c)[f] * m_filter.at(c)[f];
+            spectrum[0] = spectrum[0].real();
+            spectrum[m_halfN] = spectrum[m_halfN].real();
+            for (unsigned f = 1; f < m_halfN; f++)
+                spectrum[m_n - f] = std::conj(spectrum[f]);
+            FFT(spectrum.data(), m_n, 1);
+            std::vector<double> & out = m_outbuf.at(c);
+            for (unsigned k = 0; k < m_halfN; k++)
+            {
+                out[first + k]  += m_wnd[k] * spectrum[k].real();
+                out[second + k]  = m_wnd[m_halfN + k] * spectrum[m_halfN + k].real();
+            }
+        }
+    }
+
+  private:
+    // Recursive radix 2 transform, unnormalised
+    static void FFT(cdouble *Data, unsigned N, int Sign)
+    {
+        if (N < 2)
+            return;
+        std::vector<cdouble> even(N / 2);
+        std::vector<cdouble> odd(N / 2);
+        for (unsigned i = 0; i < N / 2; i++)
+        {
+            even[i] = Data[2 * i];
+            odd[i]  = Data[(2 * i) + 1];
+        }
+        FFT(even.data(), N / 2, Sign);
+        FFT(odd.data(), N / 2, Sign);
+        for (unsigned k = 0; k < N / 2; k++)
+        {
+            cdouble t = std::polar(1.0, Sign * 2 * M_PI * k / N) * odd[k];
+            Data[k]         = even[k] + t;
+            Data[k + N / 2] = even[k] - t;
+        }
+    }
+
+    unsigned m_n;
+    unsigned m_halfN;
+    unsigned m_currentBuf { 0 };
+    double   m_phaseOffsetL { 0.0 };
+    double   m_phaseOffsetR { 0.0 };
+    std::vector<double> m_wnd;
+    std::array<std::vector<double>,2> m_inbuf;
+    std::array<std::vector<double>,6> m_outbuf;
+    std::array<std::vector<double>,6> m_filter;
+};
+
+class TestFreeSurround: public QObject
+{
+    Q_OBJECT
+
+    // A sine panned between left and right plus some uncorrelated noise
+    static void FillInput(float *Left, float *Right, int Frames, int Offset,
+                          std::mt19937 &Generator)
+    {
+        std::normal_distribution<float> noise(0.0F, 0.05F);
+        for (int i = 0; i < Frames; i++)
+        {
+            auto t = static_cast<float>(Offset + i);
+            float sample = 0.3F * std::sin(t * 0.05F);
+            float pan = 0.5F + (0.5F * std::sin(t * 0.0001F));
+            Left[i]  = (sample * (1.0F - pan)) + noise(Generator);
+            Right[i] = (sample * pan) + noise(Generator);
+        }
+    }
+
+  private slots:
+    // called at the beginning of these sets of tests
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+    }
+
+    static void Equivalence_data(void)
+    {
+        QTest::addColumn<unsigned>("blocksize");
+        QTest::addColumn<unsigned>("phasemode");
+
+        QTest::newRow("512 music")      << 512U  << 0U;
+        QTest::newRow("1024 powerdvd")  << 1024U << 1U;
+        QTest::newRow("2048 besweet")   << 2048U << 2U;
+        QTest::newRow("8192 quadrature") << 8192U << 3U;
+    }
+
+    /*
+     * Checks the decoder against the direct implementation of the same
+     * algorithm, block by block, including silence and one sided input.
+    */
+    static void Equivalence(void)
+    {
+        QFETCH(unsigned, blocksize);
+        QFETCH(unsigned, phasemode);
+
+        fsurround_decoder decoder(blocksize);
+        decoder.steering_mode(false);
+        decoder.phase_mode(phasemode);
+        ReferenceDecoder reference(blocksize);
+        reference.SetPhaseMode(phasemode);
+
+        const int half = static_cast<int>(blocksize / 2);
+        std::mt19937 generator(42);
+        std::vector<float> left(static_cast<size_t>(half));
+        std::vector<float> right(static_cast<size_t>(half));
+        double worst = 0.0;
+        for (int block = 0; block < 12; block++)
+        {
+            FillInput(left.data(), right.data(), half, block * half, generator);
+            if (block == 4)
+                std::fill(left.begin(), left.end(), 0.0F);
+            if (block == 5)
+                std::fill(right.begin(), right.end(), 0.0F);
+            if (block == 6)
+            {
+                std::fill(left.begin(), left.end(), 0.0F);
+                std::fill(right.begin(), right.end(), 0.0F);
+            }
+
+            float **in = decoder.getInputBuffers();
+            std::array<double*,2> refin = reference.Input();
+            for (int i = 0; i < half; i++)
+            {
+                in[0][i] = refin[0][i] = left[static_cast<size_t>(i)];
+                in[1][i] = refin[1][i] = right[static_cast<size_t>(i)];
+            }
+
+            float adaption = (block % 3) ? 1.0F : 0.5F;
+            decoder.decode(0.65F, 0.3F, adaption);
+            reference.Decode(0.65, 0.3, adaption);
+
+            float **out = decoder.getOutputBuffers();
+            for (int c = 0; c < 6; c++)
+            {
+                const double *refout = reference.Output(c);
+                for (int i = 0; i < half; i++)
+                    worst = std::max(worst, std::abs(out[c][i] - refout[i]));
+            }
+        }
+        qInfo() << "Largest difference" << worst;
+        QVERIFY(worst < 1e-4);
+    }
+
+    static void DecoderSpeed_data(void)
+    {
+        QTest::addColumn<unsigned>("blocksize");
+        QTest::addColumn<bool>("linear");
+
+        for (unsigned size : { 1024U, 2048U, 4096U, 8192U })
+        {
+            QTest::addRow("%u simple", size) << size << false;
+            QTest::addRow("%u linear", size) << size << true;
+        }
+    }
+
+    /*
+     * Time to decode one second of 48kHz stereo with each block size.
+    */
+    static void DecoderSpeed(void)
+    {
+        QFETCH(unsigned, blocksize);
+        QFETCH(bool, linear);
+
+        fsurround_decoder decoder(blocksize);
+        decoder.steering_mode(linear);
+        const int half = static_cast<int>(blocksize / 2);
+        const int blocks = (48000 + half - 1) / half;
+        std::mt19937 generator(42);
+        std::vector<float> left(48000 + static_cast<size_t>(half));
+        std::vector<float> right(48000 + static_cast<size_t>(half));
+        FillInput(left.data(), right.data(), static_cast<int>(left.size()), 0, generator);
+
+        QBENCHMARK
+        {
+            for (int block = 0; block < blocks; block++)
+            {
+                float **in = decoder.getInputBuffers();
+                std::copy_n(&left[static_cast<size_t>(block * half)], half, in[0]);
+                std::copy_n(&right[static_cast<size_t>(block * half)], half, in[1]);
+                decoder.decode(0.65F, 0.3F);
+            }
+        }
+    }
+
+    /*
+     * Time to upmix one second of 48kHz stereo through FreeSurround with
+     * the default block size, including the (de)interleaving.
+    */
+    static void UpmixSpeed(void)
+    {
+        FreeSurround surround(48000, true, FreeSurround::SurroundModeActiveLinear);
+        std::mt19937 generator(42);
+        std::vector<float> left(48000);
+        std::vector<float> right(48000);
+        FillInput(left.data(), right.data(), 48000, 0, generator);
+        std::vector<float> input(96000);
+        for (size_t i = 0; i < 48000; i++)
+        {
+            input[2 * i]       = left[i];
+            input[(2 * i) + 1] = right[i];
+        }
+        std::vector<float> output(static_cast<size_t>(6) * 1024);
+
+        uint received = 0;
+        QBENCHMARK
+        {
+            uint frames = 0;
+            while (frames < 48000)
+            {
+                frames += surround.putFrames(&input[static_cast<size_t>(frames) * 2], 48000 - frames, 2);
+                uint ready = 0;
+                while ((ready = surround.receiveFrames(output.data(), 1024)) > 0)
+                    received += ready;
+            }
+        }
+        QVERIFY(received > 0);
+    }
+};
@@ -0,0 +1,3 @@
+#include "test_recordingseekindex.h"
+
+QTEST_APPLESS_MAIN(TestRecordingSeekIndex)
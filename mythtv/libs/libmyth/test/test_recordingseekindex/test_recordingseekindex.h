@@ -0,0 +1,168 @@
+/*
+ *  Class TestRecordingSeekIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "recordingseekindex.h"
+
+class TestRecordingSeekIndex : public QObject
+{
+    Q_OBJECT
+
+  private:
+    QTemporaryDir m_dir;
+
+    QString Recording(void) const { return m_dir.filePath("1001_20201019120000.ts"); }
+
+  private slots:
+    void initTestCase(void)
+    {
+        QVERIFY(m_dir.isValid());
+    }
+
+    void writeAndRead(void)
+    {
+        RecordingSeekIndex writer;
+        QVERIFY(writer.Create(Recording(), MARK_GOP_BYFRAME));
+
+        frm_pos_map_t pos;
+        frm_pos_map_t dur;
+        for (long long i = 0; i < 100; i += 10)
+        {
+            pos[i] = i * 18800;
+            dur[i] = i * 40;
+        }
+        QVERIFY(writer.Append(pos, dur));
+
+        RecordingSeekIndex reader;
+        QVERIFY(reader.Open(Recording()));
+        QCOMPARE(reader.GetMarkType(), MARK_GOP_BYFRAME);
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(10));
+        QCOMPARE(reader.GetEntry(3).index, static_cast<int64_t>(30));
+        QCOMPARE(reader.GetEntry(3).offset, static_cast<int64_t>(30) * 18800);
+        QCOMPARE(reader.GetEntry(3).duration, static_cast<int64_t>(30) * 40);
+        QVERIFY(reader.HasDurations());
+        QCOMPARE(reader.FindByDuration(30 * 40 + 1), static_cast<int64_t>(3));
+        QCOMPARE(reader.FindByDuration(-1), static_cast<int64_t>(-1));
+
+        // Appends by a recorder are picked up on Refresh()
+        frm_pos_map_t pos2;
+        pos2[100] = 100 * 18800;
+        QVERIFY(writer.Append(pos2, frm_pos_map_t()));
+        QVERIFY(reader.Refresh());
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(11));
+        QCOMPARE(reader.GetEntry(10).duration, static_cast<int64_t>(-1));
+
+        // which can't be searched by duration any more
+        QVERIFY(!reader.HasDurations());
+        QCOMPARE(reader.FindByDuration(30 * 40 + 1), static_cast<int64_t>(-1));
+    }
+
+    void unsortedDurations(void)
+    {
+        RecordingSeekIndex writer;
+        QVERIFY(writer.Create(m_dir.filePath("unsorted.ts"), MARK_GOP_BYFRAME));
+
+        frm_pos_map_t pos;
+        frm_pos_map_t dur;
+        pos[0] = 0;
+        pos[10] = 188000;
+        pos[20] = 376000;
+        dur[0] = 0;
+        dur[10] = 800;
+        dur[20] = 400;
+        QVERIFY(writer.Append(pos, dur));
+
+        RecordingSeekIndex reader;
+        QVERIFY(reader.Open(m_dir.filePath("unsorted.ts")));
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(3));
+        QVERIFY(!reader.HasDurations());
+        QCOMPARE(reader.FindByDuration(500), static_cast<int64_t>(-1));
+    }
+
+    void binarySearch(void)
+    {
+        RecordingSeekIndex reader;
+        QVERIFY(reader.Open(Recording()));
+
+        QCOMPARE(reader.FindByIndex(-1), static_cast<int64_t>(-1));
+        QCOMPARE(reader.FindByIndex(0), static_cast<int64_t>(0));
+        QCOMPARE(reader.FindByIndex(15), static_cast<int64_t>(1));
+        QCOMPARE(reader.FindByIndex(90), static_cast<int64_t>(9));
+        QCOMPARE(reader.FindByIndex(1000), static_cast<int64_t>(10));
+        QCOMPARE(reader.FindByOffset(20 * 18800 + 5), static_cast<int64_t>(2));
+    }
+
+    void recreate(void)
+    {
+        // A reader switches to the new index when the recorder starts over
+        RecordingSeekIndex reader;
+        QVERIFY(reader.Open(Recording()));
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(11));
+        QCOMPARE(reader.GetGeneration(), 0U);
+
+        RecordingSeekIndex writer;
+        QVERIFY(writer.Create(Recording(), MARK_GOP_BYFRAME));
+        QVERIFY(reader.Refresh());
+        QVERIFY(reader.IsOpen());
+        QCOMPARE(reader.GetGeneration(), 1U);
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(0));
+
+        frm_pos_map_t pos;
+        frm_pos_map_t dur;
+        pos[0] = 0;
+        pos[10] = 188000;
+        dur[0] = 0;
+        dur[10] = 400;
+        QVERIFY(writer.Append(pos, dur));
+        QVERIFY(reader.Refresh());
+        QCOMPARE(reader.GetGeneration(), 1U);
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(2));
+        QCOMPARE(reader.GetEntry(1).offset, static_cast<int64_t>(188000));
+        QVERIFY(reader.HasDurations());
+
+        // and closes it if it has been removed
+        QVERIFY(RecordingSeekIndex::Remove(Recording()));
+        QVERIFY(reader.Refresh());
+        QVERIFY(!reader.IsOpen());
+        QCOMPARE(reader.GetEntryCount(), static_cast<uint64_t>(0));
+
+        // put back what the remaining tests expect
+        QVERIFY(writer.Create(Recording(), MARK_GOP_BYFRAME));
+        QVERIFY(writer.Append(pos, dur));
+    }
+
+    void invalidFile(void)
+    {
+        QFile file(RecordingSeekIndex::IndexFilename(m_dir.filePath("bad.ts")));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("not an index at all");
+        file.close();
+
+        RecordingSeekIndex reader;
+        QVERIFY(!reader.Open(m_dir.filePath("bad.ts")));
+        QVERIFY(!reader.Open(m_dir.filePath("missing.ts")));
+    }
+
+    void remove(void)
+    {
+        QVERIFY(RecordingSeekIndex::Remove(Recording()));
+        QVERIFY(!QFile::exists(RecordingSeekIndex::IndexFilename(Recording())));
+    }
+};
@@ -0,0 +1,3 @@
+#include "test_spdifencoder.h"
+
+QTEST_APPLESS_MAIN(TestSPDIFEncoder)
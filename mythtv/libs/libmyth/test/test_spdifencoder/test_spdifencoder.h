@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include "mythcorecontext.h"
+#include "spdifencoder.h"
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavutil/channel_layout.h"
+}
+
+class TestSPDIFEncoder: public QObject
+{
+    Q_OBJECT
+
+    static constexpr unsigned char kGuard = 0xA5;
+
+    // A 440Hz sine on both channels, in whatever format the encoder takes
+    static void FillFrame(AVFrame *Frame, int Position)
+    {
+        auto format = static_cast<AVSampleFormat>(Frame->format);
+        bool planar = av_sample_fmt_is_planar(format) != 0;
+        for (int i = 0; i < Frame->nb_samples; i++)
+        {
+            double value = 0.5 * std::sin((Position + i) * 2.0 * M_PI * 440.0 / 48000.0);
+            for (int ch = 0; ch < 2; ch++)
+            {
+                int index = planar ? i : (i * 2) + ch;
+                uint8_t *data = Frame->extended_data[planar ? ch : 0];
+                switch (av_get_packed_sample_fmt(format))
+                {
+                    case AV_SAMPLE_FMT_S16:
+                        reinterpret_cast<int16_t*>(data)[index] =
+                            static_cast<int16_t>(value * INT16_MAX);
+                        break;
+                    case AV_SAMPLE_FMT_S32:
+                        reinterpret_cast<int32_t*>(data)[index] =
+                            static_cast<int32_t>(value * INT32_MAX);
+                        break;
+                    case AV_SAMPLE_FMT_FLT:
+                        reinterpret_cast<float*>(data)[index] = static_cast<float>(value);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    // Encode one second of 48kHz stereo, returning no packets if the
+    // encoder isn't available in this build of FFmpeg
+    static std::vector<QByteArray> Encode(const QString &Encoder)
+    {
+        std::vector<QByteArray> packets;
+        const AVCodec *codec = avcodec_find_encoder_by_name(Encoder.toLatin1().constData());
+        if (!codec)
+            return packets;
+
+        AVCodecContext *ctx = avcodec_alloc_context3(codec);
+        ctx->sample_rate           = 48000;
+        ctx->channels              = 2;
+        ctx->channel_layout        = AV_CH_LAYOUT_STEREO;
+        ctx->sample_fmt            = codec->sample_fmts[0];
+        ctx->strict_std_compliance = FF_COMPLIANCE_EXPERIMENTAL;
+        if (avcodec_open2(ctx, codec, nullptr) < 0)
+        {
+            avcodec_free_context(&ctx);
+            return packets;
+        }
+
+        AVFrame  *frame  = av_frame_alloc();
+        AVPacket *packet = av_packet_alloc();
+        frame->nb_samples     = ctx->frame_size;
+        frame->format         = ctx->sample_fmt;
+        frame->channel_layout = ctx->channel_layout;
+        av_frame_get_buffer(frame, 0);
+
+        for (int position = 0; position <= 48000; position += ctx->frame_size)
+        {
+            bool flush = position + ctx->frame_size > 48000;
+            if (!flush)
+            {
+                av_frame_make_writable(frame);
+                FillFrame(frame, position);
+            }
+            avcodec_send_frame(ctx, flush ? nullptr : frame);
+            while (avcodec_receive_packet(ctx, packet) == 0)
+            {
+                packets.emplace_back(reinterpret_cast<const char*>(packet->data), packet->size);
+                av_packet_unref(packet);
+            }
+        }
+
+        av_packet_free(&packet);
+        av_frame_free(&frame);
+        avcodec_free_context(&ctx);
+        return packets;
+    }
+
+  private slots:
+    // called at the beginning of these sets of tests
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+    }
+
+    static void Bursts_data(void)
+    {
+        QTest::addColumn<QString>("encoder");
+        QTest::addColumn<int>("codec");
+        QTest::addColumn<int>("hdrate");
+
+        QTest::newRow("ac3")    << "ac3_fixed" << int(AV_CODEC_ID_AC3)    << 0;
+        QTest::newRow("eac3")   << "eac3"      << int(AV_CODEC_ID_EAC3)   << 0;
+        QTest::newRow("dts")    << "dca"       << int(AV_CODEC_ID_DTS)    << 0;
+        QTest::newRow("dts-hd") << "dca"       << int(AV_CODEC_ID_DTS)    << 768000;
+        QTest::newRow("truehd") << "truehd"    << int(AV_CODEC_ID_TRUEHD) << 0;
+    }
+
+    /*
+     * Bursts muxed straight into the caller's buffer must be byte identical
+     * to those copied out of the encoder, and nothing may be written past
+     * them. Every fourth frame goes through the copying path of the same
+     * encoder, as happens when AddData reaches the end of the ring buffer.
+    */
+    static void Bursts(void)
+    {
+        QFETCH(QString, encoder);
+        QFETCH(int, codec);
+        QFETCH(int, hdrate);
+
+        std::vector<QByteArray> packets = Encode(encoder);
+        if (packets.empty())
+            QSKIP("Encoder not available");
+
+        SPDIFEncoder copied("spdif", static_cast<AVCodecID>(codec));
+        SPDIFEncoder direct("spdif", static_cast<AVCodecID>(codec));
+        QVERIFY(copied.Succeeded());
+        QVERIFY(direct.Succeeded());
+        if (hdrate)
+        {
+            copied.SetMaxHDRate(hdrate);
+            direct.SetMaxHDRate(hdrate);
+        }
+
+        std::vector<unsigned char> expected(AudioOutput::kMaxSizeBuffer);
+        std::vector<unsigned char> actual(static_cast<size_t>(SPDIFEncoder::kMaxBurstSize) * 2);
+        int bursts = 0;
+        for (size_t i = 0; i < packets.size(); i++)
+        {
+            auto *data = reinterpret_cast<unsigned char*>(packets[i].data());
+            int size = packets[i].size();
+
+            copied.WriteFrame(data, size);
+            size_t expectedSize = 0;
+            copied.GetData(expected.data(), expectedSize);
+
+            std::fill(actual.begin(), actual.end(), kGuard);
+            int actualSize = 0;
+            if ((i % 4) == 3)
+            {
+                size_t copiedSize = 0;
+                direct.WriteFrame(data, size);
+                direct.GetData(actual.data(), copiedSize);
+                actualSize = static_cast<int>(copiedSize);
+            }
+            else
+            {
+                actualSize = direct.WriteFrameDirect(data, size, actual.data());
+            }
+
+            QCOMPARE(actualSize, static_cast<int>(expectedSize));
+            QVERIFY(std::equal(expected.cbegin(), expected.cbegin() + actualSize,
+                               actual.cbegin()));
+            QVERIFY(std::all_of(actual.cbegin() + actualSize, actual.cend(),
+                                [](unsigned char c) { return c == kGuard; }));
+            if (actualSize > 0)
+                bursts++;
+        }
+        QVERIFY(bursts > 0);
+    }
+};
@@ -0,0 +1,3 @@
+#include "test_timestretch.h"
+
+QTEST_APPLESS_MAIN(TestTimeStretch)
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <random>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include "mythcorecontext.h"
+#include "SoundTouch.h"
+
+class TestTimeStretch: public QObject
+{
+    Q_OBJECT
+
+    static constexpr int kRate   = 48000;
+    static constexpr int kPacket = 480;
+
+    // A different mix of sines on each channel plus some noise
+    static std::vector<float> MakeInput(int Channels, int Frames)
+    {
+        std::mt19937 generator(42);
+        std::normal_distribution<float> noise(0.0F, 0.02F);
+        std::vector<float> input(static_cast<size_t>(Channels) * Frames);
+        for (int i = 0; i < Frames; i++)
+        {
+            auto t = static_cast<float>(i);
+            for (int ch = 0; ch < Channels; ch++)
+            {
+                float sample = (0.3F * std::sin(t * (0.01F + (0.003F * ch)))) +
+                               (0.1F * std::sin(t * 0.17F * (ch + 1)));
+                input[(static_cast<size_t>(i) * Channels) + ch] = sample + noise(generator);
+            }
+        }
+        return input;
+    }
+
+    // Stretch the input the way AudioOutputBase does, in packets of kPacket
+    // frames, and return everything that comes out.
+    static std::vector<float> Stretch(const std::vector<float> &Input, int Channels,
+                                      float Tempo, uint Threads)
+    {
+        soundtouch::SoundTouch stretch;
+        stretch.setSampleRate(kRate);
+        stretch.setChannels(static_cast<uint>(Channels));
+        stretch.setTempo(Tempo);
+        stretch.setSetting(SETTING_SEQUENCE_MS, 35);
+        stretch.setSetting(SETTING_THREADS, Threads);
+
+        std::vector<float> output;
+        std::vector<float> buffer(static_cast<size_t>(Channels) * 8192);
+        int frames = static_cast<int>(Input.size()) / Channels;
+        for (int i = 0; i < frames; i += kPacket)
+        {
+            int count = std::min(kPacket, frames - i);
+            stretch.putSamples(&Input[static_cast<size_t>(i) * Channels],
+                               static_cast<uint>(count));
+            uint received = 0;
+            while ((received = stretch.receiveSamples(buffer.data(), 8192)) > 0)
+            {
+                output.insert(output.end(), buffer.begin(),
+                              buffer.begin() + (received * Channels));
+            }
+        }
+        return output;
+    }
+
+  private slots:
+    // called at the beginning of these sets of tests
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+    }
+
+    static void Threaded_data(void)
+    {
+        QTest::addColumn<int>("channels");
+        QTest::addColumn<float>("tempo");
+        QTest::addColumn<uint>("threads");
+
+        QTest::newRow("5.1 x0.5 2 threads") << 6 << 0.5F << 2U;
+        QTest::newRow("5.1 x1.5 3 threads") << 6 << 1.5F << 3U;
+        QTest::newRow("7.1 x1.5 2 threads") << 8 << 1.5F << 2U;
+        QTest::newRow("7.1 x1.5 4 threads") << 8 << 1.5F << 4U;
+        QTest::newRow("7.1 x2.0 3 threads") << 8 << 2.0F << 3U;
+    }
+
+    /*
+     * Sharing the overlap search between threads must pick exactly the
+     * same splice points as a single thread.
+    */
+    static void Threaded(void)
+    {
+        QFETCH(int, channels);
+        QFETCH(float, tempo);
+        QFETCH(uint, threads);
+
+        soundtouch::SoundTouch stretch;
+        stretch.setSetting(SETTING_THREADS, threads);
+        QCOMPARE(stretch.getSetting(SETTING_THREADS), threads);
+
+        std::vector<float> input = MakeInput(channels, kRate);
+        std::vector<float> serial = Stretch(input, channels, tempo, 1);
+        std::vector<float> threaded = Stretch(input, channels, tempo, threads);
+        QVERIFY(!serial.empty());
+        QCOMPARE(threaded.size(), serial.size());
+        QVERIFY(threaded == serial);
+    }
+
+    static void StretchSpeed_data(void)
+    {
+        QTest::addColumn<float>("tempo");
+        QTest::addColumn<uint>("threads");
+
+        uint threads = static_cast<uint>(std::clamp(QThread::idealThreadCount(), 1, 4));
+        for (float tempo : { 0.5F, 1.5F, 2.0F })
+        {
+            QTest::addRow("x%.1f 1 thread", static_cast<double>(tempo)) << tempo << 1U;
+            if (threads > 1)
+            {
+                QTest::addRow("x%.1f %u threads", static_cast<double>(tempo), threads)
+                    << tempo << threads;
+            }
+        }
+    }
+
+    /*
+     * Time to stretch one second of 48kHz 7.1 at each speed. The CPU time
+     * used by all threads is printed alongside the elapsed time.
+    */
+    static void StretchSpeed(void)
+    {
+        QFETCH(float, tempo);
+        QFETCH(uint, threads);
+
+        std::vector<float> input = MakeInput(8, kRate);
+        int runs = 0;
+        std::clock_t start = std::clock();
+        QBENCHMARK
+        {
+            Stretch(input, 8, tempo, threads);
+            runs++;
+        }
+        double cpu = 1000.0 * static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+        qInfo("%.2f msecs CPU per second of audio", cpu / std::max(runs, 1));
+    }
+};
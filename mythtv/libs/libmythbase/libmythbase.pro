@@ -16,7 +16,8 @@ HEADERS += mythbaseexp.h mythdbcon.h mythdb.h mythdbparams.h
 HEADERS += verbosedefs.h mythversion.h compat.h mythconfig.h
 HEADERS += mythobservable.h mythevent.h
 HEADERS += mythtimer.h mythdirs.h exitcodes.h
-HEADERS += lcddevice.h mythstorage.h remotefile.h logging.h loggingserver.h
+HEADERS += lcddevice.h mythstorage.h remotefile.h remotestreamwindow.h
+HEADERS += logging.h loggingserver.h
 HEADERS += mythcorecontext.h mythsystem.h mythsystemprivate.h
 HEADERS += mythlocale.h storagegroup.h
 HEADERS += mythcoreutil.h mythdownloadmanager.h mythtranslation.h
@@ -42,7 +43,7 @@ SOURCES += mythsocket.cpp
 SOURCES += mythdbcon.cpp mythdb.cpp mythdbparams.cpp
 SOURCES += mythobservable.cpp mythevent.cpp
 SOURCES += mythtimer.cpp mythdirs.cpp
-SOURCES += lcddevice.cpp mythstorage.cpp remotefile.cpp
+SOURCES += lcddevice.cpp mythstorage.cpp remotefile.cpp remotestreamwindow.cpp
 SOURCES += mythcorecontext.cpp mythsystem.cpp mythlocale.cpp storagegroup.cpp
 SOURCES += mythcoreutil.cpp mythdownloadmanager.cpp mythtranslation.cpp
 SOURCES += unzip.cpp iso639.cpp iso3166.cpp mythmedia.cpp mythmiscutil.cpp
@@ -93,7 +94,7 @@ inc.files += mthread.h mthreadpool.h mythchrono.h
 inc.files += filesysteminfo.h hardwareprofile.h bonjourregister.h serverpool.h
 inc.files += plist.h bswap.h signalhandling.h ffmpeg-mmx.h mythdate.h
 inc.files += mythplugin.h mythpluginapi.h mythqtcompat.h
-inc.files += remotefile.h mythsystemlegacy.h mythtypes.h
+inc.files += remotefile.h remotestreamwindow.h mythsystemlegacy.h mythtypes.h
 inc.files += threadedfilewriter.h mythsingledownload.h mythsession.h
 inc.files += mythsorthelper.h mythdbcheck.h
 
@@ -559,6 +559,21 @@ void MythSocket::Reset(void)
         Qt::BlockingQueuedConnection : Qt::DirectConnection);
 }
 
+/** \brief Waits for data queued with Write() to reach the kernel, so that
+ *         anything written straight to the socket descriptor follows it.
+ */
+bool MythSocket::Flush(std::chrono::milliseconds timeout)
+{
+    bool ret = false;
+    QMetaObject::invokeMethod(
+        this, "FlushReal",
+        (QThread::currentThread() != m_thread->qthread()) ?
+        Qt::BlockingQueuedConnection : Qt::DirectConnection,
+        Q_ARG(std::chrono::milliseconds, timeout),
+        Q_ARG(bool*, &ret));
+    return ret;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 bool MythSocket::IsConnected(void) const
@@ -1010,3 +1025,15 @@ void MythSocket::ResetReal(void)
 
     m_dataAvailable.fetchAndStoreOrdered(0);
 }
+
+void MythSocket::FlushReal(std::chrono::milliseconds timeout, bool *ret)
+{
+    MythTimer t; t.start();
+    while ((m_tcpSocket->state() == QAbstractSocket::ConnectedState) &&
+           (m_tcpSocket->bytesToWrite() > 0) &&
+           (t.elapsed() < timeout))
+    {
+        m_tcpSocket->waitForBytesWritten(5);
+    }
+    *ret = (m_tcpSocket->bytesToWrite() == 0);
+}
@@ -67,6 +67,7 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     int Write(const char *data, int size);
     int Read(char *data, int size,  std::chrono::milliseconds max_wait);
     void Reset(void);
+    bool Flush(std::chrono::milliseconds timeout = kShortTimeout);
 
     static constexpr std::chrono::milliseconds kShortTimeout { kMythSocketShortTimeout };
     static constexpr std::chrono::milliseconds kLongTimeout  { kMythSocketLongTimeout };
@@ -90,6 +91,7 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     void WriteReal(const char *data, int size, int *ret);
     void ReadReal(char *data, int size, std::chrono::milliseconds max_wait_ms, int *ret);
     void ResetReal(void);
+    void FlushReal(std::chrono::milliseconds timeout, bool *ret);
 
     void IsDataAvailableReal(bool *ret) const;
 
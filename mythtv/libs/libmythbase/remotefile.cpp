@@ -1,4 +1,5 @@
 #include <iostream>
+#include <vector>
 
 #include <QFile>
 #include <QFileInfo>
@@ -408,6 +409,7 @@ void RemoteFile::Close(bool haslock)
         m_controlSock->DecrRef();
         m_controlSock = nullptr;
     }
+    m_streaming = false;
 
     if (!haslock)
     {
@@ -823,9 +825,13 @@ long long RemoteFile::SeekInternal(long long pos, int whence, long long curpos)
 
     if (ok && !strlist.isEmpty())
     {
-        m_lastPosition = m_readPosition = strlist[0].toLongLong();
-        m_sock->Reset();
-        return strlist[0].toLongLong();
+        long long ret = strlist[0].toLongLong();
+        m_lastPosition = m_readPosition = ret;
+        if (m_streaming && strlist.size() >= 2)
+            DiscardStream(strlist[1].toLongLong());
+        else
+            m_sock->Reset();
+        return ret;
     }
     m_lastPosition = 0LL;
     return -1;
@@ -963,6 +969,9 @@ int RemoteFile::Read(void *data, int size)
         return -1;
     }
 
+    if (m_streaming)
+        return ReadStream(data, size);
+
     if (m_sock->IsDataAvailable())
     {
         LOG(VB_NETWORK, LOG_ERR,
@@ -977,6 +986,9 @@ int RemoteFile::Read(void *data, int size)
         m_controlSock->Reset();
     }
 
+    if (m_useReadAhead && !m_streamUnsupported && StartStream())
+        return ReadStream(data, size);
+
     QStringList strlist( m_query.arg(m_recorderNum) );
     strlist << "REQUEST_BLOCK";
     strlist << QString::number(size);
@@ -1083,6 +1095,159 @@ int RemoteFile::Read(void *data, int size)
     return recv;
 }
 
+/** \brief Asks the backend to stream the file to us.
+ *
+ *  Requesting one block per Read() caps the throughput at one block per
+ *  round trip, well below the link speed on a Wi-Fi frontend. Instead
+ *  the backend pushes data ahead of our reads within a window of
+ *  credit, which ReadStream() tops up as it consumes the data.
+ *  Backends which do not support it answer with an error, in which case
+ *  we keep using REQUEST_BLOCK. Must have lock.
+ */
+bool RemoteFile::StartStream(void)
+{
+    QStringList strlist( m_query.arg(m_recorderNum) );
+    strlist << "REQUEST_STREAM";
+    strlist << QString::number(RemoteStreamWindow::kDefaultWindow);
+
+    bool ok = false;
+    int window = -1;
+    if (m_controlSock->SendReceiveStringList(strlist) && !strlist.isEmpty())
+        window = strlist[0].toInt(&ok);
+
+    if (!ok || window <= 0)
+    {
+        LOG(VB_FILE, LOG_INFO,
+            "RemoteFile::StartStream(): Not supported, requesting blocks");
+        m_streamUnsupported = true;
+        return false;
+    }
+
+    m_stream.Start(window);
+    m_streaming = true;
+    return true;
+}
+
+/** \brief Grants the backend more credit, which may be 0 to just query
+ *         how much it has streamed and whether it is at the end of the
+ *         file. Must have lock.
+ */
+bool RemoteFile::StreamCredit(int size, long long &streamed, bool &ateof)
+{
+    QStringList strlist( m_query.arg(m_recorderNum) );
+    strlist << "STREAM_CREDIT";
+    strlist << QString::number(size);
+
+    if (!m_controlSock->SendReceiveStringList(strlist, 2) ||
+        strlist.size() < 2)
+    {
+        LOG(VB_NETWORK, LOG_ERR, "RemoteFile::StreamCredit(): Failed");
+        return false;
+    }
+
+    m_stream.Grant(size);
+    streamed = strlist[0].toLongLong();
+    ateof = (strlist[1].toInt() != 0);
+    return true;
+}
+
+/** \brief Reads data the backend has already streamed to us.
+ *
+ *  Returns as soon as any data is available, and 0 once the backend is
+ *  at the end of the file and everything it sent has been read.
+ *  Must have lock.
+ */
+int RemoteFile::ReadStream(void *data, int size)
+{
+    long long streamed = 0;
+    bool ateof = false;
+
+    int due = m_stream.CreditDue();
+    if (due > 0 && !StreamCredit(due, streamed, ateof))
+    {
+        Resume();
+        return -1;
+    }
+
+    int recv = 0;
+    std::chrono::milliseconds waitms { 30ms };
+    MythTimer mtimer;
+    mtimer.start();
+
+    while (recv == 0 && mtimer.elapsed() < 10s)
+    {
+        recv = m_sock->Read((char *)data, size, waitms);
+        if (recv != 0)
+            break;
+
+        // Nothing in flight, check if the backend ran out of data
+        if (!StreamCredit(0, streamed, ateof))
+        {
+            recv = -1;
+            break;
+        }
+        if (ateof && m_stream.InFlight(streamed) == 0)
+            return 0;
+
+        waitms += (waitms < 200ms) ? 20ms : 0ms;
+    }
+
+    if (recv <= 0)
+    {
+        LOG(VB_GENERAL, LOG_WARNING,
+            QString("RemoteFile::ReadStream(): No data after %1 ms")
+            .arg(mtimer.elapsed().count()));
+
+        // The TCP socket is dropped if there's a timeout, so we reconnect
+        if (!Resume())
+            LOG(VB_GENERAL, LOG_WARNING, "RemoteFile::ReadStream(): Resume failed.");
+        return -1;
+    }
+
+    m_stream.Advance(recv);
+    m_lastPosition += recv;
+
+    LOG(VB_NETWORK, LOG_DEBUG, QString("ReadStream(): reqd=%1, rcvd=%2")
+        .arg(size).arg(recv));
+
+    return recv;
+}
+
+/** \brief Drops the data the backend streamed before a seek.
+ *
+ *  The backend reports how much it had streamed when it stopped, so
+ *  unlike Reset() this also catches data that is still on the wire.
+ *  Must have lock.
+ */
+void RemoteFile::DiscardStream(long long streamed)
+{
+    std::vector<char> trash(64 * 1024);
+    long long left = m_stream.InFlight(streamed);
+    MythTimer mtimer;
+    mtimer.start();
+
+    while (left > 0 && mtimer.elapsed() < 10s)
+    {
+        int ret = m_sock->Read(trash.data(),
+                               static_cast<int>(std::min(left, static_cast<long long>(trash.size()))),
+                               200ms);
+        if (ret < 0)
+            break;
+        left -= ret;
+    }
+
+    if (left > 0)
+    {
+        // Out of step with the backend, reconnect on the next Read()
+        LOG(VB_GENERAL, LOG_ERR, QString("RemoteFile::DiscardStream(): "
+            "%1 bytes of stale data left, reconnecting").arg(left));
+        Close(true);
+        return;
+    }
+
+    m_stream.Start(m_stream.GetWindow(), streamed);
+}
+
 /**
  * GetFileSize: returns the remote file's size at the time it was first opened
  * Will query the server in order to get the size. If file isn't being modified
@@ -9,6 +9,7 @@
 
 #include "mythbaseexp.h"
 #include "mythtimer.h"
+#include "remotestreamwindow.h"
 
 class MythSocket;
 class QFile;
@@ -72,6 +73,10 @@ class MBASE_PUBLIC RemoteFile
     bool IsConnected(void);
     bool Resume(bool repos = true);
     long long SeekInternal(long long pos, int whence, long long curpos = -1);
+    bool StartStream(void);
+    bool StreamCredit(int size, long long &streamed, bool &ateof);
+    int  ReadStream(void *data, int size);
+    void DiscardStream(long long streamed);
 
     MythSocket     *openSocket(bool control);
 
@@ -90,6 +95,10 @@ class MBASE_PUBLIC RemoteFile
     MythSocket     *m_sock             {nullptr};
     QString         m_query            {"QUERY_FILETRANSFER %1"};
 
+    bool            m_streaming        {false};
+    bool            m_streamUnsupported {false};
+    RemoteStreamWindow m_stream;
+
     bool            m_writeMode        {false};
     bool            m_completed        {false};
     MythTimer       m_lastSizeCheck;
@@ -0,0 +1,45 @@
+#include <algorithm>
+
+#include "remotestreamwindow.h"
+
+/// \return the window size the backend will accept for a client request
+int RemoteStreamWindow::ClampWindow(int window)
+{
+    return std::clamp(window, kMinimumWindow, kMaximumWindow);
+}
+
+/** \brief (Re)starts the stream at position, with a full window of credit.
+ *
+ *  Called by both ends when the stream is requested and after a seek,
+ *  once the client has discarded the data sent before it.
+ */
+void RemoteStreamWindow::Start(int window, long long position)
+{
+    m_window   = window;
+    m_position = position;
+    m_limit    = position + window;
+}
+
+/// \return bytes the sender may still send before it must wait for credit
+int RemoteStreamWindow::Credit(void) const
+{
+    return static_cast<int>(std::max(m_limit - m_position, 0LL));
+}
+
+/** \brief Returns the credit the receiver should grant now.
+ *
+ *  Credit is only granted once at least half the window has been
+ *  consumed, so a grant costs one control round trip per half window
+ *  while the sender still has the other half to keep the link busy.
+ */
+int RemoteStreamWindow::CreditDue(void) const
+{
+    long long due = m_position + m_window - m_limit;
+    return (due >= m_window / 2) ? static_cast<int>(due) : 0;
+}
+
+/// \return bytes the sender had sent that the receiver has not read yet
+long long RemoteStreamWindow::InFlight(long long sent) const
+{
+    return std::max(sent - m_position, 0LL);
+}
@@ -0,0 +1,45 @@
+#ifndef REMOTESTREAMWINDOW_H_
+#define REMOTESTREAMWINDOW_H_
+
+#include "mythbaseexp.h"
+
+/** \class RemoteStreamWindow
+ *  \brief Credit based flow control for streamed RemoteFile reads.
+ *
+ *  In streaming mode the backend's FileTransfer pushes file data down
+ *  the data socket without waiting for a REQUEST_BLOCK per block, for
+ *  as long as it has not sent more than the client has granted. Both
+ *  ends count the bytes moved since the stream started, so that after
+ *  a seek the client knows exactly how much data from the old position
+ *  is still in flight and must be discarded.
+ *
+ *  This class is not thread-safe.
+ */
+class MBASE_PUBLIC RemoteStreamWindow
+{
+  public:
+    static constexpr int kDefaultWindow { 4 * 1024 * 1024 };
+    static constexpr int kMinimumWindow { 256 * 1024 };
+    static constexpr int kMaximumWindow { 32 * 1024 * 1024 };
+
+    static int ClampWindow(int window);
+
+    void Start(int window, long long position = 0);
+    void Advance(int bytes) { m_position += bytes; }
+    void Grant(long long bytes) { m_limit += bytes; }
+
+    int  Credit(void) const;
+    int  CreditDue(void) const;
+    long long InFlight(long long sent) const;
+
+    int       GetWindow(void) const   { return m_window; }
+    long long GetPosition(void) const { return m_position; }
+    long long GetLimit(void) const    { return m_limit; }
+
+  private:
+    int       m_window   {0};
+    long long m_position {0LL};
+    long long m_limit    {0LL};
+};
+
+#endif
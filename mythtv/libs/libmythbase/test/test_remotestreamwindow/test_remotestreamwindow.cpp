@@ -0,0 +1,3 @@
+#include "test_remotestreamwindow.h"
+
+QTEST_GUILESS_MAIN(TestRemoteStreamWindow)
@@ -0,0 +1,525 @@
+/*
+ *  Class TestRemoteStreamWindow
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "mythcorecontext.h"
+#include "mythversion.h"
+#include "remotefile.h"
+#include "remotestreamwindow.h"
+
+using namespace std::chrono_literals;
+
+/** \brief A backend serving one file transfer to a real RemoteFile.
+ *
+ *  It speaks the same protocol as mythbackend's MainServer and
+ *  FileTransfer, on blocking sockets in its own thread, and counts the
+ *  requests it is sent so that tests don't depend on timing.
+ */
+class ScriptedBackend
+{
+  public:
+    static constexpr long long kFileSize { 4 * 1024 * 1024 };
+    static constexpr int kWindow         { RemoteStreamWindow::kMinimumWindow };
+    static constexpr int kSendSize       { 64 * 1024 };
+
+    struct Counts
+    {
+        int m_requestBlock  {0};
+        int m_requestStream {0};
+        int m_creditGrants  {0};
+        int m_creditPolls   {0};
+        int m_seeks         {0};
+    };
+
+    /// The byte at pos, varying enough to catch data from the wrong place.
+    static char Pattern(long long pos)
+    {
+        return static_cast<char>((pos % 251) ^ (pos >> 16));
+    }
+
+    explicit ScriptedBackend(bool streams, int window = kWindow)
+      : m_streams(streams), m_window(window)
+    {
+        std::promise<quint16> listening;
+        m_thread = std::thread(&ScriptedBackend::Run, this, &listening);
+        m_port = listening.get_future().get();
+    }
+
+    ~ScriptedBackend()
+    {
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    /// Waits for the client to disconnect.
+    Counts Finish(void)
+    {
+        m_thread.join();
+        return m_counts;
+    }
+
+    quint16 Port(void) const { return m_port; }
+
+    static QString Url(quint16 port)
+    {
+        return QString("myth://Default@127.0.0.1:%1/test.ts").arg(port);
+    }
+
+    QString Url(void) const { return Url(m_port); }
+
+  private:
+    static bool ReadStringList(QTcpSocket *sock, QStringList &list)
+    {
+        while (sock->bytesAvailable() < 8)
+        {
+            if (!sock->waitForReadyRead(5000))
+                return false;
+        }
+        int size = sock->read(8).trimmed().toInt();
+        while (sock->bytesAvailable() < size)
+        {
+            if (!sock->waitForReadyRead(5000))
+                return false;
+        }
+        list = QString::fromUtf8(sock->read(size)).split("[]:[]");
+        return true;
+    }
+
+    static void WriteStringList(QTcpSocket *sock, const QStringList &list)
+    {
+        QByteArray utf8 = list.join("[]:[]").toUtf8();
+        QByteArray payload = QByteArray::number(utf8.size()).leftJustified(8, ' ');
+        sock->write(payload + utf8);
+        sock->flush();
+    }
+
+    /// Accepts a connection and answers the protocol check and ANN.
+    static QTcpSocket *Announce(QTcpServer &server, const QStringList &reply)
+    {
+        if (!server.waitForNewConnection(5000))
+            return nullptr;
+        QTcpSocket *sock = server.nextPendingConnection();
+
+        QStringList list;
+        if (!ReadStringList(sock, list) ||
+            !list[0].startsWith("MYTH_PROTO_VERSION"))
+            return nullptr;
+        WriteStringList(sock, QStringList { "ACCEPT", MYTH_PROTO_VERSION });
+
+        if (!ReadStringList(sock, list) || !list[0].startsWith("ANN"))
+            return nullptr;
+        WriteStringList(sock, reply);
+        return sock;
+    }
+
+    int Send(QTcpSocket *data, int size)
+    {
+        size = static_cast<int>(std::min<long long>(size, kFileSize - m_pos));
+        QByteArray buf(size, Qt::Uninitialized);
+        for (int i = 0; i < size; i++)
+            buf[i] = Pattern(m_pos + i);
+        data->write(buf);
+        data->flush();
+        m_pos += size;
+        return size;
+    }
+
+    void Run(std::promise<quint16> *listening)
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        listening->set_value(server.serverPort());
+
+        QTcpSocket *control = Announce(server, QStringList { "OK" });
+        QTcpSocket *data = Announce(server, QStringList
+            { "OK", "1", QString::number(kFileSize) });
+        if (!control || !data)
+            return;
+
+        RemoteStreamWindow window;
+        bool streaming = false;
+
+        while (control->state() == QAbstractSocket::ConnectedState)
+        {
+            // Stream whatever the client has credit for, as
+            // FileTransfer::run() does.
+            int credit = streaming ? window.Credit() : 0;
+            if (credit > 0 && m_pos < kFileSize)
+                window.Advance(Send(data, std::min(credit, kSendSize)));
+            else
+                data->waitForBytesWritten(0);
+
+            bool busy = (streaming && window.Credit() > 0 && m_pos < kFileSize);
+            if (!control->bytesAvailable() && !control->waitForReadyRead(busy ? 0 : 5))
+                continue;
+
+            QStringList list;
+            if (!ReadStringList(control, list) || list.size() < 2)
+                break;
+
+            QString command = list[1];
+            QStringList reply;
+            if (command == "REQUEST_BLOCK")
+            {
+                m_counts.m_requestBlock++;
+                reply << QString::number(Send(data, list[2].toInt()));
+            }
+            else if (command == "REQUEST_STREAM")
+            {
+                m_counts.m_requestStream++;
+                if (m_streams)
+                {
+                    int size = std::min(list[2].toInt(), m_window);
+                    window.Start(size);
+                    streaming = true;
+                    reply << QString::number(size);
+                }
+                else
+                {
+                    // what backends without streaming say
+                    reply << "ERROR" << "invalid_call";
+                }
+            }
+            else if (command == "STREAM_CREDIT")
+            {
+                int size = list[2].toInt();
+                if (size > 0)
+                    m_counts.m_creditGrants++;
+                else
+                    m_counts.m_creditPolls++;
+                window.Grant(size);
+                reply << QString::number(window.GetPosition())
+                      << QString::number(static_cast<int>(m_pos >= kFileSize));
+            }
+            else if (command == "SEEK")
+            {
+                m_counts.m_seeks++;
+                long long pos = list[2].toLongLong();
+                int whence = list[3].toInt();
+                if (whence == SEEK_CUR)
+                    pos += list[4].toLongLong();
+                else if (whence == SEEK_END)
+                    pos += kFileSize;
+                m_pos = std::clamp(pos, 0LL, kFileSize);
+                reply << QString::number(m_pos);
+                if (streaming)
+                {
+                    window.Start(window.GetWindow(), window.GetPosition());
+                    reply << QString::number(window.GetPosition());
+                }
+            }
+            else if (command == "DONE")
+            {
+                WriteStringList(control, QStringList { "OK" });
+                break;
+            }
+            else
+            {
+                reply << "ERROR" << "invalid_call";
+            }
+            WriteStringList(control, reply);
+        }
+
+        control->waitForDisconnected(5000);
+    }
+
+    bool        m_streams {false};
+    int         m_window  {kWindow};
+    std::thread m_thread;
+    quint16     m_port    {0};
+    long long   m_pos     {0};
+    Counts      m_counts;
+};
+
+/** \brief Forwards connections to a port on localhost, delaying the data
+ *         both ways to add a network's round trip time.
+ */
+class DelayProxy
+{
+  public:
+    static constexpr std::chrono::milliseconds kLatency { 10ms };
+
+    explicit DelayProxy(quint16 port)
+    {
+        std::promise<quint16> listening;
+        m_thread = std::thread(&DelayProxy::Run, this, port, &listening);
+        m_port = listening.get_future().get();
+    }
+
+    ~DelayProxy()
+    {
+        m_stop = true;
+        m_thread.join();
+    }
+
+    quint16 Port(void) const { return m_port; }
+
+  private:
+    struct Link
+    {
+        struct Pending
+        {
+            std::chrono::steady_clock::time_point m_due;
+            QByteArray m_data;
+        };
+
+        QTcpSocket          *m_from {nullptr};
+        QTcpSocket          *m_to   {nullptr};
+        std::deque<Pending>  m_queue;
+    };
+
+    void Run(quint16 port, std::promise<quint16> *listening)
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        listening->set_value(server.serverPort());
+
+        std::vector<std::unique_ptr<QTcpSocket>> upstreams;
+        std::vector<Link> links;
+
+        while (!m_stop)
+        {
+            if (server.waitForNewConnection(0))
+            {
+                QTcpSocket *client = server.nextPendingConnection();
+                auto upstream = std::make_unique<QTcpSocket>();
+                upstream->connectToHost(QHostAddress::LocalHost, port);
+                if (!upstream->waitForConnected(5000))
+                    return;
+                links.push_back({ client, upstream.get(), {} });
+                links.push_back({ upstream.get(), client, {} });
+                upstreams.push_back(std::move(upstream));
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            for (Link &link : links)
+            {
+                link.m_from->waitForReadyRead(0);
+                QByteArray data = link.m_from->readAll();
+                if (!data.isEmpty())
+                    link.m_queue.push_back({ now + kLatency, data });
+                while (!link.m_queue.empty() && link.m_queue.front().m_due <= now)
+                {
+                    link.m_to->write(link.m_queue.front().m_data);
+                    link.m_queue.pop_front();
+                }
+                link.m_to->flush();
+
+                // pass a disconnect on after the data sent before it
+                if (link.m_queue.empty() &&
+                    link.m_from->state() != QAbstractSocket::ConnectedState &&
+                    link.m_to->state() == QAbstractSocket::ConnectedState)
+                    link.m_to->disconnectFromHost();
+            }
+            std::this_thread::sleep_for(200us);
+        }
+    }
+
+    std::atomic_bool m_stop {false};
+    std::thread      m_thread;
+    quint16          m_port {0};
+};
+
+class TestRemoteStreamWindow : public QObject
+{
+    Q_OBJECT
+
+  private:
+    static constexpr int kReadSize { 64 * 1024 };
+
+    /// Reads size bytes at pos and checks they came from there.
+    static bool ReadAndVerify(RemoteFile &file, long long pos, long long size)
+    {
+        std::vector<char> buf(kReadSize);
+        while (size > 0)
+        {
+            int ret = file.Read(buf.data(), static_cast<int>(std::min<long long>(size, kReadSize)));
+            if (ret <= 0)
+                return false;
+            for (int i = 0; i < ret; i++)
+                if (buf[i] != ScriptedBackend::Pattern(pos + i))
+                    return false;
+            pos += ret;
+            size -= ret;
+        }
+        return true;
+    }
+
+    /// Reads the whole file through a DelayProxy, returning the time taken.
+    static std::chrono::milliseconds ReadThroughProxy(bool streams)
+    {
+        // as much as FileTransfer grants RemoteFile
+        ScriptedBackend backend(streams, RemoteStreamWindow::kDefaultWindow);
+        DelayProxy proxy(backend.Port());
+        std::chrono::milliseconds elapsed = -1ms;
+        {
+            RemoteFile file(ScriptedBackend::Url(proxy.Port()));
+            QElapsedTimer timer;
+            timer.start();
+            if (file.isOpen() && ReadAndVerify(file, 0, ScriptedBackend::kFileSize))
+                elapsed = std::chrono::milliseconds(timer.elapsed());
+        }
+        backend.Finish();
+        return elapsed;
+    }
+
+  private slots:
+    static void initTestCase(void)
+    {
+        gCoreContext = new MythCoreContext("bin_version", nullptr);
+    }
+
+    static void credit(void)
+    {
+        RemoteStreamWindow window;
+        window.Start(1000);
+        QCOMPARE(window.Credit(), 1000);
+        QCOMPARE(window.CreditDue(), 0);
+
+        // No round trip for credit until half the window is consumed
+        window.Advance(400);
+        QCOMPARE(window.Credit(), 600);
+        QCOMPARE(window.CreditDue(), 0);
+        window.Advance(100);
+        QCOMPARE(window.CreditDue(), 500);
+        window.Grant(window.CreditDue());
+        QCOMPARE(window.Credit(), 1000);
+        QCOMPARE(window.GetLimit(), 1500LL);
+
+        window.Advance(1000);
+        QCOMPARE(window.Credit(), 0);
+
+        QCOMPARE(RemoteStreamWindow::ClampWindow(1),
+                 RemoteStreamWindow::kMinimumWindow);
+        QCOMPARE(RemoteStreamWindow::ClampWindow(1 << 30),
+                 RemoteStreamWindow::kMaximumWindow);
+    }
+
+    static void seek(void)
+    {
+        // The backend had streamed 3000 bytes when it stopped for the
+        // seek, of which the client has read 1200.
+        RemoteStreamWindow client;
+        client.Start(2000);
+        client.Advance(1200);
+        client.Grant(client.CreditDue());
+        QCOMPARE(client.InFlight(3000), 1800LL);
+        QCOMPARE(client.InFlight(1000), 0LL);
+
+        // Both ends restart the stream from the backend's count
+        client.Start(client.GetWindow(), 3000);
+        QCOMPARE(client.GetPosition(), 3000LL);
+        QCOMPARE(client.Credit(), 2000);
+    }
+
+    /// A backend without streaming gets one REQUEST_BLOCK per Read().
+    static void remoteFileBlocks(void)
+    {
+        ScriptedBackend backend(false);
+        {
+            RemoteFile file(backend.Url());
+            QVERIFY(file.isOpen());
+            QVERIFY(ReadAndVerify(file, 0, ScriptedBackend::kFileSize));
+        }
+        ScriptedBackend::Counts counts = backend.Finish();
+
+        QCOMPARE(counts.m_requestStream, 1);
+        QCOMPARE(counts.m_requestBlock,
+                 static_cast<int>(ScriptedBackend::kFileSize / kReadSize));
+    }
+
+    /// Streaming costs one credit round trip per half window.
+    static void remoteFileStream(void)
+    {
+        ScriptedBackend backend(true);
+        {
+            RemoteFile file(backend.Url());
+            QVERIFY(file.isOpen());
+            QVERIFY(ReadAndVerify(file, 0, ScriptedBackend::kFileSize));
+
+            // at the end of the file
+            std::vector<char> buf(kReadSize);
+            QCOMPARE(file.Read(buf.data(), kReadSize), 0);
+        }
+        ScriptedBackend::Counts counts = backend.Finish();
+
+        qInfo() << "Credit grants" << counts.m_creditGrants
+                << "polls" << counts.m_creditPolls;
+        QCOMPARE(counts.m_requestStream, 1);
+        QCOMPARE(counts.m_requestBlock, 0);
+        QVERIFY(counts.m_creditGrants >= 1);
+        QVERIFY(counts.m_creditGrants <=
+                ScriptedBackend::kFileSize / (ScriptedBackend::kWindow / 2));
+    }
+
+    /// Data streamed from before a seek is discarded, however much of it
+    /// is still in flight.
+    static void remoteFileSeek(void)
+    {
+        static constexpr long long kSeekTo { 3 * 1024 * 1024 };
+
+        ScriptedBackend backend(true);
+        {
+            RemoteFile file(backend.Url());
+            QVERIFY(file.isOpen());
+            QVERIFY(ReadAndVerify(file, 0, 1024 * 1024));
+            QCOMPARE(file.Seek(kSeekTo, SEEK_SET), kSeekTo);
+            QVERIFY(ReadAndVerify(file, kSeekTo, 512 * 1024));
+            QCOMPARE(file.Seek(1024, SEEK_SET), 1024LL);
+            QVERIFY(ReadAndVerify(file, 1024, ScriptedBackend::kFileSize - 1024));
+        }
+        ScriptedBackend::Counts counts = backend.Finish();
+
+        QCOMPARE(counts.m_seeks, 2);
+        QCOMPARE(counts.m_requestBlock, 0);
+    }
+
+    /// Over a network each REQUEST_BLOCK costs a round trip, which
+    /// streaming only pays a few times for the whole file.
+    static void remoteFileLatency(void)
+    {
+        std::chrono::milliseconds blocks = ReadThroughProxy(false);
+        std::chrono::milliseconds streamed = ReadThroughProxy(true);
+        QVERIFY(blocks > 0ms);
+        QVERIFY(streamed > 0ms);
+
+        static constexpr long long kKiB { 1024 };
+        qInfo() << QString("%1 KiB with a %2 ms round trip: %3 KiB/s requesting "
+                           "blocks, %4 KiB/s streaming")
+            .arg(ScriptedBackend::kFileSize / kKiB)
+            .arg((DelayProxy::kLatency * 2).count())
+            .arg(ScriptedBackend::kFileSize * 1000 / kKiB / blocks.count())
+            .arg(ScriptedBackend::kFileSize * 1000 / kKiB / streamed.count());
+
+        QVERIFY(blocks >= (ScriptedBackend::kFileSize / kReadSize) *
+                          DelayProxy::kLatency * 2);
+        QVERIFY(streamed * 2 < blocks);
+    }
+};
@@ -23,20 +23,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <cstdlib>
 #include <cstring>
 #include <vector>
-#ifdef USE_FFTW3
-#include "fftw3.h"
-#else
 extern "C" {
-#include "libavcodec/avfft.h"
-#include "libavcodec/fft.h"
+#include "libavutil/mem.h"
+#include "libavutil/tx.h"
 }
-using FFTComplexArray = FFTSample[2];
-#endif
-
-
-#if defined(_WIN32) && defined(USE_FFTW3)
-#pragma comment (lib,"libfftw3f-3.lib")
-#endif
 
 using cfloat = std::complex<float>;
 using InputBufs  = std::array<float*,2>;
@@ -52,40 +42,26 @@ public:
     // create an instance of the decoder
     //  blocksize is fixed over the lifetime of this object for performance reasons
     explicit decoder_impl(unsigned blocksize=8192): m_n(blocksize), m_halfN(blocksize/2) {
-#ifdef USE_FFTW3
-        // create FFTW buffers
-        m_lt = (float*)fftwf_malloc(sizeof(float)*m_n);
-        m_rt = (float*)fftwf_malloc(sizeof(float)*m_n);
-        m_dst = (float*)fftwf_malloc(sizeof(float)*m_n);
-        m_dftL = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex)*m_n);
-        m_dftR = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex)*m_n);
-        m_src = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex)*m_n);
-        m_loadL = fftwf_plan_dft_r2c_1d(m_n, m_lt, m_dftL,FFTW_MEASURE);
-        m_loadR = fftwf_plan_dft_r2c_1d(m_n, m_rt, m_dftR,FFTW_MEASURE);
-        m_store = fftwf_plan_dft_c2r_1d(m_n, m_src, m_dst,FFTW_MEASURE);
-#else
-        // create lavc fft buffers
-        m_lt = (float*)av_malloc(sizeof(FFTSample)*m_n);
-        m_rt = (float*)av_malloc(sizeof(FFTSample)*m_n);
-        m_dftL = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_dftR = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_src = (FFTComplexArray*)av_malloc(sizeof(FFTComplex)*m_n*2);
-        m_fftContextForward = (FFTContext*)av_malloc(sizeof(FFTContext));
-        memset(m_fftContextForward, 0, sizeof(FFTContext));
-        m_fftContextReverse = (FFTContext*)av_malloc(sizeof(FFTContext));
-        memset(m_fftContextReverse, 0, sizeof(FFTContext));
-        ff_fft_init(m_fftContextForward, 13, 0);
-        ff_fft_init(m_fftContextReverse, 13, 1);
-#endif
-        // resize our own buffers
-        m_frontR.resize(m_n);
-        m_frontL.resize(m_n);
-        m_avg.resize(m_n);
-        m_surR.resize(m_n);
-        m_surL.resize(m_n);
-        m_trueavg.resize(m_n);
-        m_xFs.resize(m_n);
-        m_yFs.resize(m_n);
+        // create the lavu transforms and their (suitably aligned) buffers
+        // both real signals go through one complex transform in each direction
+        float scale = 1.0F;
+        if (av_tx_init(&m_forward, &m_forwardFn, AV_TX_FLOAT_FFT, 0, static_cast<int>(m_n), &scale, 0) < 0)
+            m_forward = nullptr;
+        if (av_tx_init(&m_inverse, &m_inverseFn, AV_TX_FLOAT_FFT, 1, static_cast<int>(m_n), &scale, 0) < 0)
+            m_inverse = nullptr;
+        m_txIn  = static_cast<AVComplexFloat*>(av_mallocz(sizeof(AVComplexFloat)*m_n));
+        m_txOut = static_cast<AVComplexFloat*>(av_mallocz(sizeof(AVComplexFloat)*m_n));
+        // resize our own buffers, we only need the bins up to N/2
+        m_dftL.resize(m_halfN+1);
+        m_dftR.resize(m_halfN+1);
+        m_frontR.resize(m_halfN+1);
+        m_frontL.resize(m_halfN+1);
+        m_avg.resize(m_halfN+1);
+        m_surR.resize(m_halfN+1);
+        m_surL.resize(m_halfN+1);
+        m_trueavg.resize(m_halfN+1);
+        m_xFs.resize(m_halfN+1);
+        m_yFs.resize(m_halfN+1);
         m_inbuf[0].resize(m_n);
         m_inbuf[1].resize(m_n);
         for (unsigned c=0;c<6;c++) {
@@ -109,28 +85,10 @@ public:
 
     // destructor
     ~decoder_impl() {
-#ifdef USE_FFTW3
-        // clean up the FFTW stuff
-        fftwf_destroy_plan(m_store);
-        fftwf_destroy_plan(m_loadR);
-        fftwf_destroy_plan(m_loadL);
-        fftwf_free(m_src);
-        fftwf_free(m_dftR);
-        fftwf_free(m_dftL);
-        fftwf_free(m_dst);
-        fftwf_free(m_rt);
-        fftwf_free(m_lt);
-#else
-        ff_fft_end(m_fftContextForward);
-        ff_fft_end(m_fftContextReverse);
-        av_free(m_src);
-        av_free(m_dftR);
-        av_free(m_dftL);
-        av_free(m_rt);
-        av_free(m_lt);
-        av_free(m_fftContextForward);
-        av_free(m_fftContextReverse);
-#endif
+        av_tx_uninit(&m_forward);
+        av_tx_uninit(&m_inverse);
+        av_free(m_txIn);
+        av_free(m_txOut);
     }
 
     float ** getInputBuffers()
@@ -210,6 +168,8 @@ public:
         const std::array<std::array<float,2>,4> modes {{ {0,0}, {0,PI}, {PI,0}, {-PI/2,PI/2} }};
         m_phaseOffsetL = modes[mode][0];
         m_phaseOffsetR = modes[mode][1];
+        m_phaseShiftL = std::polar(1.0F, m_phaseOffsetL);
+        m_phaseShiftR = std::polar(1.0F, m_phaseOffsetR);
     }
 
     // what steering mode should be chosen
@@ -222,10 +182,6 @@ public:
     }
 
 private:
-    // polar <-> cartesian coodinates conversion
-    static inline float amplitude(const float *cf) { return std::sqrt(cf[0]*cf[0] + cf[1]*cf[1]); }
-    static inline float phase(const float *cf) { return std::atan2(cf[1],cf[0]); }
-    static inline cfloat polar(float a, float p) { return {static_cast<float>(a*std::cos(p)),static_cast<float>(a*std::sin(p))}; }
     static inline float sqr(float x) { return x*x; }
     // the dreaded min/max
     static inline float min(float a, float b) { return a<b?a:b; }
@@ -241,56 +197,49 @@ private:
 
     // CORE FUNCTION: decode a block of data
     void block_decode(InputBufs input1, InputBufs input2, OutputBufs output, float center_width, float dimension, float adaption_rate) {
+        if (!m_forward || !m_inverse || !m_txIn || !m_txOut)
+            return;
+
         // 1. scale the input by the window function; this serves a dual purpose:
         // - first it improves the FFT resolution b/c boundary discontinuities (and their frequencies) get removed
         // - second it allows for smooth blending of varying filters between the blocks
+        // left and right are packed as the real and imaginary parts of a single complex signal
         {
-            float* pWnd = &m_wnd[0];
-            float* pLt =  &m_lt[0];
-            float* pRt =  &m_rt[0];
-            float* pIn0 = input1[0];
-            float* pIn1 = input1[1];
-            for (unsigned k=0;k<m_halfN;k++) {
-                *pLt++ = *pIn0++ * *pWnd;
-                *pRt++ = *pIn1++ * *pWnd++;
-            }
-            pIn0 = input2[0];
-            pIn1 = input2[1];
-            for (unsigned k=0;k<m_halfN;k++) {
-                *pLt++ = *pIn0++ * *pWnd;
-                *pRt++ = *pIn1++ * *pWnd++;
-            }
+            const float* pWnd = &m_wnd[0];
+            AVComplexFloat* pIn = m_txIn;
+            for (unsigned k=0;k<m_halfN;k++)
+                pIn[k] = { input1[0][k] * pWnd[k], input1[1][k] * pWnd[k] };
+            pWnd += m_halfN;
+            pIn  += m_halfN;
+            for (unsigned k=0;k<m_halfN;k++)
+                pIn[k] = { input2[0][k] * pWnd[k], input2[1][k] * pWnd[k] };
         }
 
-#ifdef USE_FFTW3
         // ... and tranform it into the frequency domain
-        fftwf_execute(m_loadL);
-        fftwf_execute(m_loadR);
-#else
-        ff_fft_permuteRC(m_fftContextForward, m_lt, (FFTComplex*)&m_dftL[0]);
-        av_fft_calc(m_fftContextForward, (FFTComplex*)&m_dftL[0]);
+        m_forwardFn(m_forward, m_txOut, m_txIn, sizeof(AVComplexFloat));
 
-        ff_fft_permuteRC(m_fftContextForward, m_rt, (FFTComplex*)&m_dftR[0]);
-        av_fft_calc(m_fftContextForward, (FFTComplex*)&m_dftR[0]);
-#endif
+        // ... then separate the spectra of the two real signals again
+        // L[f] = (Z[f] + conj(Z[N-f])) / 2, R[f] = (Z[f] - conj(Z[N-f])) / 2i
+        for (unsigned f=0;f<=m_halfN;f++) {
+            const AVComplexFloat z  = m_txOut[f];
+            const AVComplexFloat zc = m_txOut[f ? m_n-f : 0];
+            m_dftL[f] = cfloat(0.5F*(z.re+zc.re), 0.5F*(z.im-zc.im));
+            m_dftR[f] = cfloat(0.5F*(z.im+zc.im), 0.5F*(zc.re-z.re));
+        }
 
         // 2. compare amplitude and phase of each DFT bin and produce the X/Y coordinates in the sound field
         //    but dont do DC or N/2 component
         for (unsigned f=0;f<m_halfN;f++) {
-            // get left/right amplitudes/phases
-            float ampL = amplitude(m_dftL[f]);
-            float ampR = amplitude(m_dftR[f]);
-            float phaseL = phase(m_dftL[f]);
-            float phaseR = phase(m_dftR[f]);
-//          if (ampL+ampR < epsilon)
-//              continue;       
-
-            // calculate the amplitude/phase difference
+            // get left/right amplitudes and the phase difference, which is the
+            // angle between the two bins
+            float ampL = std::abs(m_dftL[f]);
+            float ampR = std::abs(m_dftR[f]);
+            float dot   = m_dftL[f].real()*m_dftR[f].real() + m_dftL[f].imag()*m_dftR[f].imag();
+            float cross = m_dftL[f].imag()*m_dftR[f].real() - m_dftL[f].real()*m_dftR[f].imag();
+            float phaseDiff = std::atan2(std::abs(cross), dot);
+
+            // calculate the amplitude difference
             float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-            float phaseDiff = phaseL - phaseR;
-            if (phaseDiff < -PI) phaseDiff += 2*PI;
-            if (phaseDiff > PI) phaseDiff -= 2*PI;
-            phaseDiff = abs(phaseDiff);
 
             if (m_linearSteering) {
                 // --- this is the fancy new linear mode ---
@@ -298,94 +247,89 @@ private:
                 // get sound field x/y position
                 m_yFs[f] = get_yfs(ampDiff,phaseDiff);
                 m_xFs[f] = get_xfs(ampDiff,m_yFs[f]);
-
-                // add dimension control
-                m_yFs[f] = clamp(m_yFs[f] - dimension);
-
-                // add crossfeed control
-                m_xFs[f] = clamp(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
-
-                // 3. generate frequency filters for each output channel
-                float left = (1-m_xFs[f])/2;
-                float right = (1+m_xFs[f])/2;
-                float front = (1+m_yFs[f])/2;
-                float back = (1-m_yFs[f])/2;
-                std::array<float,5> volume {
-                    front * (left * center_width + max(0,-m_xFs[f]) * (1-center_width)),  // left
-                    front * center_level*((1-abs(m_xFs[f])) * (1-center_width)),          // center
-                    front * (right * center_width + max(0, m_xFs[f]) * (1-center_width)), // right
-                    back * m_surroundLevel * left,                                        // left surround
-                    back * m_surroundLevel * right                                        // right surround
-                };
-
-                // adapt the prior filter
-                for (unsigned c=0;c<5;c++)
-                    m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
-
             } else {
                 // --- this is the old & simple steering mode ---
 
-                // calculate the amplitude/phase difference
-                float ampDiff = clamp((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-                float phaseDiff = phaseL - phaseR;
-                if (phaseDiff < -PI) phaseDiff += 2*PI;
-                if (phaseDiff > PI) phaseDiff -= 2*PI;
-                phaseDiff = abs(phaseDiff);
-
                 // determine sound field x-position
                 m_xFs[f] = ampDiff;
 
                 // determine preliminary sound field y-position from phase difference
                 m_yFs[f] = 1 - (phaseDiff/PI)*2;
 
-                if (abs(m_xFs[f]) > m_surroundBalance) {
+                if (std::abs(m_xFs[f]) > m_surroundBalance) {
                     // blend linearly between the surrounds and the fronts if the balance exceeds the surround encoding balance
                     // this is necessary because the sound field is trapezoidal and will be stretched behind the listener
-                    float frontness = (abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
+                    float frontness = (std::abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
                     m_yFs[f]  = (1-frontness) * m_yFs[f] + frontness * 1;
                 }
-
-                // add dimension control
-                m_yFs[f] = clamp(m_yFs[f] - dimension);
-
-                // add crossfeed control
-                m_xFs[f] = clamp(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
-
-                // 3. generate frequency filters for each output channel, according to the signal position
-                // the sum of all channel volumes must be 1.0
-                float left = (1-m_xFs[f])/2;
-                float right = (1+m_xFs[f])/2;
-                float front = (1+m_yFs[f])/2;
-                float back = (1-m_yFs[f])/2;
-                std::array<float,5> volume {
-                    front * (left * center_width + max(0,-m_xFs[f]) * (1-center_width)),      // left
-                    front * center_level*((1-abs(m_xFs[f])) * (1-center_width)),              // center
-                    front * (right * center_width + max(0, m_xFs[f]) * (1-center_width)),     // right
-                    back * m_surroundLevel*max(0,min(1,((1-(m_xFs[f]/m_surroundBalance))/2))),// left surround
-                    back * m_surroundLevel*max(0,min(1,((1+(m_xFs[f]/m_surroundBalance))/2))) // right surround
-                };
-
-                // adapt the prior filter
-                for (unsigned c=0;c<5;c++)
-                    m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
             }
 
-            // ... and build the signal which we want to position
-            m_frontL[f] = polar(ampL+ampR,phaseL);
-            m_frontR[f] = polar(ampL+ampR,phaseR);
+            // add dimension control
+            m_yFs[f] = clamp(m_yFs[f] - dimension);
+
+            // add crossfeed control
+            m_xFs[f] = clamp(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
+
+            // ... and build the signal which we want to position, i.e. the
+            // summed amplitude with the phase of each side
+            float amp = ampL+ampR;
+            m_frontL[f] = ampL > 0 ? m_dftL[f] * (amp/ampL) : cfloat(amp,0);
+            m_frontR[f] = ampR > 0 ? m_dftR[f] * (amp/ampR) : cfloat(amp,0);
             m_avg[f] = m_frontL[f] + m_frontR[f];
-            m_surL[f] = polar(ampL+ampR,phaseL+m_phaseOffsetL);
-            m_surR[f] = polar(ampL+ampR,phaseR+m_phaseOffsetR);
-            m_trueavg[f] = cfloat(m_dftL[f][0] + m_dftR[f][0], m_dftL[f][1] + m_dftR[f][1]);
+            m_surL[f] = m_frontL[f] * m_phaseShiftL;
+            m_surR[f] = m_frontR[f] * m_phaseShiftR;
+            m_trueavg[f] = m_dftL[f] + m_dftR[f];
         }
 
-        // 4. distribute the unfiltered reference signals over the channels
-        apply_filter(&m_frontL[0], &m_filter[0][0],&output[0][0]);  // front left
-        apply_filter(&m_avg[0],    &m_filter[1][0],&output[1][0]);  // front center
-        apply_filter(&m_frontR[0], &m_filter[2][0],&output[2][0]);  // front right
-        apply_filter(&m_surL[0],   &m_filter[3][0],&output[3][0]);  // surround left
-        apply_filter(&m_surR[0],   &m_filter[4][0],&output[4][0]);  // surround right
-        apply_filter(&m_trueavg[0],&m_filter[5][0],&output[5][0]);  // lfe
+        // 3. generate frequency filters for each output channel, according to the signal position
+        // the sum of all channel volumes must be 1.0
+        // these loops have no dependencies between bins so that the compiler can vectorize them
+        {
+            const float* xFs = &m_xFs[0];
+            const float* yFs = &m_yFs[0];
+            float* fl  = &m_filter[0][0];
+            float* fc  = &m_filter[1][0];
+            float* fr  = &m_filter[2][0];
+            float* fsl = &m_filter[3][0];
+            float* fsr = &m_filter[4][0];
+            const float keep = 1-adaption_rate;
+            const float width = 1-center_width;
+            if (m_linearSteering) {
+                for (unsigned f=0;f<m_halfN;f++) {
+                    float left = (1-xFs[f])/2;
+                    float right = (1+xFs[f])/2;
+                    float front = (1+yFs[f])/2;
+                    float back = (1-yFs[f])/2;
+                    // adapt the prior filter
+                    fl[f]  = keep*fl[f]  + adaption_rate*(front * (left * center_width + max(0,-xFs[f]) * width));
+                    fc[f]  = keep*fc[f]  + adaption_rate*(front * center_level*((1-std::abs(xFs[f])) * width));
+                    fr[f]  = keep*fr[f]  + adaption_rate*(front * (right * center_width + max(0, xFs[f]) * width));
+                    fsl[f] = keep*fsl[f] + adaption_rate*(back * m_surroundLevel * left);
+                    fsr[f] = keep*fsr[f] + adaption_rate*(back * m_surroundLevel * right);
+                }
+            } else {
+                for (unsigned f=0;f<m_halfN;f++) {
+                    float left = (1-xFs[f])/2;
+                    float right = (1+xFs[f])/2;
+                    float front = (1+yFs[f])/2;
+                    float back = (1-yFs[f])/2;
+                    // adapt the prior filter
+                    fl[f]  = keep*fl[f]  + adaption_rate*(front * (left * center_width + max(0,-xFs[f]) * width));
+                    fc[f]  = keep*fc[f]  + adaption_rate*(front * center_level*((1-std::abs(xFs[f])) * width));
+                    fr[f]  = keep*fr[f]  + adaption_rate*(front * (right * center_width + max(0, xFs[f]) * width));
+                    fsl[f] = keep*fsl[f] + adaption_rate*(back * m_surroundLevel*max(0,min(1,((1-(xFs[f]/m_surroundBalance))/2))));
+                    fsr[f] = keep*fsr[f] + adaption_rate*(back * m_surroundLevel*max(0,min(1,((1+(xFs[f]/m_surroundBalance))/2))));
+                }
+            }
+        }
+
+        // 4. distribute the unfiltered reference signals over the channels, two channels per inverse transform
+        apply_filters(&m_frontL[0], &m_filter[0][0], &output[0][0],   // front left
+                      &m_avg[0],    &m_filter[1][0], &output[1][0]);  // front center
+        apply_filters(&m_frontR[0], &m_filter[2][0], &output[2][0],   // front right
+                      &m_surL[0],   &m_filter[3][0], &output[3][0]);  // surround left
+        apply_filters(&m_surR[0],   &m_filter[4][0], &output[4][0],   // surround right
+                      &m_trueavg[0],&m_filter[5][0], &output[5][0]);  // lfe
     }
 
 #define FASTER_CALC
@@ -437,110 +381,56 @@ private:
 #endif
     }
 
-    // filter the complex source signal and add it to target
-    void apply_filter(cfloat *signal, const float *flt, float *target) {
-        // filter the signal
-        for (unsigned f=0;f<=m_halfN;f++) {
-            m_src[f][0] = signal[f].real() * flt[f];
-            m_src[f][1] = signal[f].imag() * flt[f];
-        }
-#ifdef USE_FFTW3
-        // transform into time domain
-        fftwf_execute(m_store);
-
-        float* pT1   = &target[m_currentBuf*m_halfN];
-        float* pWnd1 = &m_wnd[0];
-        float* pDst1 = &m_dst[0];
-        float* pT2   = &target[(m_currentBuf^1)*m_halfN];
-        float* pWnd2 = &m_wnd[m_halfN];
-        float* pDst2 = &m_dst[m_halfN];
-        // add the result to target, windowed
-        for (unsigned int k=0;k<m_halfN;k++)
-        {
-            // 1st part is overlap add
-            *pT1++ += *pWnd1++ * *pDst1++;
-            // 2nd part is set as has no history
-            *pT2++  = *pWnd2++ * *pDst2++;
-        }
-#else
-        // enforce odd symmetry
+    // filter two complex source signals and add them to their targets
+    // both spectra are hermitian, so A + iB transforms back to a as the real and b as the imaginary part
+    void apply_filters(const cfloat *signalA, const float *fltA, float *targetA,
+                       const cfloat *signalB, const float *fltB, float *targetB) {
+        // filter the signals, ignoring the imaginary parts of DC and N/2 as a real transform would
+        AVComplexFloat* pSrc = m_txIn;
+        pSrc[0] = { signalA[0].real() * fltA[0], signalB[0].real() * fltB[0] };
+        pSrc[m_halfN] = { signalA[m_halfN].real() * fltA[m_halfN], signalB[m_halfN].real() * fltB[m_halfN] };
         for (unsigned f=1;f<m_halfN;f++) {
-            m_src[m_n-f][0] = m_src[f][0];
-            m_src[m_n-f][1] = -m_src[f][1];   // complex conjugate
+            float aRe = signalA[f].real() * fltA[f];
+            float aIm = signalA[f].imag() * fltA[f];
+            float bRe = signalB[f].real() * fltB[f];
+            float bIm = signalB[f].imag() * fltB[f];
+            pSrc[f]       = { aRe - bIm, aIm + bRe };
+            pSrc[m_n-f]   = { aRe + bIm, bRe - aIm };   // complex conjugate symmetry
         }
-        av_fft_permute(m_fftContextReverse, (FFTComplex*)&m_src[0]);
-        av_fft_calc(m_fftContextReverse, (FFTComplex*)&m_src[0]);
-
-        float* pT1   = &target[m_currentBuf*m_halfN];
-        float* pWnd1 = &m_wnd[0];
-        float* pDst1 = &m_src[0][0];
-        float* pT2   = &target[(m_currentBuf^1)*m_halfN];
-        float* pWnd2 = &m_wnd[m_halfN];
-        float* pDst2 = &m_src[m_halfN][0];
+
+        // transform into time domain
+        m_inverseFn(m_inverse, m_txOut, m_txIn, sizeof(AVComplexFloat));
+
+        float* pA1   = &targetA[m_currentBuf*m_halfN];
+        float* pB1   = &targetB[m_currentBuf*m_halfN];
+        float* pA2   = &targetA[(m_currentBuf^1)*m_halfN];
+        float* pB2   = &targetB[(m_currentBuf^1)*m_halfN];
+        const float* pWnd1 = &m_wnd[0];
+        const float* pWnd2 = &m_wnd[m_halfN];
+        const AVComplexFloat* pDst1 = m_txOut;
+        const AVComplexFloat* pDst2 = m_txOut + m_halfN;
         // add the result to target, windowed
         for (unsigned int k=0;k<m_halfN;k++)
         {
             // 1st part is overlap add
-            *pT1++ += *pWnd1++ * *pDst1; pDst1 += 2;
+            pA1[k] += pWnd1[k] * pDst1[k].re;
+            pB1[k] += pWnd1[k] * pDst1[k].im;
             // 2nd part is set as has no history
-            *pT2++  = *pWnd2++ * *pDst2; pDst2 += 2;
+            pA2[k]  = pWnd2[k] * pDst2[k].re;
+            pB2[k]  = pWnd2[k] * pDst2[k].im;
         }
-#endif
     }
 
-#ifndef USE_FFTW3
-    /**
-     *  * Do the permutation needed BEFORE calling ff_fft_calc()
-     *  special for freesurround that also copies
-     *   */
-    void ff_fft_permuteRC(FFTContext *s, FFTSample *r, FFTComplex *z)
-    {
-        int j, k, np;
-        const uint16_t *revtab = s->revtab;
-
-        /* reverse */
-        np = 1 << s->nbits;
-        for(j=0;j<np;j++) {
-            k = revtab[j];
-            z[k].re = r[j];
-            z[k].im = 0.0;
-        }
-    }
-
-    /**
-     *  * Do the permutation needed BEFORE calling ff_fft_calc()
-     *  special for freesurround that also copies and 
-     *  discards im component as it should be 0
-     *   */
-    void ff_fft_permuteCR(FFTContext *s, FFTComplex *z, FFTSample *r)
-    {
-        int j, k, np;
-        const uint16_t *revtab = s->revtab;
-
-        /* reverse */
-        np = 1 << s->nbits;
-        for(j=0;j<np;j++) {
-            k = revtab[j];
-            if (k < j) {
-                r[k] = z[j].re;
-                r[j] = z[k].re;
-            }
-        }
-    }
-#endif
-
     unsigned int m_n;                    // the block size
     unsigned int m_halfN;                // half block size precalculated
-#ifdef USE_FFTW3
-    // FFTW data structures
-    float *m_lt,*m_rt,*m_dst;              // left total, right total (source arrays), destination array
-    fftwf_complex *m_dftL,*m_dftR,*m_src;  // intermediate arrays (FFTs of lt & rt, processing source)
-    fftwf_plan m_loadL,m_loadR,m_store;    // plans for loading the data into the intermediate format and back
-#else
-    FFTContext *m_fftContextForward, *m_fftContextReverse;
-    FFTSample *m_lt,*m_rt;                 // left total, right total (source arrays), destination array
-    FFTComplexArray *m_dftL,*m_dftR,*m_src;// intermediate arrays (FFTs of lt & rt, processing source)
-#endif
+    // lavu transforms
+    AVTXContext *m_forward {nullptr};    // forward transform of the packed input
+    AVTXContext *m_inverse {nullptr};    // inverse transform of two packed output channels
+    av_tx_fn m_forwardFn {nullptr};
+    av_tx_fn m_inverseFn {nullptr};
+    AVComplexFloat *m_txIn {nullptr};    // transform source, aligned for the SIMD transforms
+    AVComplexFloat *m_txOut {nullptr};   // transform destination
+    std::vector<cfloat> m_dftL,m_dftR;   // the spectra of the left and right totals
     // buffers
     std::vector<cfloat> m_frontL,m_frontR,m_avg,m_surL,m_surR; // the signal (phase-corrected) in the frequency domain
     std::vector<cfloat> m_trueavg;       // for lfe generation
@@ -556,6 +446,8 @@ private:
     float m_surroundLevel   {0.0F};      // gain for the surround channels (follows from the coeffs
     float m_phaseOffsetL    {0.0F};      // phase shifts to be applied to the rear channels
     float m_phaseOffsetR    {0.0F};      // phase shifts to be applied to the rear channels
+    cfloat m_phaseShiftL    {1.0F,0.0F}; // the phase offsets as unit vectors
+    cfloat m_phaseShiftR    {1.0F,0.0F};
     float m_frontSeparation {0.0F};      // front stereo separation
     float m_rearSeparation  {0.0F};      // rear stereo separation
     bool  m_linearSteering  {false};     // whether the steering should be linear or not
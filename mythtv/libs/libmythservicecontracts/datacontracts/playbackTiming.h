@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: playbackTiming.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLAYBACKTIMING_H_
+#define PLAYBACKTIMING_H_
+
+#include <QString>
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "labelValue.h"
+
+namespace DTC
+{
+
+/// Statistics, in milliseconds, of the recent events of one type, and
+/// the time at which each stage of the last one was reached.
+class SERVICE_PUBLIC PlaybackTiming : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version"    , "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "Stages", "type=DTC::LabelValue");
+
+    Q_PROPERTY( QString    Event           READ Event
+                                           WRITE setEvent       )
+    Q_PROPERTY( int        Count           READ Count
+                                           WRITE setCount       )
+    Q_PROPERTY( int        Last            READ Last
+                                           WRITE setLast        )
+    Q_PROPERTY( int        Min             READ Min
+                                           WRITE setMin         )
+    Q_PROPERTY( int        Mean            READ Mean
+                                           WRITE setMean        )
+    Q_PROPERTY( int        Max             READ Max
+                                           WRITE setMax         )
+    Q_PROPERTY( int        P50             READ P50
+                                           WRITE setP50         )
+    Q_PROPERTY( int        P90             READ P90
+                                           WRITE setP90         )
+    Q_PROPERTY( int        P95             READ P95
+                                           WRITE setP95         )
+    Q_PROPERTY( QVariantList Stages        READ Stages          )
+
+    PROPERTYIMP_REF   ( QString     , Event  )
+    PROPERTYIMP       ( int         , Count  )
+    PROPERTYIMP       ( int         , Last   )
+    PROPERTYIMP       ( int         , Min    )
+    PROPERTYIMP       ( int         , Mean   )
+    PROPERTYIMP       ( int         , Max    )
+    PROPERTYIMP       ( int         , P50    )
+    PROPERTYIMP       ( int         , P90    )
+    PROPERTYIMP       ( int         , P95    )
+    PROPERTYIMP_RO_REF( QVariantList, Stages );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE PlaybackTiming(QObject *parent = nullptr)
+            : QObject       ( parent ),
+              m_Event       (        ),
+              m_Count       ( 0      ),
+              m_Last        ( 0      ),
+              m_Min         ( 0      ),
+              m_Mean        ( 0      ),
+              m_Max         ( 0      ),
+              m_P50         ( 0      ),
+              m_P90         ( 0      ),
+              m_P95         ( 0      )
+        {
+        }
+
+        void Copy( const PlaybackTiming *src )
+        {
+            m_Event = src->m_Event ;
+            m_Count = src->m_Count ;
+            m_Last  = src->m_Last  ;
+            m_Min   = src->m_Min   ;
+            m_Mean  = src->m_Mean  ;
+            m_Max   = src->m_Max   ;
+            m_P50   = src->m_P50   ;
+            m_P90   = src->m_P90   ;
+            m_P95   = src->m_P95   ;
+
+            CopyListContents< LabelValue >( this, m_Stages, src->m_Stages );
+        }
+
+        /// Label is the name of the stage, Value the milliseconds since
+        /// the event was requested.
+        LabelValue *AddNewStage()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            auto *pObject = new LabelValue( this );
+            m_Stages.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(PlaybackTiming);
+};
+
+inline void PlaybackTiming::InitializeCustomTypes()
+{
+    qRegisterMetaType< PlaybackTiming* >();
+
+    LabelValue::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: playbackTimingList.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLAYBACKTIMINGLIST_H_
+#define PLAYBACKTIMINGLIST_H_
+
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "playbackTiming.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC PlaybackTimingList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "PlaybackTimings", "type=DTC::PlaybackTiming");
+
+    Q_PROPERTY( QVariantList PlaybackTimings READ PlaybackTimings )
+
+    PROPERTYIMP_RO_REF( QVariantList, PlaybackTimings );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE PlaybackTimingList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const PlaybackTimingList *src )
+        {
+            CopyListContents< PlaybackTiming >( this, m_PlaybackTimings,
+                                                src->m_PlaybackTimings );
+        }
+
+        PlaybackTiming *AddNewPlaybackTiming()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            auto *pObject = new PlaybackTiming( this );
+            m_PlaybackTimings.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(PlaybackTimingList);
+};
+
+inline void PlaybackTimingList::InitializeCustomTypes()
+{
+    qRegisterMetaType< PlaybackTimingList* >();
+
+    PlaybackTiming::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
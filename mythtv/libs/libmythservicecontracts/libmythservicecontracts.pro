@@ -51,6 +51,7 @@ HEADERS += datacontracts/liveStreamInfo.h        datacontracts/liveStreamInfoLis
 HEADERS += datacontracts/titleInfo.h             datacontracts/titleInfoList.h
 HEADERS += datacontracts/labelValue.h
 HEADERS += datacontracts/logMessage.h            datacontracts/logMessageList.h
+HEADERS += datacontracts/playbackTiming.h        datacontracts/playbackTimingList.h
 HEADERS += datacontracts/imageMetadataInfoList.h datacontracts/imageMetadataInfo.h
 HEADERS += datacontracts/imageSyncInfo.h         datacontracts/channelGroup.h
 HEADERS += datacontracts/channelGroupList.h      datacontracts/input.h
@@ -117,6 +118,7 @@ incDatacontracts.files += datacontracts/liveStreamInfo.h      datacontracts/live
 incDatacontracts.files += datacontracts/titleInfo.h           datacontracts/titleInfoList.h
 incDatacontracts.files += datacontracts/labelValue.h
 incDatacontracts.files += datacontracts/logMessage.h          datacontracts/logMessageList.h
+incDatacontracts.files += datacontracts/playbackTiming.h      datacontracts/playbackTimingList.h
 incDatacontracts.files += datacontracts/imageMetadataInfoList.h datacontracts/imageMetadataInfo.h
 incDatacontracts.files += datacontracts/imageSyncInfo.h       datacontracts/channelGroup.h
 incDatacontracts.files += datacontracts/channelGroupList.h    datacontracts/input.h
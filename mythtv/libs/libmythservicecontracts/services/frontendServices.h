@@ -4,11 +4,12 @@
 #include "service.h"
 #include "datacontracts/frontendStatus.h"
 #include "datacontracts/frontendActionList.h"
+#include "datacontracts/playbackTimingList.h"
 
 class SERVICE_PUBLIC FrontendServices : public Service
 {
     Q_OBJECT
-    Q_CLASSINFO( "version", "2.1" );
+    Q_CLASSINFO( "version", "2.2" );
     Q_CLASSINFO( "SendMessage_Method",            "POST" )
     Q_CLASSINFO( "SendNotification_Method",       "POST" )
     Q_CLASSINFO( "SendAction_Method",             "POST" )
@@ -22,6 +23,7 @@ class SERVICE_PUBLIC FrontendServices : public Service
     {
         DTC::FrontendStatus::InitializeCustomTypes();
         DTC::FrontendActionList::InitializeCustomTypes();
+        DTC::PlaybackTimingList::InitializeCustomTypes();
     }
 
   public slots:
@@ -52,6 +54,7 @@ class SERVICE_PUBLIC FrontendServices : public Service
     virtual QStringList          GetContextList(void) = 0;
     virtual DTC::FrontendActionList* GetActionList(const QString &Context) = 0;
     virtual bool                 SendKey(const QString &Key) = 0;
+    virtual DTC::PlaybackTimingList* GetPlaybackTimings(void) = 0;
 
 
 };
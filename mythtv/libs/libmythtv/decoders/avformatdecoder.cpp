@@ -35,6 +35,7 @@ extern "C" {
 #include "mythtvexp.h"
 #include "mythconfig.h"
 #include "avformatdecoder.h"
+#include "mythdemuxer.h"
 #include "audiooutput.h"
 #include "audiooutpututil.h"
 #include "io/mythmediabuffer.h"
@@ -58,6 +59,7 @@ extern "C" {
 #include "Bluray/mythbdbuffer.h"
 #include "mythavutil.h"
 #include "mythhdrvideometadata.h"
+#include "mythplaybacktimings.h"
 
 #include "lcddevice.h"
 
@@ -390,6 +392,8 @@ void AvFormatDecoder::CloseCodecs()
 
 void AvFormatDecoder::CloseContext()
 {
+    StopDemuxer();
+
     if (m_ic)
     {
         CloseCodecs();
@@ -594,14 +598,22 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
 
     int flags = (m_doRewind || exactseeks) ? AVSEEK_FLAG_BACKWARD : 0;
 
+    if (m_demuxer)
+        m_demuxer->Pause();
+
     if (av_seek_frame(m_ic, -1, ts, flags) < 0)
     {
         LOG(VB_GENERAL, LOG_ERR, LOC +
             QString("av_seek_frame(ic, -1, %1, 0) -- error").arg(ts));
+        if (m_demuxer)
+            m_demuxer->Resume();
         m_getRawFrames = oldrawstate;
         return false;
     }
 
+    if (m_demuxer)
+        m_demuxer->Flush();
+
     int normalframes = 0;
 
     if (st && st->cur_dts != AV_NOPTS_VALUE)
@@ -639,7 +651,7 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
         m_fpsSkip = 0;
         m_framesRead = m_lastKey;
 
-        normalframes = (exactseeks) ? desiredFrame - m_framesPlayed : 0;
+        normalframes = (exactseeks && !m_keyframesOnly) ? desiredFrame - m_framesPlayed : 0;
         normalframes = std::max(normalframes, 0);
         m_noDtsHack = false;
     }
@@ -679,6 +691,11 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
 
     DecoderBase::SeekReset(newKey, skipFrames, doflush, discardFrames);
 
+    // Stop reading ahead until the skip below, or the next GetFrame(),
+    // wants a packet
+    if (doflush && m_demuxer)
+        m_demuxer->Pause();
+
     QMutexLocker locker(&m_avCodecLock);
 
     // Discard all the queued up decoded frames
@@ -731,6 +748,12 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
             av_packet_unref(pkt);
             delete pkt;
         }
+        // The input only moves for a seek. After a stream change, keep
+        // what has already been read ahead.
+        if (m_demuxer && m_keepDemuxQueue)
+            m_demuxer->ClearStreamChange();
+        else if (m_demuxer)
+            m_demuxer->Flush();
 
         m_prevGopPos = 0;
         m_gopSet = false;
@@ -747,6 +770,10 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
         }
     }
 
+    // The demux thread needs the lock to read the packets to skip
+    if (m_demuxer)
+        locker.unlock();
+
     // Skip all the desired number of skipFrames
 
     // Some seeks can be very slow.  The most common example comes
@@ -817,6 +844,8 @@ void AvFormatDecoder::SetEof(bool eof)
             QString("Resetting byte context eof (livetv %1 was eof %2)")
                 .arg(m_livetv).arg(m_ic->pb->eof_reached));
         m_ic->pb->eof_reached = 0;
+        if (m_demuxer)
+            m_demuxer->ClearError();
     }
     DecoderBase::SetEof(eof);
 }
@@ -899,7 +928,11 @@ extern "C" void HandleStreamChange(void *data)
         QString("streams_changed 0x%1 -- stream count %2")
             .arg((uint64_t)data,0,16).arg(cnt));
 
-    decoder->m_streamsChanged = true;
+    // Let the decoder finish with the packets read before the change
+    if (decoder->m_demuxer && MythDemuxer::IsDemuxThread())
+        decoder->m_demuxer->StreamsChanged();
+    else
+        decoder->m_streamsChanged = true;
 }
 
 int AvFormatDecoder::FindStreamInfo(void)
@@ -1147,6 +1180,7 @@ int AvFormatDecoder::OpenFile(MythMediaBuffer *Buffer, bool novideo,
                 m_hasFullPositionMap = true;
                 m_gopSet = true;
             }
+            MythPlaybackTimings::Instance().Stage("PositionMapLoaded");
         }
     }
 
@@ -1258,6 +1292,8 @@ int AvFormatDecoder::OpenFile(MythMediaBuffer *Buffer, bool novideo,
         m_processFrames = true;
     }
 
+    StartDemuxer();
+    MythPlaybackTimings::Instance().Stage("FileOpened");
 
     // Return true if recording has position map
     return static_cast<int>(m_recordingHasPositionMap);
@@ -1541,6 +1577,9 @@ void AvFormatDecoder::InitVideoCodec(AVStream *stream, AVCodecContext *enc,
     if (FlagIsSet(kDecodeNoDecode))
         enc->skip_idct = AVDISCARD_ALL;
 
+    if (m_keyframesOnly)
+        enc->skip_frame = AVDISCARD_NONKEY;
+
     if (selectedStream)
     {
         // m_fps is now set 'correctly' in ScanStreams so this additional call
@@ -2545,12 +2584,27 @@ void AvFormatDecoder::UpdateFramesPlayed(void)
 
 bool AvFormatDecoder::DoRewindSeek(long long desiredFrame)
 {
-    return DecoderBase::DoRewindSeek(desiredFrame);
+    if (m_demuxer)
+        m_demuxer->Pause();
+    bool result = DecoderBase::DoRewindSeek(desiredFrame);
+    if (m_demuxer)
+        m_demuxer->Flush();
+    return result;
 }
 
 void AvFormatDecoder::DoFastForwardSeek(long long desiredFrame, bool &needflush)
 {
+    if (m_demuxer)
+        m_demuxer->Pause();
     DecoderBase::DoFastForwardSeek(desiredFrame, needflush);
+    if (m_demuxer)
+    {
+        // Keep what has been read ahead if the buffer was not moved
+        if (needflush)
+            m_demuxer->Flush();
+        else
+            m_demuxer->Resume();
+    }
 }
 
 ///Returns TeleText language
@@ -4802,16 +4856,21 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
     m_allowedQuit = false;
     bool storevideoframes = false;
 
-    AutoSelectTracks();
+    {
+        // The demux thread may be using the format context
+        QMutexLocker locker(m_demuxer ? &m_avCodecLock : nullptr);
 
-    m_skipAudio = (m_lastVPts == 0ms);
+        AutoSelectTracks();
 
-    if( !m_processFrames )
-    {
-        return false;
-    }
+        m_skipAudio = (m_lastVPts == 0ms);
 
-    m_hasVideo = HasVideo(m_ic);
+        if( !m_processFrames )
+        {
+            return false;
+        }
+
+        m_hasVideo = HasVideo(m_ic);
+    }
     m_needDummyVideoFrames = false;
 
     if (!m_hasVideo && (decodetype & kDecodeVideo))
@@ -4904,7 +4963,16 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
             }
 
             int retval = 0;
-            if (!m_ic || ((retval = ReadPacket(m_ic, pkt, storevideoframes)) < 0))
+            bool changed = false;
+            if (m_demuxer)
+            {
+                retval = m_demuxer->Take(pkt, changed);
+                // Handled at the top of the loop once this packet is done
+                if (changed)
+                    m_streamsChanged = true;
+            }
+            if (!m_ic || (retval < 0) ||
+                (!m_demuxer && ((retval = ReadPacket(m_ic, pkt, storevideoframes)) < 0)))
             {
                 if (retval == -EAGAIN)
                     continue;
@@ -4930,6 +4998,10 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
                 pkt->pos -= m_readAdjust;
         }
 
+        // Keep the demux thread out of the format context until this
+        // packet has been handled
+        QMutexLocker demuxlocker(m_demuxer ? &m_avCodecLock : nullptr);
+
         if (!m_ic)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "No context");
@@ -5092,7 +5164,9 @@ void AvFormatDecoder::StreamChangeCheck(void)
 {
     if (m_streamsChanged)
     {
+        m_keepDemuxQueue = true;
         SeekReset(0, 0, true, true);
+        m_keepDemuxQueue = false;
         ScanStreams(false);
         m_streamsChanged = false;
     }
@@ -5106,6 +5180,65 @@ int AvFormatDecoder::ReadPacket(AVFormatContext *ctx, AVPacket *pkt, bool &/*sto
     return result;
 }
 
+/*! \brief Starts reading packets ahead of GetFrame() on a separate thread.
+ *
+ * Only used for local playback of files and finished recordings. DVDs,
+ * Blu-rays and Live TV move the read position behind the decoder's back
+ * and always read synchronously.
+*/
+void AvFormatDecoder::StartDemuxer(void)
+{
+    if (m_demuxer || !m_ic || !m_ringBuffer || m_livetv || m_ringBuffer->IsDisc() ||
+        m_ringBuffer->IsStreamed() || !gCoreContext->GetBoolSetting("DecoderDemuxThread", false))
+    {
+        return;
+    }
+
+    auto read = [this](AVPacket *Packet, std::chrono::milliseconds &Duration)
+    {
+        bool store = false;
+        int result = ReadPacket(m_ic, Packet, store);
+        QMutexLocker locker(&m_avCodecLock);
+        if (result < 0)
+        {
+            // The player stops reads while it changes tracks etc
+            if (m_ringBuffer->GetStopReads() && m_ic->pb)
+            {
+                m_ic->pb->eof_reached = 0;
+                return AVERROR(EAGAIN);
+            }
+            return result;
+        }
+        if (Packet->duration > 0 && Packet->stream_index < static_cast<int>(m_ic->nb_streams))
+        {
+            AVRational timebase = m_ic->streams[Packet->stream_index]->time_base;
+            Duration = millisecondsFromFloat(av_q2d(timebase) * Packet->duration * 1000);
+        }
+        return result;
+    };
+
+    m_avfRingBuffer->SetReadLock(&m_avCodecLock);
+    QMutexLocker locker(&m_demuxerLock);
+    m_demuxer = new MythDemuxer(read);
+    m_demuxer->start();
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + "Started demux thread");
+}
+
+void AvFormatDecoder::StopDemuxer(void)
+{
+    m_demuxerLock.lock();
+    MythDemuxer *demuxer = m_demuxer;
+    m_demuxer = nullptr;
+    m_demuxerLock.unlock();
+    if (!demuxer)
+        return;
+
+    // Deleting stops the thread, which may need the codec lock to finish a read
+    delete demuxer;
+    if (m_avfRingBuffer)
+        m_avfRingBuffer->SetReadLock(nullptr);
+}
+
 bool AvFormatDecoder::HasVideo(const AVFormatContext *ic)
 {
     if (ic && ic->cur_pmt_sect)
@@ -5170,6 +5303,31 @@ QString AvFormatDecoder::GetRawEncodingType(void)
     return ff_codec_id_string(m_ic->streams[stream]->codecpar->codec_id);
 }
 
+/// \brief Stops the video decoder decoding anything but keyframes
+void AvFormatDecoder::SetKeyframesOnly(bool Enable)
+{
+    if (Enable == m_keyframesOnly)
+        return;
+    DecoderBase::SetKeyframesOnly(Enable);
+
+    QMutexLocker locker(&m_avCodecLock);
+    int index = m_selectedTrack[kTrackTypeVideo].m_av_stream_index;
+    if (!m_ic || index < 0 || index >= static_cast<int>(m_ic->nb_streams))
+        return;
+
+    AVCodecContext *context = m_codecMap.FindCodecContext(m_ic->streams[index]);
+    if (context)
+        context->skip_frame = Enable ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("%1 keyframe only decoding")
+        .arg(Enable ? "Enabled" : "Disabled"));
+}
+
+QString AvFormatDecoder::GetDemuxQueueDepth(void)
+{
+    QMutexLocker locker(&m_demuxerLock);
+    return m_demuxer ? m_demuxer->GetQueueDepth() : QString();
+}
+
 void AvFormatDecoder::SetDisablePassThrough(bool disable)
 {
     if (m_selectedTrack[kTrackTypeAudio].m_av_stream_index < 0)
@@ -34,6 +34,7 @@ class SubtitleReader;
 class InteractiveTV;
 class ProgramInfo;
 class MythSqlDatabase;
+class MythDemuxer;
 
 struct SwsContext;
 
@@ -138,6 +139,8 @@ class AvFormatDecoder : public DecoderBase
 
     QString      GetCodecDecoderName(void) const override; // DecoderBase
     QString      GetRawEncodingType(void) override; // DecoderBase
+    QString      GetDemuxQueueDepth(void) override; // DecoderBase
+    void         SetKeyframesOnly(bool Enable) override; // DecoderBase
     MythCodecID  GetVideoCodecID(void) const override { return m_videoCodecId; } // DecoderBase
 
     void SetDisablePassThrough(bool disable) override; // DecoderBase
@@ -256,6 +259,8 @@ class AvFormatDecoder : public DecoderBase
                     AVPacket *pkt);
 
     virtual int ReadPacket(AVFormatContext *ctx, AVPacket *pkt, bool &storePacket);
+    void StartDemuxer(void);
+    void StopDemuxer(void);
 
     bool               m_isDbIgnored;
 
@@ -362,12 +367,18 @@ class AvFormatDecoder : public DecoderBase
     bool               m_processFrames                {true};
 
     bool               m_streamsChanged               { false };
+    /// SeekReset() is for a stream change, not a seek
+    bool               m_keepDemuxQueue               { false };
     bool               m_resetHardwareDecoders        { false };
 
     // Value in milliseconds, from setting AudioReadAhead
     std::chrono::milliseconds  m_audioReadAhead       {100ms};
 
     QMutex             m_avCodecLock                  { QMutex::Recursive };
+
+    /// Reads packets ahead on its own thread, if enabled
+    MythDemuxer       *m_demuxer                      { nullptr };
+    QMutex             m_demuxerLock;
 };
 
 #endif
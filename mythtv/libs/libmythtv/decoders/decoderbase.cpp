@@ -7,6 +7,7 @@
 #include "mythlogging.h"
 #include "decoderbase.h"
 #include "programinfo.h"
+#include "recordingseekindex.h"
 #include "iso639.h"
 #include "DVD/mythdvdbuffer.h"
 #include "Bluray/mythbdbuffer.h"
@@ -97,6 +98,11 @@ bool DecoderBase::PosMapFromDb(void)
     if (!m_playbackInfo)
         return false;
 
+    // Prefer the recorder's seek index, which avoids reading the whole
+    // recordedseek table back from the database.
+    if (PosMapFromSeekIndex())
+        return true;
+
     // Overwrites current positionmap with entire contents of database
     frm_pos_map_t posMap;
     frm_pos_map_t durMap;
@@ -212,6 +218,186 @@ bool DecoderBase::PosMapFromDb(void)
     return true;
 }
 
+/** \brief Fills the position map from the seek index file written
+ *         next to a local recording.
+ *  \return false if there is no usable seek index.
+ */
+bool DecoderBase::PosMapFromSeekIndex(void)
+{
+    if (!m_ringBuffer || m_ringBuffer->IsDisc())
+        return false;
+
+    QMutexLocker locker(&m_positionMapLock);
+    if (m_positionMap.HasIndex())
+    {
+        // Already mapped, only pick up what the recorder has appended,
+        // unless it has started over and there's nothing to map yet
+        bool refreshed = RefreshSeekIndex();
+        if (m_positionMap.HasIndex())
+        {
+            if (refreshed)
+            {
+                LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                    QString("Position map refreshed from seek index to: %1")
+                        .arg(m_positionMap.back().index));
+            }
+            return true;
+        }
+    }
+
+    MarkTypes wanted = (m_keyframeDist != -1) ? m_positionMapType : MARK_UNSET;
+    if (!m_positionMap.AttachIndex(m_ringBuffer->GetFilename(), wanted))
+        return false;
+
+    m_positionMapType = m_positionMap.Index().GetMarkType();
+    if (m_keyframeDist == -1)
+    {
+        if (m_positionMapType == MARK_GOP_BYFRAME)
+            m_keyframeDist = 1;
+        else if (m_positionMapType == MARK_GOP_START)
+            m_keyframeDist = (m_fps < 26 && m_fps > 24) ? 12 : 15;
+    }
+    m_positionMap.SetIndexKeyframeDist(m_keyframeDist);
+    m_frameToDurMap.clear();
+    m_durToFrameMap.clear();
+    if (!m_positionMap.HasIndexDurations())
+        DurMapFromDb();
+
+    m_indexOffset = m_positionMap[0].index;
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Position map mapped from seek index to: %1")
+            .arg(m_positionMap.back().index));
+
+    return true;
+}
+
+/** \brief Opens the seek index of the recording in place of the
+ *         current entries.
+ *  \param type required mark type, or MARK_UNSET to accept any
+ *  \return false, leaving the map untouched, if there is no usable index.
+ */
+bool DecoderBase::PositionMap::AttachIndex(const QString &recording,
+                                           MarkTypes type)
+{
+    if (!m_index.Open(recording) || !m_index.GetEntryCount() ||
+        ((type != MARK_UNSET) && (m_index.GetMarkType() != type)))
+    {
+        m_index.Close();
+        return false;
+    }
+
+    m_entries.clear();
+    m_indexCount = m_index.GetEntryCount();
+    m_indexDurations = m_index.HasDurations();
+    return true;
+}
+
+/** \brief Maps entries appended to the seek index since it was
+ *         attached, dropping the newer entries it now covers.
+ *
+ *  If the recorder has started a new index, the newer entries are
+ *  dropped as well, and the index is detached if it is empty or of
+ *  another type.
+ *  \return true if there are new entries.
+ */
+bool DecoderBase::PositionMap::RefreshIndex(void)
+{
+    uint generation = m_index.GetGeneration();
+    MarkTypes type = m_index.GetMarkType();
+    if (!HasIndex() || !m_index.Refresh())
+        return false;
+
+    m_indexCount = m_index.GetEntryCount();
+    m_indexDurations = m_index.HasDurations();
+
+    if (m_index.GetGeneration() != generation)
+    {
+        m_entries.clear();
+        if (!m_indexCount || m_index.GetMarkType() != type)
+            clear();
+        return true;
+    }
+
+    RecordingSeekIndex::Entry last = m_index.GetEntry(m_indexCount - 1);
+    auto it = std::find_if(m_entries.cbegin(), m_entries.cend(),
+        [&last](const PosMapEntry &e) { return e.index > last.index; });
+    m_entries.erase(m_entries.cbegin(), it);
+    return true;
+}
+
+void DecoderBase::PositionMap::clear(void)
+{
+    m_index.Close();
+    m_indexCount = 0;
+    m_indexDurations = false;
+    m_entries.clear();
+}
+
+/** \brief Picks up what the recorder has appended to the seek index,
+ *         keeping the duration maps in step with it.
+ *
+ *  Must be called with m_positionMapLock held.
+ *  \return true if there are new entries.
+ */
+bool DecoderBase::RefreshSeekIndex(void)
+{
+    bool durations = m_positionMap.HasIndexDurations();
+    uint generation = m_positionMap.Index().GetGeneration();
+    if (!m_positionMap.RefreshIndex())
+        return false;
+
+    // A new index may not agree with what was kept for the old one
+    if (m_positionMap.Index().GetGeneration() != generation)
+    {
+        m_frameToDurMap.clear();
+        m_durToFrameMap.clear();
+        durations = true;
+    }
+
+    // The maps were pruned to what the index covered, so they are needed
+    // in full again once it turns out not to have usable durations.
+    if (durations && !m_positionMap.HasIndexDurations())
+        DurMapFromDb();
+    else
+        PruneDurationMaps();
+    return true;
+}
+
+/// Fills the duration maps from the database, keeping newer entries.
+void DecoderBase::DurMapFromDb(void)
+{
+    if (!m_playbackInfo)
+        return;
+
+    frm_pos_map_t durMap;
+    m_playbackInfo->QueryPositionMap(durMap, MARK_DURATION_MS);
+    for (auto it = durMap.cbegin(); it != durMap.cend(); ++it)
+    {
+        m_frameToDurMap[it.key()] = it.value();
+        m_durToFrameMap[it.value()] = it.key();
+    }
+
+    if (!durMap.empty())
+    {
+        LOG(VB_PLAYBACK, LOG_INFO, LOC +
+            QString("Duration map filled from DB to: %1").arg(durMap.lastKey()));
+    }
+}
+
+/// Drops duration map entries that are now covered by the seek index.
+void DecoderBase::PruneDurationMaps(void)
+{
+    if (!m_positionMap.HasIndexDurations())
+        return;
+
+    long long last = m_positionMap[m_positionMap.IndexedSize() - 1].index;
+    while (!m_frameToDurMap.empty() && m_frameToDurMap.firstKey() <= last)
+        m_frameToDurMap.erase(m_frameToDurMap.begin());
+    while (!m_durToFrameMap.empty() && m_durToFrameMap.first() <= last)
+        m_durToFrameMap.erase(m_durToFrameMap.begin());
+}
+
 /** \fn DecoderBase::PosMapFromEnc(void)
  *  \brief Queries encoder for position map data
  *         that has not been committed to the DB yet.
@@ -228,6 +414,9 @@ bool DecoderBase::PosMapFromEnc(void)
     unsigned long long start = 0;
     {
         QMutexLocker locker(&m_positionMapLock);
+        // Let the seek index catch up first, so only what the recorder
+        // has not written out yet is kept in memory.
+        RefreshSeekIndex();
         if (!m_positionMap.empty())
             start = m_positionMap.back().index + 1;
     }
@@ -513,18 +702,24 @@ uint64_t DecoderBase::SavePositionMapDelta(long long first, long long last)
 
     ctm.start();
     frm_pos_map_t posMap;
-    for (auto & entry : m_positionMap)
+    frm_pos_map_t durMap;
+    size_t i = 0;
+    if (m_positionMap.HasIndex())
+        i = std::max(m_positionMap.Index().FindByIndex(first), INT64_C(0));
+    for (; i < m_positionMap.size(); ++i)
     {
+        PosMapEntry entry = m_positionMap[i];
         if (entry.index < first)
             continue;
         if (entry.index > last)
             break;
 
         posMap[entry.index] = entry.pos;
+        if (m_positionMap.HasIndexDurations() && i < m_positionMap.IndexedSize())
+            durMap[entry.index] = m_positionMap.Index().GetEntry(i).duration;
         saved++;
     }
 
-    frm_pos_map_t durMap;
     for (auto it = m_frameToDurMap.cbegin(); it != m_frameToDurMap.cend(); ++it)
     {
         if (it.key() < first)
@@ -570,7 +765,7 @@ bool DecoderBase::DoRewind(long long desiredFrame, bool discardFrames)
     // And flush pre-seek frame if we are allowed to and need to..
     int normalframes = (uint64_t)(desiredFrame - (m_framesPlayed - 1)) > m_seekSnap
         ? desiredFrame - m_framesPlayed : 0;
-    normalframes = std::max(normalframes, 0);
+    normalframes = m_keyframesOnly ? 0 : std::max(normalframes, 0);
     SeekReset(m_lastKey, normalframes, true, discardFrames);
 
     if (discardFrames || (m_ringBuffer && m_ringBuffer->IsDisc()))
@@ -799,9 +994,10 @@ bool DecoderBase::DoFastForward(long long desiredFrame, bool discardFrames)
 
     // Do any Extra frame-by-frame seeking for exactseeks mode
     // And flush pre-seek frame if we are allowed to and need to..
+    // When only decoding keyframes the next frame decoded is the keyframe
     int normalframes = (uint64_t)(desiredFrame - (m_framesPlayed - 1)) > m_seekSnap
         ? desiredFrame - m_framesPlayed : 0;
-    normalframes = std::max(normalframes, 0);
+    normalframes = m_keyframesOnly ? 0 : std::max(normalframes, 0);
     SeekReset(m_lastKey, normalframes, needflush, discardFrames);
 
     if (discardFrames || m_transcoding)
@@ -1318,20 +1514,21 @@ std::chrono::milliseconds DecoderBase::TranslatePositionFrameToMs(long long posi
     // almost always appear to be past the end of the duration map, so
     // we limit duration map syncing to once every 3 seconds (a
     // somewhat arbitrary value).
+    long long last_frame = -1;
     if (!m_frameToDurMap.empty())
+        last_frame = m_frameToDurMap.lastKey();
+    else if (m_positionMap.HasIndexDurations())
+        last_frame = m_positionMap[m_positionMap.IndexedSize() - 1].index;
+    if (last_frame >= 0 && position > last_frame)
     {
-        frm_pos_map_t::const_iterator it = m_frameToDurMap.cend();
-        --it;
-        if (position > it.key())
-        {
-            if (!m_lastPositionMapUpdate.isValid() ||
-                (QDateTime::currentDateTime() >
-                 m_lastPositionMapUpdate.addSecs(3)))
-                SyncPositionMap();
-        }
+        if (!m_lastPositionMapUpdate.isValid() ||
+            (QDateTime::currentDateTime() >
+             m_lastPositionMapUpdate.addSecs(3)))
+            SyncPositionMap();
     }
-    return std::chrono::milliseconds(TranslatePositionAbsToRel(cutlist, position, m_frameToDurMap,
-                                     1000 / fallback_framerate));
+    float ratio = 1000 / fallback_framerate;
+    return std::chrono::milliseconds(TranslatePositionAbsToRel(cutlist, position,
+        [&](long long key) { return TranslateDuration(m_frameToDurMap, key, true, ratio); }));
 }
 
 // Convert from a cutlist-adjusted position in milliseconds to its
@@ -1343,11 +1540,62 @@ uint64_t DecoderBase::TranslatePositionMsToFrame(std::chrono::milliseconds dur_m
     QMutexLocker locker(&m_positionMapLock);
     // Convert relative position in milliseconds (cutlist-adjusted) to
     // its absolute position in milliseconds (not cutlist-adjusted).
-    uint64_t ms = TranslatePositionRelToAbs(cutlist, dur_ms.count(), m_frameToDurMap,
-                                            1000 / fallback_framerate);
+    float ratio = 1000 / fallback_framerate;
+    uint64_t ms = TranslatePositionRelToAbs(cutlist, dur_ms.count(),
+        [&](long long key) { return TranslateDuration(m_frameToDurMap, key, true, ratio); });
     // Convert absolute position in milliseconds to its absolute frame
     // number.
-    return TranslatePosition(m_durToFrameMap, ms, fallback_framerate / 1000);
+    return TranslateDuration(m_durToFrameMap, ms, false, fallback_framerate / 1000);
+}
+
+/** \brief Maps a frame number to milliseconds, or milliseconds to a
+ *         frame number, using the seek index for the part of the
+ *         recording it covers and map for anything newer.
+ */
+uint64_t DecoderBase::TranslateDuration(const frm_pos_map_t &map, long long key,
+                                        bool from_frame, float fallback_ratio) const
+{
+    if (!m_positionMap.HasIndexDurations() ||
+        (!map.empty() && key >= map.firstKey()))
+        return TranslatePosition(map, key, fallback_ratio);
+
+    const RecordingSeekIndex &index = m_positionMap.Index();
+    int64_t num = from_frame ? index.FindByIndex(key) : index.FindByDuration(key);
+
+    long long key1 = 0;
+    long long val1 = 0;
+    if (num >= 0)
+    {
+        RecordingSeekIndex::Entry e = index.GetEntry(num);
+        key1 = from_frame ? e.index : e.duration;
+        val1 = from_frame ? e.duration : e.index;
+        if (key1 == key)
+            return val1;
+    }
+
+    long long key2 = 0;
+    long long val2 = 0;
+    if (num + 1 < static_cast<int64_t>(m_positionMap.IndexedSize()))
+    {
+        RecordingSeekIndex::Entry e = index.GetEntry(num + 1);
+        key2 = from_frame ? e.index : e.duration;
+        val2 = from_frame ? e.duration : e.index;
+    }
+    else if (!map.empty())
+    {
+        key2 = map.firstKey();
+        val2 = map.first();
+    }
+    else
+    {
+        return llroundf(val1 + fallback_ratio * (key - key1));
+    }
+
+    // neighbouring entries may share a duration
+    if (key2 == key1)
+        return val1;
+
+    return llround(val1 + (double) (key - key1) * (val2 - val1) / (key2 - key1));
 }
 
 // Convert from an "absolute" (not cutlist-adjusted) value to its
@@ -1364,6 +1612,15 @@ DecoderBase::TranslatePositionAbsToRel(const frm_dir_map_t &deleteMap,
                                        uint64_t absPosition, // frames
                                        const frm_pos_map_t &map, // frame->ms
                                        float fallback_ratio)
+{
+    return TranslatePositionAbsToRel(deleteMap, absPosition,
+        [&](long long key) { return TranslatePosition(map, key, fallback_ratio); });
+}
+
+uint64_t
+DecoderBase::TranslatePositionAbsToRel(const frm_dir_map_t &deleteMap,
+                                       uint64_t absPosition,
+                                       const PosTranslator &translate)
 {
     uint64_t subtraction = 0;
     uint64_t startOfCutRegion = 0;
@@ -1377,7 +1634,7 @@ DecoderBase::TranslatePositionAbsToRel(const frm_dir_map_t &deleteMap,
         first = false;
         if (i.key() > absPosition)
             break;
-        uint64_t mappedKey = TranslatePosition(map, i.key(), fallback_ratio);
+        uint64_t mappedKey = translate(i.key());
         if (i.value() == MARK_CUT_START && !withinCut)
         {
             withinCut = true;
@@ -1389,7 +1646,7 @@ DecoderBase::TranslatePositionAbsToRel(const frm_dir_map_t &deleteMap,
             subtraction += (mappedKey - startOfCutRegion);
         }
     }
-    uint64_t mappedPos = TranslatePosition(map, absPosition, fallback_ratio);
+    uint64_t mappedPos = translate(absPosition);
     if (withinCut)
         subtraction += (mappedPos - startOfCutRegion);
     return mappedPos - subtraction;
@@ -1413,6 +1670,15 @@ DecoderBase::TranslatePositionRelToAbs(const frm_dir_map_t &deleteMap,
                                        uint64_t relPosition, // ms
                                        const frm_pos_map_t &map, // frame->ms
                                        float fallback_ratio)
+{
+    return TranslatePositionRelToAbs(deleteMap, relPosition,
+        [&](long long key) { return TranslatePosition(map, key, fallback_ratio); });
+}
+
+uint64_t
+DecoderBase::TranslatePositionRelToAbs(const frm_dir_map_t &deleteMap,
+                                       uint64_t relPosition,
+                                       const PosTranslator &translate)
 {
     uint64_t addition = 0;
     uint64_t startOfCutRegion = 0;
@@ -1424,7 +1690,7 @@ DecoderBase::TranslatePositionRelToAbs(const frm_dir_map_t &deleteMap,
         if (first)
             withinCut = (i.value() == MARK_CUT_END);
         first = false;
-        uint64_t mappedKey = TranslatePosition(map, i.key(), fallback_ratio);
+        uint64_t mappedKey = translate(i.key());
         if (i.value() == MARK_CUT_START && !withinCut)
         {
             withinCut = true;
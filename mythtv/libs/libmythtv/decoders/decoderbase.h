@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "io/mythmediabuffer.h"
@@ -10,6 +11,7 @@
 #include "mythcontext.h"
 #include "mythdbcon.h"
 #include "programinfo.h"
+#include "recordingseekindex.h"
 #include "mythcodecid.h"
 #include "mythavutil.h"
 #include "mythvideoprofile.h"
@@ -136,6 +138,10 @@ class DecoderBase
 
     void SetSeekSnap(uint64_t snap)  { m_seekSnap = snap; }
     uint64_t GetSeekSnap(void) const { return m_seekSnap;  }
+    /// Decode only keyframes and land exactly on them when seeking,
+    /// for fast forward and rewind.
+    virtual void SetKeyframesOnly(bool Enable) { m_keyframesOnly = Enable; }
+    bool GetKeyframesOnly(void) const { return m_keyframesOnly; }
     void SetLiveTVMode(bool live)  { m_livetv = live;      }
 
     // Must be done while player is paused.
@@ -206,12 +212,14 @@ class DecoderBase
 
     virtual QString GetCodecDecoderName(void) const = 0;
     virtual QString GetRawEncodingType(void) { return QString(); }
+    virtual QString GetDemuxQueueDepth(void) { return QString(); }
     virtual MythCodecID GetVideoCodecID(void) const = 0;
 
     virtual void ResetPosMap(void);
     virtual bool SyncPositionMap(void);
     virtual bool PosMapFromDb(void);
     virtual bool PosMapFromEnc(void);
+    bool PosMapFromSeekIndex(void);
 
     virtual bool FindPosition(long long desired_value, bool search_adjusted,
                               int &lower_bound, int &upper_bound);
@@ -271,6 +279,19 @@ class DecoderBase
     virtual bool DoRewindSeek(long long desiredFrame);
     virtual void DoFastForwardSeek(long long desiredFrame, bool &needflush);
 
+    using PosTranslator = std::function<uint64_t(long long)>;
+    static uint64_t TranslatePositionAbsToRel(const frm_dir_map_t &deleteMap,
+                                              uint64_t absPosition,
+                                              const PosTranslator &translate);
+    static uint64_t TranslatePositionRelToAbs(const frm_dir_map_t &deleteMap,
+                                              uint64_t relPosition,
+                                              const PosTranslator &translate);
+    uint64_t TranslateDuration(const frm_pos_map_t &map, long long key,
+                               bool from_frame, float fallback_ratio) const;
+    bool RefreshSeekIndex(void);
+    void DurMapFromDb(void);
+    void PruneDurationMaps(void);
+
     long long ConditionallyUpdatePosMap(long long desiredFrame);
     long long GetLastFrameInPosMap(void) const;
     unsigned long GetPositionMapSize(void) const;
@@ -283,6 +304,49 @@ class DecoderBase
     };
     long long GetKey(const PosMapEntry &entry) const;
 
+    /** \brief Keyframe position map, optionally backed by the memory
+     *         mapped seek index of a local recording.
+     *
+     *  Entries covered by the seek index are built from the mapping as
+     *  they are looked up, so only the pages around the positions the
+     *  player actually seeks to are read, however long the recording.
+     *  Newer entries, from the encoder or found while demuxing, are
+     *  kept in a vector until the index catches up with them.
+     */
+    class PositionMap
+    {
+      public:
+        bool AttachIndex(const QString &recording, MarkTypes type);
+        bool RefreshIndex(void);
+        void SetIndexKeyframeDist(long long dist) { m_keyframeDist = dist; }
+        bool HasIndex(void) const { return m_indexCount > 0; }
+        bool HasIndexDurations(void) const { return m_indexDurations; }
+        const RecordingSeekIndex &Index(void) const { return m_index; }
+        size_t IndexedSize(void) const { return m_indexCount; }
+
+        size_t size(void) const { return m_indexCount + m_entries.size(); }
+        bool   empty(void) const { return size() == 0; }
+        PosMapEntry operator[](size_t num) const
+        {
+            if (num >= m_indexCount)
+                return m_entries[num - m_indexCount];
+            RecordingSeekIndex::Entry e = m_index.GetEntry(num);
+            return {e.index, e.index * m_keyframeDist, e.offset};
+        }
+        PosMapEntry back(void) const { return (*this)[size() - 1]; }
+        void   push_back(const PosMapEntry &entry) { m_entries.push_back(entry); }
+        void   reserve(size_t count)
+            { m_entries.reserve(count > m_indexCount ? count - m_indexCount : 0); }
+        void   clear(void);
+
+      private:
+        RecordingSeekIndex       m_index;
+        size_t                   m_indexCount     {0};
+        bool                     m_indexDurations {false};
+        long long                m_keyframeDist   {1};
+        std::vector<PosMapEntry> m_entries;
+    };
+
     MythPlayer          *m_parent                  {nullptr};
     ProgramInfo         *m_playbackInfo            {nullptr};
     AudioPlayer         *m_audio                   {nullptr};
@@ -322,12 +386,13 @@ class DecoderBase
     MarkTypes            m_positionMapType         {MARK_UNSET};
 
     mutable QMutex       m_positionMapLock         {QMutex::Recursive};
-    std::vector<PosMapEntry>  m_positionMap;
+    PositionMap          m_positionMap; // guarded by m_positionMapLock
     frm_pos_map_t        m_frameToDurMap; // guarded by m_positionMapLock
     frm_pos_map_t        m_durToFrameMap; // guarded by m_positionMapLock
     mutable QDateTime    m_lastPositionMapUpdate; // guarded by m_positionMapLock
 
     uint64_t             m_seekSnap                {UINT64_MAX};
+    bool                 m_keyframesOnly           {false};
     bool                 m_dontSyncPositionMap     {false};
     bool                 m_livetv                  {false};
     bool                 m_watchingRecording       {false};
@@ -0,0 +1,271 @@
+// Std
+#include <algorithm>
+#include <utility>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythdemuxer.h"
+
+#define LOC QString("Demuxer: ")
+
+static thread_local bool s_demuxThread = false;
+
+MythDemuxer::MythDemuxer(ReadCallback Read, size_t MaxBytes,
+                         std::chrono::milliseconds MaxDuration)
+  : MThread("Demux"),
+    m_read(std::move(Read)),
+    m_maxBytes(MaxBytes),
+    m_maxDuration(MaxDuration)
+{
+}
+
+MythDemuxer::~MythDemuxer()
+{
+    Stop();
+}
+
+/// \brief Returns true when called from within the read callback.
+bool MythDemuxer::IsDemuxThread(void)
+{
+    return s_demuxThread;
+}
+
+/*! \brief Stops the demux thread and frees any queued packets.
+ *
+ * The caller must not hold any lock the read callback takes.
+*/
+void MythDemuxer::Stop(void)
+{
+    m_lock.lock();
+    m_stop = true;
+    m_wait.wakeAll();
+    m_lock.unlock();
+    wait();
+
+    QMutexLocker locker(&m_lock);
+    while (!m_queue.empty())
+        Pop();
+}
+
+/*! \brief Stops reading and waits for any read in progress to complete.
+ *
+ * The caller must not hold any lock the read callback takes.
+*/
+void MythDemuxer::Pause(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_paused = true;
+    while (m_reading)
+        m_wait.wait(&m_lock);
+}
+
+void MythDemuxer::Resume(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_paused = false;
+    m_wait.wakeAll();
+}
+
+/// \brief Discards all queued packets and any pending error or stream change.
+void MythDemuxer::Flush(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_queue.empty())
+    {
+        LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Flushing %1 packets")
+            .arg(m_queue.size()));
+    }
+    while (!m_queue.empty())
+        Pop();
+    m_generation++;
+    m_error   = 0;
+    m_barrier = false;
+    m_wait.wakeAll();
+}
+
+/// \brief Flags the packet currently being read as the first after a stream change.
+void MythDemuxer::StreamsChanged(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_changePending = true;
+}
+
+/*! \brief Resumes reading after a stream change, keeping the queued packets.
+ *
+ * Reading stays stopped while a packet flagged with a stream change is
+ * still queued.
+*/
+void MythDemuxer::ClearStreamChange(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_barrier = std::any_of(m_queue.cbegin(), m_queue.cend(),
+                            [](const Entry &E) { return E.m_streamsChanged; });
+    m_wait.wakeAll();
+}
+
+/// \brief Retries reading after an error, e.g. when a recording has grown.
+void MythDemuxer::ClearError(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_error = 0;
+    m_wait.wakeAll();
+}
+
+/*! \brief Moves the next queued packet into Packet, waiting for one if needed.
+ *
+ * This also resumes reading if the demuxer was paused.
+ * \param StreamsChanged Set if the streams changed while this packet was read.
+ * \return 0 on success, AVERROR(EAGAIN) if there is no packet but the caller
+ * should retry, or the error that stopped reading once the queue is empty.
+*/
+int MythDemuxer::Take(AVPacket *Packet, bool &StreamsChanged)
+{
+    QMutexLocker locker(&m_lock);
+    StreamsChanged = false;
+    if (m_paused)
+    {
+        m_paused = false;
+        m_wait.wakeAll();
+    }
+
+    while (m_queue.empty() && !m_error && !m_stop && !m_barrier)
+        m_wait.wait(&m_lock);
+
+    if (m_queue.empty())
+    {
+        if (m_error)
+            return m_error;
+        return m_stop ? AVERROR_EOF : AVERROR(EAGAIN);
+    }
+
+    Entry &entry = m_queue.front();
+    StreamsChanged = entry.m_streamsChanged;
+    if (!entry.m_packet)
+    {
+        Pop();
+        return AVERROR(EAGAIN);
+    }
+
+    av_packet_unref(Packet);
+    av_packet_move_ref(Packet, entry.m_packet);
+    Pop();
+    m_wait.wakeAll();
+    return 0;
+}
+
+void MythDemuxer::GetQueueDepth(size_t &Packets, size_t &Bytes,
+                                std::chrono::milliseconds &Duration)
+{
+    QMutexLocker locker(&m_lock);
+    Packets  = m_queue.size();
+    Bytes    = m_bytes;
+    Duration = this->Duration();
+}
+
+/// \brief Returns the queue depth for the playback OSD.
+QString MythDemuxer::GetQueueDepth(void)
+{
+    size_t packets = 0;
+    size_t bytes = 0;
+    std::chrono::milliseconds duration = 0ms;
+    GetQueueDepth(packets, bytes, duration);
+    return QString("%1 pkts %2 KB %3 ms").arg(packets).arg(bytes >> 10)
+        .arg(duration.count());
+}
+
+bool MythDemuxer::IsFull(void) const
+{
+    return (m_bytes >= m_maxBytes) || (Duration() >= m_maxDuration);
+}
+
+/// \brief Returns the queued duration of the stream with the most queued.
+std::chrono::milliseconds MythDemuxer::Duration(void) const
+{
+    std::chrono::milliseconds result = 0ms;
+    for (const auto & duration : m_durations)
+        result = std::max(result, duration.second);
+    return result;
+}
+
+void MythDemuxer::Pop(void)
+{
+    Entry &entry = m_queue.front();
+    if (entry.m_packet)
+    {
+        m_bytes -= std::min(m_bytes, static_cast<size_t>(entry.m_packet->size));
+        auto it = m_durations.find(entry.m_packet->stream_index);
+        if (it != m_durations.end())
+        {
+            it->second -= entry.m_duration;
+            if (it->second <= 0ms)
+                m_durations.erase(it);
+        }
+        av_packet_free(&entry.m_packet);
+    }
+    m_queue.pop_front();
+}
+
+void MythDemuxer::run(void)
+{
+    RunProlog();
+    s_demuxThread = true;
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Starting (max %1 KB, %2 ms)")
+        .arg(m_maxBytes >> 10).arg(m_maxDuration.count()));
+
+    QMutexLocker locker(&m_lock);
+    while (!m_stop)
+    {
+        if (m_paused || m_barrier || m_error || IsFull())
+        {
+            m_wait.wait(&m_lock);
+            continue;
+        }
+
+        m_reading = true;
+        uint generation = m_generation;
+        locker.unlock();
+
+        AVPacket *packet = av_packet_alloc();
+        std::chrono::milliseconds duration = 0ms;
+        int result = m_read(packet, duration);
+
+        locker.relock();
+        m_reading = false;
+        m_wait.wakeAll();
+
+        bool changed = m_changePending;
+        m_changePending = false;
+
+        // Nothing read before a flush is wanted, but a stream change is
+        if (result < 0 || generation != m_generation)
+        {
+            av_packet_free(&packet);
+            if (result < 0 && result != AVERROR(EAGAIN) && generation == m_generation)
+            {
+                LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Read failed (%1), %2 packets queued")
+                    .arg(result).arg(m_queue.size()));
+                m_error = result;
+            }
+        }
+
+        if (packet || changed)
+        {
+            Entry entry { packet, duration, changed };
+            if (packet)
+            {
+                m_bytes += static_cast<size_t>(std::max(packet->size, 0));
+                m_durations[packet->stream_index] += duration;
+            }
+            m_queue.push_back(entry);
+            m_barrier |= changed;
+        }
+
+        if (result == AVERROR(EAGAIN) && !m_stop)
+            m_wait.wait(&m_lock, 10);
+    }
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + "Exiting");
+    s_demuxThread = false;
+    locker.unlock();
+    RunEpilog();
+}
@@ -0,0 +1,99 @@
+#ifndef MYTHDEMUXER_H
+#define MYTHDEMUXER_H
+
+// Qt
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+// Std
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+
+// MythTV
+#include "mthread.h"
+#include "mythtvexp.h"
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+}
+
+using namespace std::chrono_literals;
+
+/*! \class MythDemuxer
+ *  \brief Reads packets ahead of the decoder on a thread of its own.
+ *
+ *  Packets are queued until either the total packet size or the queued
+ *  duration of any one stream reaches its limit. The read callback is
+ *  only ever called from the demux thread.
+ *
+ *  Pause() stops reading until the next call to Resume() or Take(), so
+ *  that the owner can seek the input. Flush() then discards everything
+ *  read before the seek. A packet read when the streams changed is
+ *  flagged to the consumer and no more packets are read until the
+ *  queue is flushed, or until ClearStreamChange() is called once the
+ *  consumer has handled the change without moving the input.
+*/
+class MTV_PUBLIC MythDemuxer : public MThread
+{
+  public:
+    using ReadCallback = std::function<int(AVPacket*,std::chrono::milliseconds&)>;
+
+    static constexpr size_t kMaxBytes { 8 * 1024 * 1024 };
+    static constexpr std::chrono::milliseconds kMaxDuration { 2s };
+
+    explicit MythDemuxer(ReadCallback Read, size_t MaxBytes = kMaxBytes,
+                         std::chrono::milliseconds MaxDuration = kMaxDuration);
+    ~MythDemuxer() override;
+
+    static bool IsDemuxThread(void);
+
+    void    Stop           (void);
+    void    Pause          (void);
+    void    Resume         (void);
+    void    Flush          (void);
+    void    StreamsChanged (void);
+    void    ClearStreamChange(void);
+    void    ClearError     (void);
+    int     Take           (AVPacket *Packet, bool &StreamsChanged);
+    void    GetQueueDepth  (size_t &Packets, size_t &Bytes, std::chrono::milliseconds &Duration);
+    QString GetQueueDepth  (void);
+
+  protected:
+    void run() override;
+
+  private:
+    Q_DISABLE_COPY(MythDemuxer)
+
+    struct Entry
+    {
+        AVPacket *m_packet         { nullptr };
+        std::chrono::milliseconds m_duration { 0ms };
+        bool      m_streamsChanged { false   };
+    };
+
+    bool IsFull(void) const;
+    std::chrono::milliseconds Duration(void) const;
+    void Pop(void);
+
+    ReadCallback       m_read;
+    size_t             m_maxBytes       { kMaxBytes };
+    std::chrono::milliseconds m_maxDuration { kMaxDuration };
+
+    QMutex             m_lock;
+    QWaitCondition     m_wait;
+    std::deque<Entry>  m_queue;
+    std::map<int,std::chrono::milliseconds> m_durations;
+    size_t             m_bytes          { 0 };
+    int                m_error          { 0 };
+    uint               m_generation     { 0 };
+    bool               m_stop           { false };
+    bool               m_paused         { false };
+    bool               m_reading        { false };
+    bool               m_changePending  { false };
+    bool               m_barrier        { false };
+};
+
+#endif
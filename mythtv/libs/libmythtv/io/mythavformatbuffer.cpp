@@ -1,5 +1,6 @@
 // MythTV
 #include "io/mythavformatbuffer.h"
+#include "decoders/mythdemuxer.h"
 #include "mythcorecontext.h"
 
 URLProtocol MythAVFormatBuffer::s_avfrURL;
@@ -31,7 +32,13 @@ int MythAVFormatBuffer::Read(URLContext *Context, uint8_t *Buffer, int Size)
     if (!avfr)
         return 0;
 
+    // Let the decoder use the format context while the demux thread waits for data
+    bool unlock = avfr->m_readLock && MythDemuxer::IsDemuxThread();
+    if (unlock)
+        avfr->m_readLock->unlock();
     int ret = avfr->GetBuffer()->Read(Buffer, Size);
+    if (unlock)
+        avfr->m_readLock->lock();
 
     if (ret == 0)
         ret = AVERROR_EOF;
@@ -121,3 +128,12 @@ bool MythAVFormatBuffer::IsInInit(void) const
 {
     return m_initState;
 }
+
+/*! \brief Sets a lock to release while the demux thread waits for data.
+ *
+ * The lock must be held exactly once by the demux thread whenever it reads.
+*/
+void MythAVFormatBuffer::SetReadLock(QMutex *Lock)
+{
+    m_readLock = Lock;
+}
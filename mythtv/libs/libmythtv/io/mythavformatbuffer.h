@@ -1,6 +1,9 @@
 #ifndef AVFRINGBUFFER_H
 #define AVFRINGBUFFER_H
 
+// Qt
+#include <QMutex>
+
 // MythTV
 #include "io/mythmediabuffer.h"
 
@@ -27,10 +30,12 @@ class MythAVFormatBuffer
     static int          Close          (URLContext* /*Context*/);
     void                SetInInit      (bool State);
     bool                IsInInit       (void) const;
+    void                SetReadLock    (QMutex *Lock);
 
   private:
     MythMediaBuffer    *m_buffer       { nullptr };
     bool                m_initState    { true    };
+    QMutex             *m_readLock     { nullptr };
     static URLProtocol  s_avfrURL;
 };
 #endif
@@ -16,11 +16,23 @@
 // Std
 #include <cstdlib>
 #include <cerrno>
+#include <cstring>
 #include <sys/types.h>
 #include <sys/time.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#if HAVE_MMAP
+#include <csetjmp>
+#include <csignal>
+#include <mutex>
+#include <sys/mman.h>
+#endif
+#if !( CONFIG_DARWIN || CONFIG_CYGWIN || defined(__FreeBSD__) || defined(_WIN32))
+#define USE_SENDFILE
+#include <poll.h>
+#include <sys/sendfile.h>
+#endif
 
 #if HAVE_POSIX_FADVISE < 1
 static int posix_fadvise(int, off_t, off_t, int) { return 0; }
@@ -46,6 +58,68 @@ static int posix_fadvise(int, off_t, off_t, int) { return 0; }
 static const QStringList kSubExt        {".ass", ".srt", ".ssa", ".sub", ".txt"};
 static const QStringList kSubExtNoCheck {".ass", ".srt", ".ssa", ".sub", ".txt", ".gif", ".png"};
 
+#if HAVE_MMAP
+// Reading a mapped page that is gone, because the file was truncated or a
+// network filesystem failed, raises SIGBUS where read() would return an
+// error. The signal is only caught while copying out of the mapping, and
+// only on the thread doing the copy. Any other SIGBUS goes on to whatever
+// handled it before.
+static thread_local sigjmp_buf *s_mapJump = nullptr;
+static struct sigaction s_oldBusAction {};
+
+static void MapBusHandler(int Signal, siginfo_t *Info, void *Context)
+{
+    if (s_mapJump)
+        siglongjmp(*s_mapJump, 1);
+
+    // Not from a mapped read, pass it on to the previous handler
+    if (s_oldBusAction.sa_flags & SA_SIGINFO)
+    {
+        s_oldBusAction.sa_sigaction(Signal, Info, Context);
+    }
+    else if (s_oldBusAction.sa_handler == SIG_DFL)
+    {
+        // Die as if we had never been installed, stay installed otherwise
+        struct sigaction ours {};
+        sigaction(SIGBUS, &s_oldBusAction, &ours);
+        sigset_t bus;
+        sigemptyset(&bus);
+        sigaddset(&bus, SIGBUS);
+        pthread_sigmask(SIG_UNBLOCK, &bus, nullptr);
+        raise(SIGBUS);
+        sigaction(SIGBUS, &ours, nullptr);
+    }
+    else if (s_oldBusAction.sa_handler != SIG_IGN)
+    {
+        s_oldBusAction.sa_handler(Signal);
+    }
+}
+
+static bool CopyFromMap(void *Dest, const void *Source, size_t Size)
+{
+    static std::once_flag s_installed;
+    std::call_once(s_installed, []()
+    {
+        struct sigaction action {};
+        action.sa_sigaction = MapBusHandler;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGBUS, &action, &s_oldBusAction);
+    });
+
+    sigjmp_buf jump;
+    if (sigsetjmp(jump, 1) != 0)
+    {
+        s_mapJump = nullptr;
+        return false;
+    }
+    s_mapJump = &jump;
+    memcpy(Dest, Source, Size);
+    s_mapJump = nullptr;
+    return true;
+}
+#endif
+
 
 MythFileBuffer::MythFileBuffer(const QString &Filename, bool Write, bool UseReadAhead, std::chrono::milliseconds Timeout)
   : MythMediaBuffer(kMythBufferFile)
@@ -100,6 +174,8 @@ MythFileBuffer::~MythFileBuffer()
     delete m_tfw;
     m_tfw = nullptr;
 
+    UnmapWindow();
+
     if (m_fd2 >= 0)
     {
         close(m_fd2);
@@ -187,6 +263,10 @@ bool MythFileBuffer::OpenFile(const QString &Filename, std::chrono::milliseconds
         m_remotefile = nullptr;
     }
 
+    UnmapWindow();
+    m_mapReadPos = 0;
+    m_mapAdvised = 0;
+
     if (m_fd2 >= 0)
     {
         close(m_fd2);
@@ -278,6 +358,17 @@ bool MythFileBuffer::OpenFile(const QString &Filename, std::chrono::milliseconds
                 QString extension = file.completeSuffix().toLower();
                 if (IsSubtitlePossible(extension))
                     m_subtitleFilename = LocalSubtitleFilename(file);
+#if HAVE_MMAP
+                // Serve reads straight from the page cache instead of
+                // copying through the read ahead buffer. Only decided
+                // on the first open, the read ahead thread can't be
+                // stopped or started underneath the player.
+                if (!m_readAheadRunning && file.isFile())
+                {
+                    m_memoryMapped = m_memoryMapped ||
+                        gCoreContext->GetBoolSetting("FileBufferMemoryMap", false);
+                }
+#endif
                 break;
             }
             case 1:
@@ -395,10 +486,101 @@ bool MythFileBuffer::IsOpen(void) const
     return ret;
 }
 
+/// \return true if SendDirect() can use sendfile() on this file
+bool MythFileBuffer::CanSendDirect(void) const
+{
+#ifdef USE_SENDFILE
+    m_rwLock.lockForRead();
+    bool ret = (m_fd2 >= 0) && !m_remotefile && !m_memoryMapped;
+    m_rwLock.unlock();
+    return ret;
+#else
+    return false;
+#endif
+}
+
+/** \brief Sends file data from Position in the page cache straight to a
+ *         socket.
+ *
+ *  Like SafeRead(int, ...) this stops at the current end of the file,
+ *  leaving it to the caller to come back once a recording in progress
+ *  has grown. Sockets are non-blocking, so wait for the socket to drain
+ *  whenever its send buffer is full.
+ *
+ *  The file offset is left alone, so this may run without m_rwLock.
+ */
+int MythFileBuffer::SafeSend(int Socket, long long Position, uint Size)
+{
+#ifdef USE_SENDFILE
+    uint tot = 0;
+    uint errcnt = 0;
+    MythTimer timer;
+    timer.start();
+    off64_t pos = Position;
+
+    while (tot < Size && !m_stopReads)
+    {
+        struct stat sb {};
+        if (fstat(m_fd2, &sb) != 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "File I/O problem in 'safe_send()'" + ENO);
+            errcnt++;
+            break;
+        }
+        if (S_ISREG(sb.st_mode) && pos >= sb.st_size)
+            break;
+
+        size_t tosend = Size - tot;
+        if (S_ISREG(sb.st_mode))
+            tosend = static_cast<size_t>(std::min(sb.st_size - pos, static_cast<off64_t>(tosend)));
+
+        ssize_t ret = sendfile(Socket, m_fd2, &pos, tosend);
+        if (ret > 0)
+        {
+            tot += static_cast<uint>(ret);
+            timer.restart();
+            continue;
+        }
+        if (ret == 0)
+            break;
+
+        int err = errno;
+        if ((err == EAGAIN || err == EINTR) && timer.elapsed() < 10s)
+        {
+            pollfd pfd { Socket, POLLOUT, 0 };
+            poll(&pfd, 1, 100);
+            continue;
+        }
+
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Socket I/O problem in 'safe_send()'" + ENO);
+        m_numFailures++;
+        if (++errcnt == 3 || err == EPIPE || err == EAGAIN)
+            break;
+    }
+
+    return (tot == 0 && errcnt) ? -1 : static_cast<int>(tot);
+#else
+    (void)Socket;
+    (void)Position;
+    (void)Size;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/// \brief Moves the file offset on past the data sent by SafeSend().
+void MythFileBuffer::SetSendPosition(long long Position)
+{
+    if (lseek64(m_fd2, Position, SEEK_SET) < 0)
+        LOG(VB_FILE, LOG_ERR, LOC + "SetSendPosition() failed" + ENO);
+}
+
 int MythFileBuffer::SafeRead(void *Buffer, uint Size)
 {
     if (m_remotefile)
         return SafeRead(m_remotefile, Buffer, Size);
+    if (m_fd2 >= 0 && m_memoryMapped && !m_readAheadRunning)
+        return SafeReadMapped(Buffer, Size);
     if (m_fd2 >= 0)
         return SafeRead(m_fd2, Buffer, Size);
     errno = EBADF;
@@ -547,6 +729,158 @@ int MythFileBuffer::SafeRead(RemoteFile *Remote, void *Buffer, uint Size)
     return ret;
 }
 
+/** \brief Copies data straight from a memory mapped window of the file.
+ *
+ *  The window slides along with the reads and is remapped when it is
+ *  exhausted, which also picks up data appended to a recording in
+ *  progress. A short read at the end of what is on disk is handled by
+ *  the caller just as with read(), and so is a page that can no longer
+ *  be read, which returns what was copied before it.
+ */
+int MythFileBuffer::SafeReadMapped(void *Buffer, uint Size)
+{
+#if HAVE_MMAP
+    uint tot = 0;
+    uint zerocnt = 0;
+    while (tot < Size && !m_stopReads)
+    {
+        long long pos = m_mapReadPos + tot;
+        if ((!m_mapBase || pos < m_mapStart ||
+             pos >= m_mapStart + static_cast<long long>(m_mapLength)) &&
+            !MapWindow(pos))
+        {
+            // Give a recording in progress a moment to grow, as
+            // SafeRead(int, ...) does.
+            if (tot > 0 || m_oldfile || ++zerocnt >= (m_liveTVChain ? 6 : 40))
+                break;
+            usleep(60ms);
+            continue;
+        }
+
+        size_t avail = static_cast<size_t>(m_mapStart + static_cast<long long>(m_mapLength) - pos);
+        size_t len = std::min(avail, static_cast<size_t>(Size - tot));
+        if (!CopyFromMap(static_cast<char*>(Buffer) + tot, m_mapBase + (pos - m_mapStart), len))
+        {
+            // Remap on the next read, which finds the new end of a
+            // truncated file
+            LOG(VB_GENERAL, LOG_ERR, LOC + QString("File I/O problem in 'safe_read()', "
+                "mapped read of %1 bytes at %2 failed").arg(len).arg(pos));
+            m_numFailures++;
+            UnmapWindow();
+            break;
+        }
+        tot += static_cast<uint>(len);
+    }
+    m_mapReadPos += tot;
+
+    // Keep the kernel reading ahead of the decoder
+    long long mapEnd = m_mapStart + static_cast<long long>(m_mapLength);
+    if (m_mapBase && (m_mapAdvised < m_mapReadPos + static_cast<long long>(kMapAdviseSize)) &&
+        (m_mapAdvised < mapEnd))
+    {
+        long long from = std::max(m_mapAdvised, m_mapReadPos);
+        from -= (from - m_mapStart) % sysconf(_SC_PAGESIZE);
+        long long to = std::min(from + static_cast<long long>(kMapAdviseSize), mapEnd);
+        if (madvise(m_mapBase + (from - m_mapStart), static_cast<size_t>(to - from), MADV_WILLNEED) != 0)
+            LOG(VB_FILE, LOG_DEBUG, LOC + "madvise willneed failed: " + ENO);
+        m_mapAdvised = to;
+    }
+    return static_cast<int>(tot);
+#else
+    return SafeRead(m_fd2, Buffer, Size);
+#endif
+}
+
+long long MythFileBuffer::SeekMapped(long long Position, int Whence)
+{
+    long long ret = -1;
+    if (SEEK_SET == Whence)
+    {
+        ret = Position;
+    }
+    else if (SEEK_CUR == Whence)
+    {
+        ret = m_mapReadPos + Position;
+    }
+    else
+    {
+        struct stat sb {};
+        if (fstat(m_fd2, &sb) == 0)
+            ret = sb.st_size + Position;
+    }
+
+    if (ret < 0)
+    {
+        errno = EINVAL;
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Seek(%1, %2) Failed").arg(Position).arg(Whence) + ENO);
+        return -1;
+    }
+
+    m_posLock.lockForWrite();
+    m_mapReadPos = ret;
+    m_mapAdvised = ret;
+    m_readPos = ret;
+    m_ignoreReadPos = -1;
+    m_readAdjust = 0;
+    m_posLock.unlock();
+    m_generalWait.wakeAll();
+    return ret;
+}
+
+/** \brief Maps the window of the file starting at the page containing
+ *         Position, or extends the current window if the file has grown.
+ */
+bool MythFileBuffer::MapWindow(long long Position)
+{
+#if HAVE_MMAP
+    struct stat sb {};
+    if (fstat(m_fd2, &sb) != 0 || Position >= sb.st_size)
+        return false;
+
+    long long start = Position - (Position % sysconf(_SC_PAGESIZE));
+    if (m_mapBase && Position >= m_mapStart &&
+        Position < m_mapStart + static_cast<long long>(kMapWindowSize))
+    {
+        start = m_mapStart;
+    }
+    auto length = static_cast<size_t>(std::min(static_cast<long long>(kMapWindowSize),
+                                               sb.st_size - start));
+
+    UnmapWindow();
+    void *base = mmap(nullptr, length, PROT_READ, MAP_SHARED, m_fd2, start);
+    if (base == MAP_FAILED)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Failed to map %1 bytes at %2")
+            .arg(length).arg(start) + ENO);
+        return false;
+    }
+
+    m_mapBase   = static_cast<char*>(base);
+    m_mapStart  = start;
+    m_mapLength = length;
+    m_mapAdvised = std::max(m_mapAdvised, start);
+    if (madvise(base, length, MADV_SEQUENTIAL) != 0)
+        LOG(VB_FILE, LOG_DEBUG, LOC + "madvise sequential failed: " + ENO);
+
+    LOG(VB_FILE, LOG_DEBUG, LOC + QString("Mapped %1 bytes at %2").arg(length).arg(start));
+    return true;
+#else
+    (void)Position;
+    return false;
+#endif
+}
+
+void MythFileBuffer::UnmapWindow(void)
+{
+#if HAVE_MMAP
+    if (m_mapBase)
+        munmap(m_mapBase, m_mapLength);
+#endif
+    m_mapBase   = nullptr;
+    m_mapStart  = 0;
+    m_mapLength = 0;
+}
+
 long long MythFileBuffer::GetReadPosition(void) const
 {
     m_posLock.lockForRead();
@@ -593,6 +927,9 @@ long long MythFileBuffer::SeekInternal(long long Position, int Whence)
     if (m_writeMode)
         return WriterSeek(Position, Whence, true);
 
+    if (m_fd2 >= 0 && m_memoryMapped && !m_readAheadRunning)
+        return SeekMapped(Position, Whence);
+
     m_posLock.lockForWrite();
 
     // Optimize no-op seeks
@@ -17,12 +17,30 @@ class MTV_PUBLIC MythFileBuffer : public MythMediaBuffer
     long long GetReadPosition (void) const override;
     bool      OpenFile        (const QString &Filename, std::chrono::milliseconds Retry = kDefaultOpenTimeout) override;
     bool      ReOpen          (const QString& Filename = "") override;
+    bool      CanSendDirect   (void) const override;
 
   protected:
     MythFileBuffer(const QString &Filename, bool Write, bool UseReadAhead, std::chrono::milliseconds Timeout);
     int       SafeRead        (void *Buffer, uint Size) override;
     int       SafeRead        (int FD, void *Buffer, uint Size);
     int       SafeRead        (RemoteFile *Remote, void *Buffer, uint Size);
+    int       SafeSend        (int Socket, long long Position, uint Size) override;
+    void      SetSendPosition (long long Position) override;
     long long GetRealFileSizeInternal(void) const override;
     long long SeekInternal    (long long Position, int Whence) override;
+
+  private:
+    int       SafeReadMapped  (void *Buffer, uint Size);
+    long long SeekMapped      (long long Position, int Whence);
+    bool      MapWindow       (long long Position);
+    void      UnmapWindow     (void);
+
+    static constexpr size_t kMapWindowSize { 64ULL * 1024 * 1024 };
+    static constexpr size_t kMapAdviseSize {  2ULL * 1024 * 1024 };
+
+    char     *m_mapBase       { nullptr };
+    long long m_mapStart      { 0 };
+    size_t    m_mapLength     { 0 };
+    long long m_mapReadPos    { 0 };
+    long long m_mapAdvised    { 0 };
 };
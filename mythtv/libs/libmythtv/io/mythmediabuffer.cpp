@@ -306,6 +306,9 @@ void MythMediaBuffer::UpdatePlaySpeed(float PlaySpeed)
 {
     m_rwLock.lockForWrite();
     m_playSpeed = PlaySpeed;
+    // the observed rate was for the old speed, start measuring again
+    m_decoderRateAvg = 0.0;
+    m_adaptedBitrate = 0;
     CalcReadAheadThresh();
     m_rwLock.unlock();
 }
@@ -363,6 +366,9 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
 
     estbitrate     = static_cast<uint>(std::max(abs(m_rawBitrate * m_playSpeed), 0.5F * m_rawBitrate));
     estbitrate     = std::min(m_rawBitrate * 3, estbitrate);
+    // what the decoder has actually been consuming wins over a wrong
+    // or unknown bitrate from the container
+    estbitrate     = std::max(estbitrate, m_adaptedBitrate);
     int const rbs  = (estbitrate > 18000) ? KB512 :
                      (estbitrate >  9000) ? KB256 :
                      (estbitrate >  5000) ? KB128 :
@@ -386,6 +392,15 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
         if (m_lowBuffers)
             LOG(VB_GENERAL, LOG_INFO, LOC + "Buffering optimisations disabled.");
         m_lowBuffers = false;
+        // but don't keep playback waiting after a seek for longer than
+        // the storage takes to deliver it within the refill target
+        double storageRate = m_storageRateAvg;
+        if (storageRate > 0.0)
+        {
+            auto refill = static_cast<int>(storageRate *
+                duration_cast<std::chrono::duration<double>>(kSeekRefillTarget).count());
+            m_fillMin = std::min(m_fillMin, refill);
+        }
         m_fillMin = ((m_fillMin / DEFAULT_CHUNK_SIZE) + 1) * DEFAULT_CHUNK_SIZE;
         m_fillMin = std::min(m_fillMin, static_cast<int>(m_bufferSize / 2));
     }
@@ -402,6 +417,62 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
             .arg(m_fillMin/1024).arg(m_readBlockSize/1024));
 }
 
+/** \brief Resizes the read ahead buffer and thresholds from the rate
+ *         the decoder has actually been consuming data.
+ *
+ *  The buffer is sized to hold kReadAheadTarget of the stream at the
+ *  current play speed. It grows straight away, but only shrinks on the
+ *  next ResetReadAhead(), when there is no buffered data to lose.
+ *
+ *  \warning Must be called with rwlock in write lock state.
+ */
+void MythMediaBuffer::AdaptReadAhead(std::chrono::milliseconds Interval)
+{
+    m_posLock.lockForWrite();
+    uint64_t consumed = m_decoderBytes;
+    m_decoderBytes = 0;
+
+    // Pauses say nothing about the stream
+    if (!consumed || Interval <= 0ms || m_paused || m_requestPause)
+    {
+        m_posLock.unlock();
+        return;
+    }
+
+    double rate = static_cast<double>(consumed) * 1000.0 / static_cast<double>(Interval.count());
+    m_decoderRateAvg = (m_decoderRateAvg > 0.0) ? ((m_decoderRateAvg * 3.0) + rate) / 4.0 : rate;
+
+    // Only act on significant changes, CalcReadAheadThresh() stalls reads
+    auto bitrate = static_cast<uint>(m_decoderRateAvg * 8.0 / 1000.0);
+    if (m_adaptedBitrate && (bitrate < m_adaptedBitrate * 5 / 4) &&
+        (bitrate > m_adaptedBitrate * 3 / 4))
+    {
+        m_posLock.unlock();
+        return;
+    }
+    m_adaptedBitrate = bitrate;
+
+    double nominal = std::abs(m_rawBitrate * m_playSpeed) * 1000.0 / 8.0;
+    double wanted = std::max(m_decoderRateAvg, nominal) *
+        duration_cast<std::chrono::duration<double>>(kReadAheadTarget).count();
+    if (m_remotefile)
+        wanted *= BUFFER_FACTOR_NETWORK;
+    const uint MB = 1024 * 1024;
+    auto size = static_cast<uint>(std::min(wanted, static_cast<double>(BUFFER_SIZE_MAXIMUM)));
+    m_wantedBufferSize = std::max(((size + MB - 1) / MB) * MB, BaseBufferSize());
+
+    LOG(VB_FILE, LOG_INFO, LOC + QString("AdaptReadAhead: decoder %1 storage %2 -> %3Mb buffer")
+        .arg(BitrateToString(static_cast<uint64_t>(m_decoderRateAvg * 8.0)),
+             BitrateToString(static_cast<uint64_t>(m_storageRateAvg * 8.0)))
+        .arg(m_wantedBufferSize / MB));
+
+    if (m_readAheadBuffer && (m_wantedBufferSize > m_bufferSize))
+        ResizeReadAheadBuffer(m_wantedBufferSize);
+    else
+        CalcReadAheadThresh();
+    m_posLock.unlock();
+}
+
 bool MythMediaBuffer::IsNearEnd(double /*Framerate*/, uint Frames) const
 {
     QReadLocker lock(&m_rwLock);
@@ -576,10 +647,23 @@ void MythMediaBuffer::ResetReadAhead(long long NewInternal)
     m_rbrLock.lockForWrite();
     m_rbwLock.lockForWrite();
 
-    CalcReadAheadThresh();
-
     m_rbrPos          = 0;
     m_rbwPos          = 0;
+
+    // Nothing is buffered now, so this is where memory the stream no
+    // longer needs can be given back.
+    uint wanted = std::max(m_wantedBufferSize, BaseBufferSize());
+    if (m_readAheadBuffer && m_wantedBufferSize && (wanted < m_bufferSize / 2))
+    {
+        delete [] m_readAheadBuffer;
+        m_readAheadBuffer = nullptr;
+        ResizeReadAheadBuffer(wanted);
+    }
+    else
+    {
+        CalcReadAheadThresh();
+    }
+
     m_internalReadPos = NewInternal;
     m_ateof           = false;
     m_readsAllowed    = false;
@@ -621,6 +705,12 @@ void MythMediaBuffer::Start(void)
         LOG(VB_GENERAL, LOG_WARNING, LOC + "Not starting read ahead thread - write only RingBuffer");
         dostart = false;
     }
+    else if (m_memoryMapped && !m_liveTVChain)
+    {
+        // LiveTV still needs the thread to notice when to switch files
+        LOG(VB_FILE, LOG_INFO, LOC + "Not starting read ahead thread - reading from memory map");
+        dostart = false;
+    }
     else if (m_readAheadRunning)
     {
         LOG(VB_GENERAL, LOG_WARNING, LOC + "Not starting read ahead thread - already running");
@@ -767,31 +857,52 @@ bool MythMediaBuffer::PauseAndWait(void)
     return m_requestPause || m_paused;
 }
 
-void MythMediaBuffer::CreateReadAheadBuffer(void)
+/// \brief Returns the buffer size for this kind of file before
+///        anything has been measured.
+uint MythMediaBuffer::BaseBufferSize(void) const
 {
-    m_rwLock.lockForWrite();
-    m_posLock.lockForWrite();
-
-    uint oldsize = m_bufferSize;
-    uint newsize = BUFFER_SIZE_MINIMUM;
+    uint size = BUFFER_SIZE_MINIMUM;
     if (m_remotefile)
     {
-        newsize *= BUFFER_FACTOR_NETWORK;
+        size *= BUFFER_FACTOR_NETWORK;
         if (m_fileIsMatroska)
-            newsize *= BUFFER_FACTOR_MATROSKA;
+            size *= BUFFER_FACTOR_MATROSKA;
         if (m_unknownBitrate)
-            newsize *= BUFFER_FACTOR_BITRATE;
+            size *= BUFFER_FACTOR_BITRATE;
     }
+    return size;
+}
+
+void MythMediaBuffer::CreateReadAheadBuffer(void)
+{
+    m_rwLock.lockForWrite();
+    m_posLock.lockForWrite();
+
+    uint newsize = std::max(BaseBufferSize(), m_wantedBufferSize);
 
-    // N.B. Don't try and make it smaller - bad things happen...
-    if (m_readAheadBuffer && (oldsize >= newsize))
+    // N.B. Shrinking would lose buffered data, see ResetReadAhead()
+    if (m_readAheadBuffer && (m_bufferSize >= newsize))
     {
         m_posLock.unlock();
         m_rwLock.unlock();
         return;
     }
 
-    m_bufferSize = newsize;
+    ResizeReadAheadBuffer(newsize);
+    m_posLock.unlock();
+    m_rwLock.unlock();
+}
+
+/** \brief Allocates a read ahead buffer of NewSize bytes, moving any
+ *         buffered data into it.
+ *
+ *  \warning Must be called with rwlock and poslock in write lock state.
+ *           NewSize must not be smaller than an existing buffer.
+ */
+void MythMediaBuffer::ResizeReadAheadBuffer(uint NewSize)
+{
+    uint oldsize = m_bufferSize;
+    m_bufferSize = NewSize;
     if (m_readAheadBuffer)
     {
         char* newbuffer = new char[m_bufferSize + 1024];
@@ -808,11 +919,9 @@ void MythMediaBuffer::CreateReadAheadBuffer(void)
         m_readAheadBuffer = new char[m_bufferSize + 1024];
     }
     CalcReadAheadThresh();
-    m_posLock.unlock();
-    m_rwLock.unlock();
 
     LOG(VB_FILE, LOG_INFO, LOC + QString("Created readAheadBuffer: %1Mb")
-        .arg(newsize >> 20));
+        .arg(NewSize >> 20));
 }
 
 void MythMediaBuffer::run(void)
@@ -823,6 +932,7 @@ void MythMediaBuffer::run(void)
     std::chrono::milliseconds readTimeAvg = 300ms;
     bool ignoreForReadTiming = true;
     int  eofreads = 0;
+    MythTimer adaptTimer(MythTimer::kStartRunning);
 
     auto lastread = nowAsDuration<std::chrono::milliseconds>();
 
@@ -868,6 +978,15 @@ void MythMediaBuffer::run(void)
             continue;
         }
 
+        if (adaptTimer.elapsed() >= kAdaptInterval)
+        {
+            m_rwLock.unlock();
+            m_rwLock.lockForWrite();
+            AdaptReadAhead(adaptTimer.restart());
+            m_rwLock.unlock();
+            m_rwLock.lockForRead();
+        }
+
         long long totfree = ReadBufFree();
 
         const uint KB32  = 32*1024;
@@ -976,6 +1095,12 @@ void MythMediaBuffer::run(void)
                 .arg(QString("(%1Mbps)").arg(static_cast<double>(bps) / 1000000.0))
                 .arg(readTimeAvg.count()));
             UpdateStorageRate(bps);
+            if (readResult > 0 && sr_elapsed > 0)
+            {
+                double rate = static_cast<double>(bps) / 8.0;
+                double avg = m_storageRateAvg;
+                m_storageRateAvg = (avg > 0.0) ? ((avg * 7.0) + rate) / 8.0 : rate;
+            }
 
             if (readResult >= 0)
             {
@@ -1479,6 +1604,7 @@ int MythMediaBuffer::Read(void *Buffer, int Count)
     {
         m_posLock.lockForWrite();
         m_readPos += ret;
+        m_decoderBytes += static_cast<uint64_t>(ret);
         m_posLock.unlock();
         UpdateDecoderRate(static_cast<uint64_t>(ret));
     }
@@ -1486,6 +1612,58 @@ int MythMediaBuffer::Read(void *Buffer, int Count)
     return ret;
 }
 
+/** \brief Sends up to Count bytes from the current position straight to
+ *         Socket, without copying them through user space.
+ *
+ *  Only valid when CanSendDirect() and the read ahead thread has not
+ *  been started. Like a direct Read() this returns a short count at the
+ *  current end of a recording in progress, and the caller should retry.
+ *
+ *  \return bytes sent, 0 at the end of the file or -1 on error
+ */
+int MythMediaBuffer::SendDirect(int Socket, int Count)
+{
+    m_rwLock.lockForRead();
+    if (m_writeMode || m_readAheadRunning)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "SendDirect() called while reading ahead");
+        errno = EBADF;
+        m_rwLock.unlock();
+        return -1;
+    }
+    m_posLock.lockForRead();
+    long long position = (m_ignoreReadPos >= 0) ? m_ignoreReadPos : m_readPos;
+    m_posLock.unlock();
+    m_rwLock.unlock();
+
+    // Sending waits for the client to read, so it mustn't hold up readers
+    // and seeks by holding m_rwLock
+    MythTimer timer;
+    timer.start();
+    int ret = SafeSend(Socket, position, static_cast<uint>(Count));
+    int elapsed = timer.elapsed().count();
+    UpdateStorageRate(!elapsed ? 1000000001 : static_cast<uint64_t>((ret * 8000.0) / static_cast<double>(elapsed)));
+
+    if (ret > 0)
+    {
+        m_rwLock.lockForWrite();
+        m_posLock.lockForWrite();
+        // Unless a Seek() has moved on meanwhile
+        long long &current = (m_ignoreReadPos >= 0) ? m_ignoreReadPos : m_readPos;
+        if (current == position)
+        {
+            current += ret;
+            SetSendPosition(current);
+        }
+        m_decoderBytes += static_cast<uint64_t>(ret);
+        m_posLock.unlock();
+        m_rwLock.unlock();
+        UpdateDecoderRate(static_cast<uint64_t>(ret));
+    }
+
+    return ret;
+}
+
 QString MythMediaBuffer::BitrateToString(uint64_t Rate, bool Hz)
 {
     if (Rate < 1)
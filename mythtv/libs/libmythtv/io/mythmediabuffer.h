@@ -1,6 +1,9 @@
 #ifndef MYTHMEDIABUFFER_H
 #define MYTHMEDIABUFFER_H
 
+// Std
+#include <atomic>
+
 // Qt
 #include <QReadWriteLock>
 #include <QWaitCondition>
@@ -24,6 +27,7 @@ extern "C" {
 
 // about one second at 35Mb
 #define BUFFER_SIZE_MINIMUM (4 * 1024 * 1024)
+#define BUFFER_SIZE_MAXIMUM (64 * 1024 * 1024)
 #define BUFFER_FACTOR_NETWORK  2
 #define BUFFER_FACTOR_BITRATE  2
 #define BUFFER_FACTOR_MATROSKA 2
@@ -92,6 +96,7 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     const MythBDBuffer  *BD        (void) const;
     MythBDBuffer        *BD        (void);
     int       Read                 (void *Buffer, int Count);
+    int       SendDirect           (int Socket, int Count);
     int       Peek                 (void *Buffer, int Count);
     int       Peek                 (std::vector<char>& Buffer);
     void      Reset                (bool Full = false, bool ToAdjust = false, bool ResetInternal = false);
@@ -134,13 +139,17 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     virtual bool      HandleAction      (const QStringList &/*Action*/, mpeg::chrono::pts /*Pts*/) { return false; }
     virtual bool      OpenFile          (const QString &Filename, std::chrono::milliseconds Retry = kDefaultOpenTimeout) = 0;
     virtual bool      ReOpen            (const QString& /*Filename*/ = "") { return false; }
+    virtual bool      CanSendDirect     (void) const { return false; }
 
   protected:
     explicit MythMediaBuffer(MythBufferType Type);
 
     void     run(void) override;
     void     CreateReadAheadBuffer (void);
+    uint     BaseBufferSize        (void) const;
+    void     ResizeReadAheadBuffer (uint NewSize);
     void     CalcReadAheadThresh   (void);
+    void     AdaptReadAhead        (std::chrono::milliseconds Interval);
     bool     PauseAndWait          (void);
     int      ReadPriv              (void *Buffer, int Count, bool Peek);
     int      ReadDirect            (void *Buffer, int Count, bool Peek);
@@ -154,11 +163,20 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     uint64_t UpdateStorageRate     (uint64_t Latest = 0);
 
     virtual int       SafeRead     (void *Buffer, uint Size) = 0;
+    virtual int       SafeSend     (int /*Socket*/, long long /*Position*/, uint /*Size*/) { return -1; }
+    virtual void      SetSendPosition(long long /*Position*/) { }
     virtual long long GetRealFileSizeInternal(void) const { return -1; }
     virtual long long SeekInternal (long long Position, int Whence) = 0;
 
 
   protected:
+    /// How much of the stream the read ahead buffer should hold
+    static constexpr std::chrono::milliseconds kReadAheadTarget  { 4s };
+    /// How long playback may wait for the buffer to refill after a seek
+    static constexpr std::chrono::milliseconds kSeekRefillTarget { 250ms };
+    /// How often the read ahead thread re-evaluates the observed rates
+    static constexpr std::chrono::milliseconds kAdaptInterval    { 1s };
+
     MythBufferType         m_type;
 
     mutable QReadWriteLock m_posLock;
@@ -193,6 +211,7 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     bool                   m_fileIsMatroska   { false };
     bool                   m_unknownBitrate   { false };
     bool                   m_startReadAhead   { false };
+    bool                   m_memoryMapped     { false };
     char                  *m_readAheadBuffer  { nullptr };
     bool                   m_readAheadRunning { false };
     bool                   m_reallyRunning    { false };
@@ -219,8 +238,14 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     long long              m_readAdjust       { 0 };
     int                    m_readOffset       { 0 };
     bool                   m_readInternalMode { false };
+    uint                   m_adaptedBitrate   { 0 };   // Kb/s observed at the decoder
+    uint                   m_wantedBufferSize { 0 };
+    double                 m_decoderRateAvg   { 0.0 }; // bytes/s
+    std::atomic<double>    m_storageRateAvg   { 0.0 }; // bytes/s, written by read ahead thread
     // End of section protected by rwLock
 
+    uint64_t               m_decoderBytes     { 0 };   // protected by posLock
+
     bool                   m_bitrateMonitorEnabled { false };
     QMutex                 m_decoderReadLock;
     QMap<std::chrono::milliseconds, uint64_t> m_decoderReads;
@@ -154,6 +154,7 @@ HEADERS += io/mythfilebuffer.h
 HEADERS += io/mythstreamingbuffer.h
 HEADERS += io/mythinteractivebuffer.h
 HEADERS += io/mythopticalbuffer.h
+HEADERS += decoders/mythdemuxer.h
 HEADERS += metadataimagehelper.h
 HEADERS += mythavutil.h
 HEADERS += recordingfile.h
@@ -192,6 +193,7 @@ SOURCES += io/mythfilebuffer.cpp
 SOURCES += io/mythstreamingbuffer.cpp
 SOURCES += io/mythinteractivebuffer.cpp
 SOURCES += io/mythopticalbuffer.cpp
+SOURCES += decoders/mythdemuxer.cpp
 SOURCES += metadataimagehelper.cpp
 SOURCES += mythframe.cpp
 SOURCES += mythavutil.cpp
@@ -395,6 +397,7 @@ using_frontend {
     HEADERS += mythplayervisualiserui.h
     HEADERS += mythplayeravsync.h
     HEADERS += mythplayeraudioui.h
+    HEADERS += mythplaybacktimings.h
     HEADERS += audioplayer.h
     HEADERS += mythccextractorplayer.h
     HEADERS += captions/teletextextractorreader.h
@@ -418,6 +421,7 @@ using_frontend {
     SOURCES += mythplayervisualiserui.cpp
     SOURCES += mythplayeravsync.cpp
     SOURCES += mythplayeraudioui.cpp
+    SOURCES += mythplaybacktimings.cpp
     SOURCES += audioplayer.cpp
     SOURCES += mythccextractorplayer.cpp
     SOURCES += captions/teletextextractorreader.cpp
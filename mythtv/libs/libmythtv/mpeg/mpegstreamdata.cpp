@@ -142,6 +142,7 @@ void MPEGStreamData::Reset(int desiredProgram)
     m_pidsConditionalAccess.clear();
 
     m_pidVideoSingleProgram = m_pidPmtSingleProgram = 0xffffffff;
+    ++m_pidMapGeneration;
 
     m_patStatus.clear();
 
@@ -603,6 +604,7 @@ bool MPEGStreamData::CreatePMTSingleProgram(const ProgramMapTable &pmt)
 
     m_pidsWriting.clear();
     m_pidVideoSingleProgram = !videoPIDs.empty() ? videoPIDs[0] : 0xffffffff;
+    ++m_pidMapGeneration;
     for (size_t i = 1; i < videoPIDs.size(); i++)
         AddWritingPID(videoPIDs[i]);
 
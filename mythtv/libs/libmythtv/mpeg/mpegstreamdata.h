@@ -4,6 +4,7 @@
 #define MPEGSTREAMDATA_H_
 
 // C++
+#include <atomic>
 #include <cstdint>  // uint64_t
 #include <vector>
 
@@ -118,24 +119,27 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     // Listening
     virtual void AddListeningPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsListening[pid] = priority; }
+        { m_pidsListening[pid] = priority; ++m_pidMapGeneration; }
     virtual void AddNotListeningPID(uint pid)
-        { m_pidsNotListening[pid] = kPIDPriorityNormal; }
+        { m_pidsNotListening[pid] = kPIDPriorityNormal; ++m_pidMapGeneration; }
     virtual void AddWritingPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsWriting[pid] = priority; }
+        { m_pidsWriting[pid] = priority; ++m_pidMapGeneration; }
     virtual void AddAudioPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsAudio[pid] = priority; }
+        { m_pidsAudio[pid] = priority; ++m_pidMapGeneration; }
     virtual void AddConditionalAccessPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
         { m_pidsConditionalAccess[pid] = priority; }
 
-    virtual void RemoveListeningPID(uint pid) { m_pidsListening.remove(pid);  }
+    virtual void RemoveListeningPID(uint pid)
+        { m_pidsListening.remove(pid); ++m_pidMapGeneration; }
     virtual void RemoveNotListeningPID(uint pid)
-        { m_pidsNotListening.remove(pid); }
-    virtual void RemoveWritingPID(uint pid) { m_pidsWriting.remove(pid);    }
-    virtual void RemoveAudioPID(uint pid)   { m_pidsAudio.remove(pid);      }
+        { m_pidsNotListening.remove(pid); ++m_pidMapGeneration; }
+    virtual void RemoveWritingPID(uint pid)
+        { m_pidsWriting.remove(pid); ++m_pidMapGeneration; }
+    virtual void RemoveAudioPID(uint pid)
+        { m_pidsAudio.remove(pid); ++m_pidMapGeneration; }
 
     virtual bool IsListeningPID(uint pid) const;
     virtual bool IsNotListeningPID(uint pid) const;
@@ -153,6 +157,9 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
         { return m_pidsWriting; }
 
     uint GetPIDs(pid_map_t &pids) const;
+    /// Changes whenever the set of PIDs returned by GetPIDs() may
+    /// have changed, lets StreamHandler cache its PID routing table.
+    uint GetPIDMapGeneration(void) const { return m_pidMapGeneration; }
 
     // PID Priorities
     PIDPriority GetPIDPriority(uint pid) const;
@@ -325,6 +332,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     pid_map_t                 m_pidsAudio;
     pid_map_t                 m_pidsConditionalAccess;
     bool                      m_listeningDisabled           {false};
+    std::atomic<uint>         m_pidMapGeneration            {0};
 
     // Encryption monitoring
     mutable QMutex            m_encryptionLock              {QMutex::Recursive};
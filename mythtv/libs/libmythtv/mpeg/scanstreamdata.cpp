@@ -11,7 +11,10 @@ ScanStreamData::ScanStreamData(bool no_default_pid) :
     m_noDefaultPid(no_default_pid)
 {
     if (m_noDefaultPid)
+    {
         m_pidsListening.clear();
+        ++m_pidMapGeneration;
+    }
 }
 
 ScanStreamData::~ScanStreamData() { ; }
@@ -64,6 +67,7 @@ void ScanStreamData::Reset(void)
     if (m_noDefaultPid)
     {
         m_pidsListening.clear();
+        ++m_pidMapGeneration;
         return;
     }
 
@@ -77,6 +81,7 @@ void ScanStreamData::Reset(uint desired_netid, uint desired_tsid, int desired_se
     if (m_noDefaultPid)
     {
         m_pidsListening.clear();
+        ++m_pidMapGeneration;
         return;
     }
 
@@ -1,5 +1,13 @@
+// Std
+#include <algorithm>
+
+// Qt
+#include <QRunnable>
+#include <QSemaphore>
+
 // MythTV
 #include "config.h"
+#include "mthreadpool.h"
 #include "mythlogging.h"
 #include "mythavutil.h"
 #include "mythvideoprofile.h"
@@ -13,7 +21,11 @@ extern "C" {
 #if (HAVE_SSE2 && ARCH_X86_64)
 #include "libavutil/x86/cpu.h"
 #include <emmintrin.h>
+#if HAVE_AVX2
+#include <immintrin.h>
+#endif
 bool MythDeinterlacer::s_haveSIMD = av_get_cpu_flags() & AV_CPU_FLAG_SSE2;
+bool MythDeinterlacer::s_haveAVX2 = av_get_cpu_flags() & AV_CPU_FLAG_AVX2;
 #elif HAVE_INTRINSICS_NEON
 #if ARCH_AARCH64
 #include "libavutil/aarch64/cpu.h"
@@ -22,8 +34,10 @@ bool MythDeinterlacer::s_haveSIMD = av_get_cpu_flags() & AV_CPU_FLAG_SSE2;
 #endif
 #include <arm_neon.h>
 bool MythDeinterlacer::s_haveSIMD = have_neon(av_get_cpu_flags());
+bool MythDeinterlacer::s_haveAVX2 = false;
 #else
 bool MythDeinterlacer::s_haveSIMD = false;
+bool MythDeinterlacer::s_haveAVX2 = false;
 #endif
 
 #define LOC QString("MythDeint: ")
@@ -37,8 +51,12 @@ bool MythDeinterlacer::s_haveSIMD = false;
  *
  * The following deinterlacers are used:
  * Basic - onefield/bob using libswcale
- * Medium - linearblend with custom code (SSE2 and Neon assisted where available)
- * High - libavfilter's yadif (with multithreading)
+ * Medium - linearblend with custom code (AVX2, SSE2 and Neon assisted where
+ *          available), split into slices across a small pool of threads
+ * High - libavfilter's yadif (with slice threading)
+ *
+ * The number of threads comes from the video profile's maximum CPUs, unless
+ * given to the constructor.
  *
  * \note libavfilter frame doubling filters expect frames to be presented
  * in the correct order and will break if they do not receive a frame followed
@@ -48,6 +66,7 @@ bool MythDeinterlacer::s_haveSIMD = false;
 MythDeinterlacer::~MythDeinterlacer()
 {
     Cleanup();
+    delete m_pool;
 }
 
 /*! \brief Deinterlace Frame if needed
@@ -312,6 +331,11 @@ bool MythDeinterlacer::Initialise(MythVideoFrame *Frame, MythDeintType Deinterla
     m_inputFmt  = MythAVUtil::FrameTypeToPixelFormat(Frame->m_type);
     auto name   = MythVideoFrame::DeinterlacerName(Deinterlacer | DEINT_CPU, DoubleRate);
 
+    uint threads = m_maxThreads;
+    if (!threads && Profile)
+        threads = Profile->GetMaxCPUs();
+    m_threads = std::clamp(threads, 1U, 8U);
+
     // simple onefield/bob?
     if (Deinterlacer == DEINT_BASIC || Deinterlacer == DEINT_MEDIUM)
     {
@@ -326,7 +350,15 @@ bool MythDeinterlacer::Initialise(MythVideoFrame *Frame, MythDeintType Deinterla
             if (m_swsContext == nullptr)
                 return false;
         }
-        LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using deinterlacer '%1'").arg(name));
+        else if (m_threads > 1)
+        {
+            // The calling thread blends one slice itself
+            if (!m_pool)
+                m_pool = new MThreadPool("MythDeint");
+            m_pool->setMaxThreadCount(static_cast<int>(m_threads) - 1);
+        }
+        LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Using deinterlacer '%1' (%2 threads)")
+            .arg(name).arg(Deinterlacer == DEINT_MEDIUM ? m_threads : 1));
         return true;
     }
 
@@ -341,19 +373,16 @@ bool MythDeinterlacer::Initialise(MythVideoFrame *Frame, MythDeintType Deinterla
     if (!m_graph)
         return false;
 
-    uint threads = 1;
-    if (Profile)
-    {
-        threads = Profile->GetMaxCPUs();
-        if (threads < 1 || threads > 8)
-            threads = 1;
-    }
+    // Size the graph's own slice thread pool to match, rather than one
+    // thread per core.
+    m_graph->nb_threads  = static_cast<int>(m_threads);
+    m_graph->thread_type = AVFILTER_THREAD_SLICE;
 
     AVFilterInOut* inputs = nullptr;
     AVFilterInOut* outputs = nullptr;
 
     auto deint = QString("yadif=mode=%1:parity=%2:threads=%3")
-        .arg(DoubleRate ? 1 : 0).arg(m_autoFieldOrder ? -1 : TopFieldFirst ? 0 : 1).arg(threads);
+        .arg(DoubleRate ? 1 : 0).arg(m_autoFieldOrder ? -1 : TopFieldFirst ? 0 : 1).arg(m_threads);
 
     auto graph = QString("buffer=video_size=%1x%2:pix_fmt=%3:time_base=1/1[in];[in]%4[out];[out] buffersink")
         .arg(m_width).arg(m_height).arg(m_inputFmt).arg(deint);
@@ -370,7 +399,7 @@ bool MythDeinterlacer::Initialise(MythVideoFrame *Frame, MythDeintType Deinterla
             if (m_source && m_sink)
             {
                 LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Created deinterlacer '%1' (%2 threads)")
-                    .arg(name).arg(threads));
+                    .arg(name).arg(m_threads));
                 m_deintType  = Deinterlacer;
                 m_doubleRate = DoubleRate;
                 m_topFirst   = TopFieldFirst;
@@ -626,6 +655,138 @@ static inline void BlendSIMD8x4(unsigned char *Src, int Width, int FirstRow, int
 }
 #endif
 
+#if (HAVE_AVX2 && ARCH_X86_64)
+// AVX2 version of the SIMD blends, 32 bytes per pass with a 16 byte SSE2 tail
+// as planes are only guaranteed 16 byte aligned.
+template<bool HighDepth>
+__attribute__((target("avx2")))
+static void BlendAVX2x4(unsigned char *Src, int Width, int FirstRow, int LastRow, int Pitch,
+                        unsigned char *Dst, int DstPitch, bool Second)
+{
+    int srcpitch = Pitch << 1;
+    int dstpitch = DstPitch << 1;
+    int maxrows  = LastRow - 3;
+
+    unsigned char *above   = Src + ((FirstRow - 1) * Pitch);
+    unsigned char *dest1   = Dst + (FirstRow * DstPitch);
+    unsigned char *middle  = above + srcpitch;
+    unsigned char *dest2   = dest1 + dstpitch;
+    unsigned char *below   = middle + srcpitch;
+    unsigned char *dstcpy1 = Dst + ((FirstRow - 1) * DstPitch);
+    unsigned char *dstcpy2 = dstcpy1 + dstpitch;
+
+    srcpitch <<= 1;
+    dstpitch <<= 1;
+
+    // 4 rows per pass
+    for (int row = FirstRow; row < maxrows; row += 4)
+    {
+        if (Second)
+        {
+            // On second pass, copy over the original, current field
+            memcpy(dstcpy1, above,  static_cast<size_t>(DstPitch));
+            memcpy(dstcpy2, middle, static_cast<size_t>(DstPitch));
+            dstcpy1 += dstpitch;
+            dstcpy2 += dstpitch;
+        }
+        int col = 0;
+        for ( ; col + 32 <= Width; col += 32)
+        {
+            __m256i abv = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&above[col]));
+            __m256i mid = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&middle[col]));
+            __m256i blw = _mm256_loadu_si256(reinterpret_cast<__m256i*>(&below[col]));
+            if constexpr (HighDepth)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest1[col]), _mm256_avg_epu16(abv, mid));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest2[col]), _mm256_avg_epu16(blw, mid));
+            }
+            else
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest1[col]), _mm256_avg_epu8(abv, mid));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest2[col]), _mm256_avg_epu8(blw, mid));
+            }
+        }
+        for ( ; col < Width; col += 16)
+        {
+            __m128i mid = *reinterpret_cast<__m128i*>(&middle[col]);
+            if constexpr (HighDepth)
+            {
+                *reinterpret_cast<__m128i*>(&dest1[col]) =
+                        _mm_avg_epu16(*reinterpret_cast<__m128i*>(&above[col]), mid);
+                *reinterpret_cast<__m128i*>(&dest2[col]) =
+                        _mm_avg_epu16(*reinterpret_cast<__m128i*>(&below[col]), mid);
+            }
+            else
+            {
+                *reinterpret_cast<__m128i*>(&dest1[col]) =
+                        _mm_avg_epu8(*reinterpret_cast<__m128i*>(&above[col]), mid);
+                *reinterpret_cast<__m128i*>(&dest2[col]) =
+                        _mm_avg_epu8(*reinterpret_cast<__m128i*>(&below[col]), mid);
+            }
+        }
+        above  += srcpitch;
+        middle += srcpitch;
+        below  += srcpitch;
+        dest1  += dstpitch;
+        dest2  += dstpitch;
+    }
+}
+#endif
+
+/// Runs one slice of a deinterlacer pass on a pool thread.
+class MythDeintSlice : public QRunnable
+{
+  public:
+    MythDeintSlice(const std::function<void(uint,uint)> &Slice, uint Index, uint Count,
+                   QSemaphore &Done)
+      : m_slice(Slice), m_index(Index), m_count(Count), m_done(Done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        m_slice(m_index, m_count);
+        m_done.release();
+    }
+
+  private:
+    const std::function<void(uint,uint)> &m_slice;
+    uint        m_index;
+    uint        m_count;
+    QSemaphore &m_done;
+};
+
+/*! \brief Calls Slice(Index, Count) for each of m_threads slices and waits for
+ * them all to complete.
+ *
+ * The calling thread processes the first slice itself, and any that no pool
+ * thread is free to take.
+*/
+void MythDeinterlacer::RunSlices(const std::function<void(uint,uint)> &Slice)
+{
+    if (m_threads < 2 || !m_pool)
+    {
+        Slice(0, 1);
+        return;
+    }
+
+    // N.B. a stopped pool (at shutdown) queues runnables without running them,
+    // so only hand over slices a pool thread can take now.
+    QSemaphore done;
+    for (uint i = 1; i < m_threads; ++i)
+    {
+        auto *slice = new MythDeintSlice(Slice, i, m_threads, done);
+        if (!m_pool->tryStart(slice, "MythDeintSlice"))
+        {
+            slice->run();
+            delete slice;
+        }
+    }
+    Slice(0, m_threads);
+    done.acquire(static_cast<int>(m_threads) - 1);
+}
+
 void MythDeinterlacer::Blend(MythVideoFrame *Frame, FrameScanType Scan)
 {
     if (Frame->m_height < 16 || Frame->m_width < 16)
@@ -649,49 +810,87 @@ void MythDeinterlacer::Blend(MythVideoFrame *Frame, FrameScanType Scan)
     bool hidepth = MythVideoFrame::ColorDepth(src->m_type) > 8;
     bool top = second ? !m_topFirst : m_topFirst;
     uint count = MythVideoFrame::GetNumPlanes(src->m_type);
-    for (uint plane = 0; plane < count; plane++)
-    {
-        int  height  = MythVideoFrame::GetHeightForPlane(src->m_type, src->m_height, plane);
-        int firstrow = top ? 1 : 2;
-        bool height4 = (height % 4) == 0;
-        bool width4  = (src->m_pitches[plane] % 4) == 0;
-        // N.B. all frames allocated by MythTV should have 16 byte alignment
-        // for all planes
-#if (HAVE_SSE2 && ARCH_X86_64) || HAVE_INTRINSICS_NEON
-        bool width16 = (src->m_pitches[plane] % 16) == 0;
-        // profiling SSE2 suggests it is usually 4x faster - as expected
-        if (s_haveSIMD && height4 && width16)
+
+    // Each slice blends a band of rows in every plane. Slices only write the
+    // rows of one field and only read those of the other, so need no locking.
+    auto slice = [&](uint Slice, uint Slices)
+    {
+        for (uint plane = 0; plane < count; plane++)
         {
-            if (hidepth)
+            int  height  = MythVideoFrame::GetHeightForPlane(src->m_type, src->m_height, plane);
+            int firstrow = top ? 1 : 2;
+            bool height4 = (height % 4) == 0;
+            bool width4  = (src->m_pitches[plane] % 4) == 0;
+
+            // Split the plane's 4 row passes between the slices
+            int passes   = std::max(0, (height - firstrow) / 4);
+            int first    = firstrow + (4 * ((passes * static_cast<int>(Slice)) / static_cast<int>(Slices)));
+            int last     = firstrow + (4 * ((passes * static_cast<int>(Slice + 1)) / static_cast<int>(Slices))) + 3;
+            if (first + 3 >= last)
+                continue;
+
+            // N.B. all frames allocated by MythTV should have 16 byte alignment
+            // for all planes
+#if (HAVE_SSE2 && ARCH_X86_64) || HAVE_INTRINSICS_NEON
+            bool width16 = (src->m_pitches[plane] % 16) == 0;
+#if (HAVE_AVX2 && ARCH_X86_64)
+            if (s_haveAVX2 && height4 && width16)
             {
-                BlendSIMD8x4(src->m_buffer + src->m_offsets[plane],
-                             MythVideoFrame::GetPitchForPlane(src->m_type, src->m_width, plane),
-                             firstrow, height, src->m_pitches[plane],
-                             Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                             second);
+                if (hidepth)
+                {
+                    BlendAVX2x4<true>(src->m_buffer + src->m_offsets[plane],
+                                      MythVideoFrame::GetPitchForPlane(src->m_type, src->m_width, plane),
+                                      first, last, src->m_pitches[plane],
+                                      Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                      second);
+                }
+                else
+                {
+                    BlendAVX2x4<false>(src->m_buffer + src->m_offsets[plane],
+                                       MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
+                                       first, last, src->m_pitches[plane],
+                                       Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                       second);
+                }
             }
             else
+#endif
+            // profiling SSE2 suggests it is usually 4x faster - as expected
+            if (s_haveSIMD && height4 && width16)
             {
-                BlendSIMD16x4(src->m_buffer + src->m_offsets[plane],
-                              MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
-                              firstrow, height, src->m_pitches[plane],
-                              Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                              second);
+                if (hidepth)
+                {
+                    BlendSIMD8x4(src->m_buffer + src->m_offsets[plane],
+                                 MythVideoFrame::GetPitchForPlane(src->m_type, src->m_width, plane),
+                                 first, last, src->m_pitches[plane],
+                                 Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                 second);
+                }
+                else
+                {
+                    BlendSIMD16x4(src->m_buffer + src->m_offsets[plane],
+                                  MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
+                                  first, last, src->m_pitches[plane],
+                                  Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                                  second);
+                }
             }
-        }
-        else
+            else
 #endif
-        // N.B. There is no 10bit support here - but it shouldn't be necessary
-        // as everything should be 16byte aligned and 10/12bit interlaced video
-        // is virtually unheard of.
-        if (width4 && height4 && !hidepth)
-        {
-            BlendC4x4(src->m_buffer + src->m_offsets[plane],
-                      MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
-                      firstrow, height, src->m_pitches[plane],
-                      Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
-                      second);
+            // N.B. There is no 10bit support here - but it shouldn't be necessary
+            // as everything should be 16byte aligned and 10/12bit interlaced video
+            // is virtually unheard of.
+            if (width4 && height4 && !hidepth)
+            {
+                BlendC4x4(src->m_buffer + src->m_offsets[plane],
+                          MythVideoFrame::GetWidthForPlane(src->m_type, src->m_width, plane),
+                          first, last, src->m_pitches[plane],
+                          Frame->m_buffer + Frame->m_offsets[plane], Frame->m_pitches[plane],
+                          second);
+            }
         }
-    }
+    };
+
+    RunSlices(slice);
     Frame->m_alreadyDeinterlaced = true;
 }
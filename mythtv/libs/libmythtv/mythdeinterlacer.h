@@ -1,7 +1,11 @@
 #ifndef MYTHDEINTERLACER_H
 #define MYTHDEINTERLACER_H
 
+// Std
+#include <functional>
+
 // MythTV
+#include "mythtvexp.h"
 #include "videoouttypes.h"
 #include "mythavutil.h"
 
@@ -11,11 +15,12 @@ extern "C" {
 }
 
 class MythVideoProfile;
+class MThreadPool;
 
-class MythDeinterlacer
+class MTV_PUBLIC MythDeinterlacer
 {
   public:
-    MythDeinterlacer() = default;
+    explicit MythDeinterlacer(uint MaxThreads = 0) : m_maxThreads(MaxThreads) {}
    ~MythDeinterlacer();
 
     void             Filter       (MythVideoFrame *Frame, FrameScanType Scan,
@@ -30,6 +35,7 @@ class MythDeinterlacer
     void             OneField     (MythVideoFrame *Frame, FrameScanType Scan);
     void             Blend        (MythVideoFrame *Frame, FrameScanType Scan);
     bool             SetUpCache   (MythVideoFrame *Frame);
+    void             RunSlices    (const std::function<void(uint,uint)> &Slice);
 
     VideoFrameType   m_inputType  { FMT_NONE };
     AVPixelFormat    m_inputFmt   { AV_PIX_FMT_NONE };
@@ -47,7 +53,11 @@ class MythDeinterlacer
     uint64_t         m_discontinuityCounter { 0 };
     bool             m_autoFieldOrder  { false };
     uint64_t         m_lastFieldChange { 0 };
+    uint             m_maxThreads { 0 };
+    uint             m_threads    { 1 };
+    MThreadPool*     m_pool       { nullptr };
     static bool      s_haveSIMD;
+    static bool      s_haveAVX2;
 };
 
 #endif
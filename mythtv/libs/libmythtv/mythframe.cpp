@@ -1,4 +1,13 @@
+// Std
+#include <algorithm>
+
+// Qt
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+
 // MythTV
+#include "mthreadpool.h"
 #include "mythlogging.h"
 #include "mythvideoprofile.h"
 #include "mythframe.h"
@@ -10,6 +19,10 @@ extern "C" {
 
 #define LOC QString("VideoFrame: ")
 
+/// Planes of at least this many bytes are copied in bands on the global thread pool
+static constexpr int kParallelCopySize { 2 * 1024 * 1024 };
+static constexpr int kMaxCopyThreads   { 4 };
+
 /*! \class MythVideoFrame
  *
  * \var m_frameCounter Raw frame counter/ticker for discontinuity checks in the player.
@@ -185,23 +198,91 @@ void MythVideoFrame::ClearMetadata()
     m_deinterlaceInuse2x  = false;
 }
 
-void MythVideoFrame::CopyPlane(uint8_t *To, int ToPitch, const uint8_t *From, int FromPitch,
-                               int PlaneWidth, int PlaneHeight)
+static void CopyRows(uint8_t *To, int ToPitch, const uint8_t *From, int FromPitch,
+                     int Width, int Rows)
 {
-    if ((ToPitch == PlaneWidth) && (FromPitch == PlaneWidth))
+    if ((ToPitch == Width) && (FromPitch == Width))
     {
-        memcpy(To, From, static_cast<size_t>(PlaneWidth * PlaneHeight));
+        memcpy(To, From, static_cast<size_t>(Width) * static_cast<size_t>(Rows));
         return;
     }
 
-    for (int y = 0; y < PlaneHeight; y++)
+    for (int y = 0; y < Rows; y++)
     {
-        memcpy(To, From, static_cast<size_t>(PlaneWidth));
+        memcpy(To, From, static_cast<size_t>(Width));
         From += FromPitch;
         To += ToPitch;
     }
 }
 
+/// Copies one band of a plane on a pool thread.
+class MythCopyRows : public QRunnable
+{
+  public:
+    MythCopyRows(uint8_t *To, int ToPitch, const uint8_t *From, int FromPitch,
+                 int Width, int Rows, QSemaphore &Done)
+      : m_to(To), m_toPitch(ToPitch), m_from(From), m_fromPitch(FromPitch),
+        m_width(Width), m_rows(Rows), m_done(Done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        CopyRows(m_to, m_toPitch, m_from, m_fromPitch, m_width, m_rows);
+        m_done.release();
+    }
+
+  private:
+    uint8_t       *m_to;
+    int            m_toPitch;
+    const uint8_t *m_from;
+    int            m_fromPitch;
+    int            m_width;
+    int            m_rows;
+    QSemaphore    &m_done;
+};
+
+/*! \brief Copy PlaneHeight rows of PlaneWidth bytes between planes with differing pitches.
+ *
+ * Large planes (e.g. 4K luma) are split into bands of rows that are copied in
+ * parallel on the global thread pool, with the calling thread taking the first
+ * band and any that no pool thread is free to take.
+*/
+void MythVideoFrame::CopyPlane(uint8_t *To, int ToPitch, const uint8_t *From, int FromPitch,
+                               int PlaneWidth, int PlaneHeight)
+{
+    static const int s_threads = std::clamp(QThread::idealThreadCount(), 1, kMaxCopyThreads);
+
+    int threads = 1;
+    if (PlaneWidth > 0 && PlaneHeight > 1)
+        threads = std::clamp(PlaneWidth * PlaneHeight / kParallelCopySize, 1, std::min(s_threads, PlaneHeight));
+
+    if (threads < 2)
+    {
+        CopyRows(To, ToPitch, From, FromPitch, PlaneWidth, PlaneHeight);
+        return;
+    }
+
+    QSemaphore done;
+    MThreadPool *pool = MThreadPool::globalInstance();
+    for (int i = 1; i < threads; ++i)
+    {
+        int first = PlaneHeight * i / threads;
+        int rows  = (PlaneHeight * (i + 1) / threads) - first;
+        auto *band = new MythCopyRows(To + (static_cast<ptrdiff_t>(first) * ToPitch), ToPitch,
+                                      From + (static_cast<ptrdiff_t>(first) * FromPitch), FromPitch,
+                                      PlaneWidth, rows, done);
+        if (!pool->tryStart(band, "MythCopyRows"))
+        {
+            band->run();
+            delete band;
+        }
+    }
+    CopyRows(To, ToPitch, From, FromPitch, PlaneWidth, PlaneHeight / threads);
+    done.acquire(threads - 1);
+}
+
 void MythVideoFrame::ClearBufferToBlank()
 {
     if (!m_buffer)
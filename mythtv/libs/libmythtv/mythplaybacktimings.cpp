@@ -0,0 +1,169 @@
+// Std
+#include <algorithm>
+
+// Qt
+#include <QStringList>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythplaybacktimings.h"
+
+#define LOC QString("Timings: ")
+
+MythPlaybackTimings& MythPlaybackTimings::Instance(void)
+{
+    static MythPlaybackTimings s_instance;
+    return s_instance;
+}
+
+QString MythPlaybackTimings::EventToString(Event Type)
+{
+    switch (Type)
+    {
+        case kStartup: return "Startup";
+        case kSeek:    return "Seek";
+        default: break;
+    }
+    return "Unknown";
+}
+
+/*! \brief Starts timing a playback start or seek.
+ *
+ * A seek requested while starting up, e.g. to the bookmark, is timed as
+ * part of the start up. Anything else still being timed is abandoned.
+*/
+void MythPlaybackTimings::Begin(Event Type)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_active && m_event == kStartup && Type == kSeek)
+    {
+        std::chrono::milliseconds elapsed = m_timer.elapsed();
+        m_stages.emplace_back("SeekRequested", elapsed);
+        LOG(VB_LATENCY, LOG_INFO, LOC + QString("Startup +%1 ms: SeekRequested")
+            .arg(elapsed.count()));
+        return;
+    }
+
+    if (m_active)
+    {
+        LOG(VB_LATENCY, LOG_DEBUG, LOC + QString("%1 abandoned after %2 ms")
+            .arg(EventToString(m_event)).arg(m_timer.elapsed().count()));
+    }
+
+    m_event = Type;
+    m_stages.clear();
+    m_timer.start();
+    m_active = true;
+    LOG(VB_LATENCY, LOG_INFO, LOC + QString("%1 requested").arg(EventToString(Type)));
+}
+
+/// \brief Records reaching the named stage of the start or seek being timed.
+void MythPlaybackTimings::Stage(const QString &Name)
+{
+    if (!m_active)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    if (!m_active)
+        return;
+    std::chrono::milliseconds elapsed = m_timer.elapsed();
+    m_stages.emplace_back(Name, elapsed);
+    LOG(VB_LATENCY, LOG_INFO, LOC + QString("%1 +%2 ms: %3")
+        .arg(EventToString(m_event)).arg(elapsed.count()).arg(Name));
+}
+
+/// \brief Completes the start or seek being timed, if any, as a frame has been shown.
+void MythPlaybackTimings::Displayed(void)
+{
+    if (!m_active)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    if (!m_active)
+        return;
+    m_active = false;
+
+    std::chrono::milliseconds total = m_timer.elapsed();
+    m_stages.emplace_back("FirstFrame", total);
+
+    QStringList stages;
+    std::chrono::milliseconds last = 0ms;
+    for (const auto & stage : m_stages)
+    {
+        stages.append(QString("%1 %2 ms").arg(stage.first).arg((stage.second - last).count()));
+        last = stage.second;
+    }
+    LOG(VB_LATENCY, LOG_INFO, LOC + QString("%1 took %2 ms (%3)")
+        .arg(EventToString(m_event)).arg(total.count()).arg(stages.join(", ")));
+
+    m_lastStages[m_event] = m_stages;
+    AddLocked(m_event, total);
+}
+
+/// \brief Stops timing without recording anything e.g. when playback failed to start.
+void MythPlaybackTimings::Cancel(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_active)
+    {
+        LOG(VB_LATENCY, LOG_INFO, LOC + QString("%1 cancelled after %2 ms")
+            .arg(EventToString(m_event)).arg(m_timer.elapsed().count()));
+    }
+    m_active = false;
+}
+
+/// \brief Adds the total time of a completed start or seek to the history.
+void MythPlaybackTimings::Add(Event Type, std::chrono::milliseconds Total)
+{
+    QMutexLocker locker(&m_lock);
+    AddLocked(Type, Total);
+}
+
+void MythPlaybackTimings::AddLocked(Event Type, std::chrono::milliseconds Total)
+{
+    if (Type >= kEventCount)
+        return;
+    auto & history = m_history[Type];
+    history.push_back(Total);
+    while (history.size() > kHistory)
+        history.pop_front();
+}
+
+/// \brief Returns the statistics of the last kHistory totals for the given event.
+MythPlaybackTimings::Summary MythPlaybackTimings::GetSummary(Event Type)
+{
+    Summary result;
+    QMutexLocker locker(&m_lock);
+    if (Type >= kEventCount || m_history[Type].empty())
+        return result;
+
+    const auto & history = m_history[Type];
+    std::vector<std::chrono::milliseconds> sorted(history.cbegin(), history.cend());
+    std::sort(sorted.begin(), sorted.end());
+    std::chrono::milliseconds sum = 0ms;
+    for (auto total : sorted)
+        sum += total;
+
+    // nearest rank
+    auto percentile = [&sorted](size_t Percent)
+        { return sorted[((Percent * sorted.size()) + 99) / 100 - 1]; };
+
+    result.m_count = sorted.size();
+    result.m_last  = history.back();
+    result.m_min   = sorted.front();
+    result.m_max   = sorted.back();
+    result.m_mean  = sum / static_cast<int>(sorted.size());
+    result.m_p50   = percentile(50);
+    result.m_p90   = percentile(90);
+    result.m_p95   = percentile(95);
+    return result;
+}
+
+/// \brief Returns the time since the request of each stage of the last completed event.
+std::vector<MythPlaybackTimings::StageTime> MythPlaybackTimings::GetLastStages(Event Type)
+{
+    QMutexLocker locker(&m_lock);
+    if (Type >= kEventCount)
+        return {};
+    return m_lastStages[Type];
+}
@@ -0,0 +1,82 @@
+#ifndef MYTHPLAYBACKTIMINGS_H
+#define MYTHPLAYBACKTIMINGS_H
+
+// Qt
+#include <QMutex>
+#include <QString>
+
+// Std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+// MythTV
+#include "mythtimer.h"
+#include "mythtvexp.h"
+
+/*! \class MythPlaybackTimings
+ *  \brief Times playback start up and seeks up to the first frame displayed.
+ *
+ *  Each stage reached along the way is logged, with the time since the
+ *  start or seek was requested, under VB_LATENCY. The totals of the last
+ *  kHistory starts and seeks are kept for the frontend services API.
+ *
+ *  Stages may be marked from any thread. Displayed() is called for every
+ *  frame shown and is cheap when nothing is being timed.
+*/
+class MTV_PUBLIC MythPlaybackTimings
+{
+  public:
+    enum Event : std::uint8_t
+    {
+        kStartup = 0,
+        kSeek,
+        kEventCount
+    };
+
+    struct Summary
+    {
+        size_t m_count { 0 };
+        std::chrono::milliseconds m_last { 0ms };
+        std::chrono::milliseconds m_min  { 0ms };
+        std::chrono::milliseconds m_mean { 0ms };
+        std::chrono::milliseconds m_max  { 0ms };
+        std::chrono::milliseconds m_p50  { 0ms };
+        std::chrono::milliseconds m_p90  { 0ms };
+        std::chrono::milliseconds m_p95  { 0ms };
+    };
+
+    using StageTime = std::pair<QString,std::chrono::milliseconds>;
+
+    static constexpr size_t kHistory { 100 };
+
+    static MythPlaybackTimings& Instance(void);
+    static QString EventToString(Event Type);
+
+    MythPlaybackTimings() = default;
+
+    void        Begin      (Event Type);
+    void        Stage      (const QString &Name);
+    void        Displayed  (void);
+    void        Cancel     (void);
+    void        Add        (Event Type, std::chrono::milliseconds Total);
+    Summary     GetSummary (Event Type);
+    std::vector<StageTime> GetLastStages(Event Type);
+
+  private:
+    Q_DISABLE_COPY(MythPlaybackTimings)
+
+    void AddLocked(Event Type, std::chrono::milliseconds Total);
+
+    QMutex                 m_lock;
+    std::atomic_bool       m_active  { false };
+    Event                  m_event   { kStartup };
+    MythTimer              m_timer;
+    std::vector<StageTime> m_stages;
+    std::array<std::deque<std::chrono::milliseconds>,kEventCount> m_history;
+    std::array<std::vector<StageTime>,kEventCount> m_lastStages;
+};
+
+#endif
@@ -45,6 +45,7 @@
 #include "decoders/mythdecoderthread.h"
 #include "mythvideooutnull.h"
 #include "mythcodeccontext.h"
+#include "mythplaybacktimings.h"
 
 // MythUI headers
 #include <mythmainwindow.h>
@@ -114,6 +115,9 @@ MythPlayer::~MythPlayer(void)
 {
     QMutexLocker lock2(&m_vidExitLock);
 
+    if (!FlagIsSet(kVideoIsNull))
+        MythPlaybackTimings::Instance().Cancel();
+
     SetDecoder(nullptr);
 
     delete m_decoderThread;
@@ -1118,12 +1122,15 @@ void MythPlayer::DecoderLoop(bool pause)
             if (m_decoder)
             {
                 m_decoderSeekLock.lock();
+                m_decoder->SetKeyframesOnly(UseKeyframesOnly());
                 if (((uint64_t)m_decoderSeek < m_framesPlayed) && m_decoder)
                     m_decoder->DoRewind(m_decoderSeek);
                 else if (m_decoder)
                     m_decoder->DoFastForward(m_decoderSeek, !m_transcoding);
                 m_decoderSeek = -1;
                 m_decoderSeekLock.unlock();
+                if (!FlagIsSet(kVideoIsNull))
+                    MythPlaybackTimings::Instance().Stage("SeekDone");
             }
             m_decoderChangeLock.unlock();
         }
@@ -1222,6 +1229,7 @@ bool MythPlayer::DecoderGetFrame(DecodeType decodetype, bool unsafe)
         return false;
     }
 
+    m_decoder->SetKeyframesOnly(UseKeyframesOnly());
     if (m_ffrewSkip == 1 || m_decodeOneFrame)
         ret = DoGetFrame(decodetype);
     else if (m_ffrewSkip != 0)
@@ -1342,6 +1350,22 @@ bool MythPlayer::UpdateFFRewSkip(void)
     return skip_changed;
 }
 
+/*! \brief Returns true if fast forward and rewind should only decode keyframes.
+ *
+ * Once at least a keyframe interval is skipped for every frame shown, the
+ * frames between keyframes are decoded for nothing. Only decoding the
+ * keyframes, and seeking straight to them, keeps high speeds responsive.
+ */
+bool MythPlayer::UseKeyframesOnly(void) const
+{
+    if (m_ffrewSkip == 0 || m_ffrewSkip == 1 || m_decodeOneFrame)
+        return false;
+    // Discs have their own idea of how to fast forward and rewind
+    if (!m_playerCtx->m_buffer || m_playerCtx->m_buffer->IsDisc())
+        return false;
+    return static_cast<uint>(std::abs(m_ffrewSkip)) >= m_keyframeDist;
+}
+
 void MythPlayer::ChangeSpeed(void)
 {
     float last_speed = m_playSpeed;
@@ -1612,6 +1636,9 @@ void MythPlayer::WaitForSeek(uint64_t frame, uint64_t seeksnap_wanted)
     if (frame >= max)
         frame = max - 1;
 
+    if (!FlagIsSet(kVideoIsNull))
+        MythPlaybackTimings::Instance().Begin(MythPlaybackTimings::kSeek);
+
     m_decoderSeekLock.lock();
     m_decoderSeek = frame;
     m_decoderSeekLock.unlock();
@@ -344,6 +344,7 @@ class MTV_PUBLIC MythPlayer : public QObject
 
     // These actually execute commands requested by public members
     bool UpdateFFRewSkip(void);
+    bool UseKeyframesOnly(void) const;
     virtual void ChangeSpeed(void);
     // The "inaccuracy" argument is generally one of the kInaccuracy* values.
     bool DoFastForward(uint64_t frames, double inaccuracy);
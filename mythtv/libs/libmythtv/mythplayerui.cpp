@@ -11,6 +11,7 @@
 #include "interactivescreen.h"
 #include "tv_play.h"
 #include "livetvchain.h"
+#include "mythplaybacktimings.h"
 #include "mythplayerui.h"
 
 #define LOC QString("PlayerUI: ")
@@ -76,6 +77,7 @@ bool MythPlayerUI::StartPlaying()
         m_audio.DeleteOutput();
         return false;
     }
+    MythPlaybackTimings::Instance().Stage("VideoInitialised");
 
     EventStart();
     DecoderStart(true);
@@ -636,12 +638,17 @@ void MythPlayerUI::DisplayPauseFrame()
     // clear the buffering state
     SetBuffering(false);
 
+    bool newframe = m_needNewPauseFrame;
     RefreshPauseFrame();
     PreProcessNormalFrame(); // Allow interactiveTV to draw on pause frame
 
     FrameScanType scan = GetScanType();
     scan = (kScan_Detect == scan || kScan_Ignore == scan) ? kScan_Progressive : scan;
     RenderVideoFrame(nullptr, scan, true, 0ms);
+
+    // e.g. the frame seeked to while paused
+    if (newframe && !m_needNewPauseFrame)
+        MythPlaybackTimings::Instance().Displayed();
 }
 
 void MythPlayerUI::DisplayNormalFrame(bool CheckPrebuffer)
@@ -690,6 +697,8 @@ void MythPlayerUI::DisplayNormalFrame(bool CheckPrebuffer)
     // Display it
     DoDisplayVideoFrame(frame, due);
     m_videoOutput->DoneDisplayingFrame(frame);
+    if (due >= 0us)
+        MythPlaybackTimings::Instance().Displayed();
     m_outputJmeter.RecordCycleTime();
 }
 
@@ -820,7 +829,11 @@ void MythPlayerUI::GetPlaybackData(InfoMap& Map)
         Map.insert("videoframes", frames);
     }
     if (m_decoder)
+    {
         Map["videodecoder"] = m_decoder->GetCodecDecoderName();
+        QString demux = m_decoder->GetDemuxQueueDepth();
+        Map["demuxqueue"] = demux.isEmpty() ? tr("Off") : demux;
+    }
 
     Map["framerate"] = QString("%1%2%3")
             .arg(static_cast<double>(m_outputJmeter.GetLastFPS()), 0, 'f', 2).arg(QChar(0xB1, 0))
@@ -68,7 +68,6 @@ ExternIO::~ExternIO(void)
     close(m_appErr);
 
     // waitpid(m_pid, &status, 0);
-    delete[] m_buffer;
 }
 
 bool ExternIO::Ready(int fd, std::chrono::milliseconds timeout, const QString & what)
@@ -116,14 +115,12 @@ int ExternIO::Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds ti
     if (!Ready(m_appOut, timeout, "data"))
         return 0;
 
-    if (m_bufSize < maxlen)
-    {
-        m_bufSize = maxlen;
-        delete [] m_buffer;
-        m_buffer = new char[m_bufSize];
-    }
+    // Read straight into the tail of the caller's buffer, rather than
+    // into a scratch buffer which then has to be appended.
+    int oldsize = buffer.size();
+    buffer.resize(oldsize + maxlen);
 
-    int len = read(m_appOut, m_buffer, maxlen);
+    int len = read(m_appOut, buffer.data() + oldsize, maxlen);
 
     if (len < 0)
     {
@@ -152,10 +149,13 @@ int ExternIO::Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds ti
     else
         m_errCnt = 0;
 
-    if (len == 0)
+    if (len <= 0)
+    {
+        buffer.resize(oldsize);
         return 0;
+    }
 
-    buffer.append(m_buffer, len);
+    buffer.resize(oldsize + len);
 
     LOG(VB_RECORD, LOG_DEBUG,
         QString("ExternIO::Read '%1' bytes, buffer size %2")
@@ -368,6 +368,16 @@ void ExternIO::Fork(void)
         error |= (fcntl(m_appOut, F_SETFL, O_NONBLOCK) == -1);
         error |= (fcntl(m_appErr, F_SETFL, O_NONBLOCK) == -1);
 
+#ifdef F_SETPIPE_SZ
+        // A larger pipe lets the recorder write a whole read's worth of
+        // data before we wake up, instead of 64KiB at a time.
+        if (fcntl(m_appOut, F_SETPIPE_SZ, kPipeSize) == -1)
+        {
+            LOG(VB_RECORD, LOG_INFO,
+                "ExternIO::Fork(): Unable to grow data pipe: " + ENO);
+        }
+#endif
+
         if (error)
         {
             LOG(VB_GENERAL, LOG_WARNING,
@@ -576,6 +586,8 @@ void ExternalStreamHandler::run(void)
     QString    result;
     QString    ready_cmd;
     QByteArray buffer;
+    // Keep the allocation stable so ExternIO::Read() can read in place.
+    buffer.reserve(PACKET_SIZE + TOO_FAST_SIZE);
     int        sz = 0;
     uint       len = 0;
     uint       read_len = 0;
@@ -813,7 +825,8 @@ void ExternalStreamHandler::run(void)
 
         if (remainder == 0)
         {
-            buffer.clear();
+            // clear() would release the reserved allocation
+            buffer.resize(0);
             good_data = (len != 0U);
         }
         else if (len > remainder) // leftover bytes
@@ -18,7 +18,8 @@ class ExternalChannel;
 
 class ExternIO
 {
-    enum constants { kMaxErrorCnt = 20 };
+    enum constants { kMaxErrorCnt = 20,
+                     kPipeSize    = 1024 * 1024 };
 
   public:
     ExternIO(const QString & app, const QStringList & args);
@@ -46,9 +47,6 @@ class ExternIO
     pid_t       m_pid     {-1};
     QString     m_error;
 
-    int         m_bufSize {0};
-    char       *m_buffer  {nullptr};
-
     QString     m_statusBuf;
     QTextStream m_status;
     int         m_errCnt  {0};
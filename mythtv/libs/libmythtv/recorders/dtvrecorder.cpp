@@ -52,6 +52,7 @@ DTVRecorder::DTVRecorder(TVRec *rec) :
 {
     SetPositionMapType(MARK_GOP_BYFRAME);
     m_payloadBuffer.reserve(TSPacket::kSize * (50 + 1));
+    m_writeBlock.reserve(kWriteBlockSize * 2);
 
     DTVRecorder::ResetForNewFile();
 
@@ -123,6 +124,8 @@ void DTVRecorder::SetOptionsFromProfile(RecordingProfile *profile,
  */
 void DTVRecorder::FinishRecording(void)
 {
+    FlushWriteBlock();
+
     if (m_ringBuffer)
         m_ringBuffer->WriterFlush();
 
@@ -211,6 +214,7 @@ void DTVRecorder::Reset(void)
         m_curRecording->ClearPositionMap(MARK_GOP_BYFRAME);
         m_curRecording->ClearPositionMap(MARK_DURATION_MS);
     }
+    ResetSeekIndex();
 }
 
 void DTVRecorder::SetStreamData(MPEGStreamData *data)
@@ -310,14 +314,58 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
         // we have to write them first...
         if (!m_payloadBuffer.empty())
         {
-            if (m_ringBuffer)
-                m_ringBuffer->Write(&m_payloadBuffer[0], m_payloadBuffer.size());
+            CoalescedWrite(m_payloadBuffer.data(), m_payloadBuffer.size());
             m_payloadBuffer.clear();
         }
     }
 
-    if (m_ringBuffer && m_ringBuffer->Write(tspacket.data(), TSPacket::kSize) < 0 &&
-        m_curRecording && m_curRecording->GetRecordingStatus() != RecStatus::Failing)
+    CoalescedWrite(tspacket.data(), TSPacket::kSize);
+}
+
+/** \brief Gathers data into m_writeBlock, so the ringbuffer (and its
+ *         ThreadedFileWriter locks) is called once per block rather than
+ *         once per TS packet.
+ *
+ *  The block is handed over when it is full, or when it has been held
+ *  for kWriteBlockMaxAge so low bitrate LiveTV is not delayed.
+ */
+void DTVRecorder::CoalescedWrite(const unsigned char *data, uint len)
+{
+    if (!m_ringBuffer || !len)
+        return;
+
+    if (m_writeBlock.empty())
+    {
+        if (len >= kWriteBlockSize)
+        {
+            m_writeBlock.assign(data, data + len);
+            FlushWriteBlock();
+            return;
+        }
+        m_writeBlockTimer.start();
+    }
+
+    m_writeBlock.insert(m_writeBlock.end(), data, data + len);
+
+    if (m_writeBlock.size() >= kWriteBlockSize ||
+        m_writeBlockTimer.elapsed() > kWriteBlockMaxAge)
+    {
+        FlushWriteBlock();
+    }
+}
+
+void DTVRecorder::FlushWriteBlock(void)
+{
+    if (m_writeBlock.empty())
+        return;
+
+    int ret = 0;
+    if (m_ringBuffer)
+        ret = m_ringBuffer->Write(m_writeBlock.data(), m_writeBlock.size());
+    m_writeBlock.clear();
+
+    if (ret < 0 && m_curRecording &&
+        m_curRecording->GetRecordingStatus() != RecStatus::Failing)
     {
         LOG(VB_GENERAL, LOG_INFO, LOC +
             QString("BufferedWrite: Writes are failing, "
@@ -327,6 +375,14 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
     }
 }
 
+/** \brief Returns the file position the next byte handed to
+ *         CoalescedWrite() will be written at.
+ */
+int64_t DTVRecorder::GetWritePosition(void) const
+{
+    return m_ringBuffer->GetWritePosition() + m_writeBlock.size();
+}
+
 enum { kExtractPTS, kExtractDTS };
 static int64_t extract_timestamp(
     const uint8_t *bufptr, int bytes_left, int pts_or_dts)
@@ -548,9 +604,9 @@ bool DTVRecorder::FindMPEG2Keyframes(const TSPacket* tspacket)
     {
         LOG(VB_RECORD, LOG_DEBUG, LOC + QString
             ("Keyframe @ %1 + %2 = %3")
-            .arg(m_ringBuffer->GetWritePosition())
+            .arg(GetWritePosition())
             .arg(m_payloadBuffer.size())
-            .arg(m_ringBuffer->GetWritePosition() + m_payloadBuffer.size()));
+            .arg(GetWritePosition() + m_payloadBuffer.size()));
 
         m_lastKeyframeSeen = m_framesSeenCount;
         HandleKeyframe(0);
@@ -560,9 +616,9 @@ bool DTVRecorder::FindMPEG2Keyframes(const TSPacket* tspacket)
     {
         LOG(VB_RECORD, LOG_DEBUG, LOC + QString
             ("Frame @ %1 + %2 = %3")
-            .arg(m_ringBuffer->GetWritePosition())
+            .arg(GetWritePosition())
             .arg(m_payloadBuffer.size())
-            .arg(m_ringBuffer->GetWritePosition() + m_payloadBuffer.size()));
+            .arg(GetWritePosition() + m_payloadBuffer.size()));
 
         m_bufferPackets = false;  // We now know if it is a keyframe, or not
         m_framesSeenCount++;
@@ -802,7 +858,7 @@ void DTVRecorder::HandleKeyframe(int64_t extra)
     m_positionMapLock.lock();
     if (!m_positionMap.contains(frameNum))
     {
-        int64_t startpos = m_ringBuffer->GetWritePosition() + extra;
+        int64_t startpos = GetWritePosition() + extra;
 
         // Don't put negative offsets into the database, they get munged into
         // MAX_INT64 - offset, which is an exceedingly large number, and
@@ -933,7 +989,7 @@ bool DTVRecorder::FindH2645Keyframes(const TSPacket *tspacket)
         // scan the NAL units
         uint32_t bytes_used = m_h2645Parser->addBytes
                               (tspacket->data() + i, TSPacket::kSize - i,
-                               m_ringBuffer->GetWritePosition());
+                               GetWritePosition());
         i += (bytes_used - 1);
 
         if (m_h2645Parser->stateChanged())
@@ -970,9 +1026,9 @@ bool DTVRecorder::FindH2645Keyframes(const TSPacket *tspacket)
     {
         LOG(VB_RECORD, LOG_DEBUG, LOC + QString
             ("Keyframe @ %1 + %2 = %3 AU %4")
-            .arg(m_ringBuffer->GetWritePosition())
+            .arg(GetWritePosition())
             .arg(m_payloadBuffer.size())
-            .arg(m_ringBuffer->GetWritePosition() + m_payloadBuffer.size())
+            .arg(GetWritePosition() + m_payloadBuffer.size())
             .arg(m_h2645Parser->keyframeAUstreamOffset()));
 
         m_lastKeyframeSeen = m_framesSeenCount;
@@ -983,9 +1039,9 @@ bool DTVRecorder::FindH2645Keyframes(const TSPacket *tspacket)
     {
         LOG(VB_RECORD, LOG_DEBUG, LOC + QString
             ("Frame @ %1 + %2 = %3 AU %4")
-            .arg(m_ringBuffer->GetWritePosition())
+            .arg(GetWritePosition())
             .arg(m_payloadBuffer.size())
-            .arg(m_ringBuffer->GetWritePosition() + m_payloadBuffer.size())
+            .arg(GetWritePosition() + m_payloadBuffer.size())
             .arg(m_h2645Parser->keyframeAUstreamOffset()));
 
         m_bufferPackets = false;  // We now know if this is a keyframe
@@ -1219,16 +1275,11 @@ void DTVRecorder::FindPSKeyFrames(const uint8_t *buffer, uint len)
             // buffered packet[s] we have to write them first...
             if (!m_payloadBuffer.empty())
             {
-                if (m_ringBuffer)
-                {
-                    m_ringBuffer->Write(
-                        &m_payloadBuffer[0], m_payloadBuffer.size());
-                }
+                CoalescedWrite(m_payloadBuffer.data(), m_payloadBuffer.size());
                 m_payloadBuffer.clear();
             }
 
-            if (m_ringBuffer)
-                m_ringBuffer->Write(bufstart, (bufptr - bufstart));
+            CoalescedWrite(bufstart, (bufptr - bufstart));
 
             bufstart = bufptr;
         }
@@ -1552,8 +1603,7 @@ bool DTVRecorder::ProcessVideoTSPacket(const TSPacket &tspacket)
         if (m_bufferPackets && m_firstKeyframe >= 0 && !m_payloadBuffer.empty())
         {
             // Flush the buffer
-            if (m_ringBuffer)
-                m_ringBuffer->Write(&m_payloadBuffer[0], m_payloadBuffer.size());
+            CoalescedWrite(m_payloadBuffer.data(), m_payloadBuffer.size());
             m_payloadBuffer.clear();
         }
 
@@ -1584,8 +1634,7 @@ bool DTVRecorder::ProcessAudioTSPacket(const TSPacket &tspacket)
         if (m_bufferPackets && m_firstKeyframe >= 0 && !m_payloadBuffer.empty())
         {
             // Flush the buffer
-            if (m_ringBuffer)
-                m_ringBuffer->Write(&m_payloadBuffer[0], m_payloadBuffer.size());
+            CoalescedWrite(m_payloadBuffer.data(), m_payloadBuffer.size());
             m_payloadBuffer.clear();
         }
 
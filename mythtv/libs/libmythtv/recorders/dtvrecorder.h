@@ -101,6 +101,9 @@ class DTVRecorder :
     void UpdateFramesWritten(void);
 
     void BufferedWrite(const TSPacket &tspacket, bool insert = false);
+    void CoalescedWrite(const unsigned char *data, uint len);
+    void FlushWriteBlock(void);
+    int64_t GetWritePosition(void) const;
 
     // MPEG TS "audio only" support
     bool FindAudioKeyframes(const TSPacket *tspacket);
@@ -165,6 +168,12 @@ class DTVRecorder :
     bool                     m_bufferPackets              {false};
     std::vector<unsigned char> m_payloadBuffer;
 
+    // write coalescing buffer, handed to the ringbuffer in large blocks
+    static constexpr uint    kWriteBlockSize              {TSPacket::kSize * 128};
+    static constexpr std::chrono::milliseconds kWriteBlockMaxAge {100ms};
+    std::vector<unsigned char> m_writeBlock;
+    MythTimer                m_writeBlockTimer;
+
     // general recorder stuff
     mutable QMutex           m_pidLock                    {QMutex::Recursive};
                              /// PAT on input side
@@ -262,8 +262,7 @@ void DVBStreamHandler::RunTS(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
+        remainder = DemuxData(buffer, len);
 
         WriteMPTS(buffer, len - remainder);
 
@@ -20,6 +20,7 @@
 #include "mythsystemevent.h"
 #include "mythlogging.h"
 #include "programinfo.h"
+#include "recordingseekindex.h"
 #include "asichannel.h"
 #include "dtvchannel.h"
 #include "dvbchannel.h"
@@ -48,10 +49,13 @@ RecorderBase::RecorderBase(TVRec *rec)
     : m_tvrec(rec)
 {
     RecorderBase::ClearStatistics();
+
+    m_seekIndexDBMirror = gCoreContext->GetBoolSetting("SeekIndexDBMirror", true);
 }
 
 RecorderBase::~RecorderBase(void)
 {
+    delete m_seekIndex;
     if (m_weMadeBuffer && m_ringBuffer)
     {
         delete m_ringBuffer;
@@ -618,9 +622,16 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
             m_durationMapDelta.clear();
             m_positionMapLock.unlock();
 
-            m_curRecording->SavePositionMapDelta(deltaCopy, m_positionMapType);
-            m_curRecording->SavePositionMapDelta(durationDeltaCopy,
-                                               MARK_DURATION_MS);
+            // The database copy is still needed by remote frontends and
+            // tools which do not read the seek index.
+            if (!SaveSeekIndex(deltaCopy, durationDeltaCopy) ||
+                m_seekIndexDBMirror)
+            {
+                m_curRecording->SavePositionMapDelta(deltaCopy,
+                                                     m_positionMapType);
+                m_curRecording->SavePositionMapDelta(durationDeltaCopy,
+                                                     MARK_DURATION_MS);
+            }
 
             TryWriteProgStartMark(durationDeltaCopy);
         }
@@ -652,6 +663,42 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     }
 }
 
+/** \brief Appends the keyframes to the seek index next to the file
+ *         currently being written, creating it for a new file.
+ */
+bool RecorderBase::SaveSeekIndex(const frm_pos_map_t &posMap,
+                                 const frm_pos_map_t &durMap)
+{
+    QMutexLocker locker(&m_seekIndexLock);
+
+    if (!m_ringBuffer)
+        return false;
+
+    QString filename = m_ringBuffer->GetFilename();
+    if (filename != m_seekIndexRecording)
+    {
+        if (!m_seekIndex)
+            m_seekIndex = new RecordingSeekIndex();
+        m_seekIndexRecording = filename;
+        if (!m_seekIndex->Create(filename, m_positionMapType))
+        {
+            LOG(VB_RECORD, LOG_WARNING, LOC +
+                QString("Unable to create seek index for '%1'")
+                .arg(filename));
+        }
+    }
+
+    return m_seekIndex->IsOpen() && m_seekIndex->Append(posMap, durMap);
+}
+
+void RecorderBase::ResetSeekIndex(void)
+{
+    QMutexLocker locker(&m_seekIndexLock);
+    if (m_seekIndex)
+        m_seekIndex->Close();
+    m_seekIndexRecording.clear();
+}
+
 void RecorderBase::TryWriteProgStartMark(const frm_pos_map_t &durationDeltaCopy)
 {
     // Note: all log strings contain "progstart mark" for searching.
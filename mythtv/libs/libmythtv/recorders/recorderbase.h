@@ -26,6 +26,7 @@ extern "C"
 class FireWireDBOptions;
 class GeneralDBOptions;
 class RecordingProfile;
+class RecordingSeekIndex;
 class RecordingInfo;
 class DVBDBOptions;
 class RecorderBase;
@@ -236,10 +237,14 @@ class MTV_PUBLIC RecorderBase : public QRunnable
      */
     virtual bool CheckForRingBufferSwitch(void);
 
-    /** \brief Save the seektable to the DB
+    /** \brief Save the seektable to the seek index file and the DB
      */
     void SavePositionMap(bool force = false, bool finished = false);
 
+    /** \brief Start a new seek index file on the next SavePositionMap()
+     */
+    void ResetSeekIndex(void);
+
     enum AspectRatio {
         ASPECT_UNKNOWN       = 0x00,
         ASPECT_1_1           = 0x01,
@@ -310,6 +315,8 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     void SetTotalFrames(uint64_t total_frames);
 
     void TryWriteProgStartMark(const frm_pos_map_t &durationDeltaCopy);
+    bool SaveSeekIndex(const frm_pos_map_t &posMap,
+                       const frm_pos_map_t &durMap);
 
     TVRec         *m_tvrec                {nullptr};
     MythMediaBuffer *m_ringBuffer         {nullptr};
@@ -360,6 +367,10 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     frm_pos_map_t  m_durationMap;
     frm_pos_map_t  m_durationMapDelta;
     MythTimer      m_positionMapTimer;
+    QMutex         m_seekIndexLock;
+    RecordingSeekIndex *m_seekIndex       {nullptr};
+    QString        m_seekIndexRecording;
+    bool           m_seekIndexDBMirror    {true};
 
     // ProgStart mark support
     qint64         m_estimatedProgStartMS {0};
@@ -66,6 +66,7 @@ void StreamHandler::AddListener(MPEGStreamData *data,
     }
 
     m_streamDataList[data] = output_file;
+    m_routesDirty = true;
 
     m_listenerLock.unlock();
 
@@ -101,6 +102,7 @@ void StreamHandler::RemoveListener(MPEGStreamData *data)
         if (!(*it).isEmpty())
             RemoveNamedOutputFile(*it);
         m_streamDataList.erase(it);
+        m_routesDirty = true;
     }
 
     m_listenerLock.unlock();
@@ -346,6 +348,127 @@ PIDPriority StreamHandler::GetPIDPriority(uint pid) const
     return tmp;
 }
 
+/** \brief Routes the TS packets in buffer to the listeners.
+ *
+ *  Instead of handing the whole buffer to every listener, each of
+ *  which would then resync and look up every packet of the mux, the
+ *  buffer is scanned once and each packet is passed by reference to
+ *  just the listeners that asked for its PID. Listeners on PID 0x2000
+ *  receive every packet.
+ *
+ *  \note The _listener_lock must be held when this is called.
+ *  \return number of bytes at the end of buffer that were not used.
+ */
+int StreamHandler::DemuxData(const unsigned char *buffer, int len)
+{
+    if (m_routesDirty || PIDRoutesChanged())
+        UpdatePIDRoutes();
+
+    if (m_routeListeners.size() > kMaxRoutedListeners)
+    {
+        int remainder = 0;
+        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
+            remainder = sit.key()->ProcessData(buffer, len);
+        return remainder;
+    }
+
+    int pos = 0;
+    bool resync = false;
+
+    while (pos + int(TSPacket::kSize) <= len)
+    { // while we have a whole packet left...
+        if (buffer[pos] != SYNC_BYTE || resync)
+        {
+            int newpos = MPEGStreamData::ResyncStream(buffer, pos+1, len);
+            LOG(VB_RECORD, LOG_DEBUG, LOC +
+                QString("Resyncing @ %1+1 w/len %2 -> %3")
+                .arg(pos).arg(len).arg(newpos));
+            if (newpos == -1)
+                return len - pos;
+            if (newpos == -2)
+                return TSPacket::kSize;
+            pos = newpos;
+        }
+
+        const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
+        pos += TSPacket::kSize; // Advance to next TS packet
+        resync = false;
+
+        uint32_t routes = m_pidRoutes[pkt->PID()] | m_routeAllMask;
+        for (uint i = 0; routes != 0U; ++i, routes >>= 1)
+        {
+            if ((routes & 1U) != 0U)
+                m_routeListeners[i]->ProcessTSPacket(*pkt);
+        }
+
+        // Table handling may have added or removed PIDs
+        if (PIDRoutesChanged())
+            UpdatePIDRoutes();
+
+        if (pkt->TransportError() &&
+            (pos + int(TSPacket::kSize) <= len) && (buffer[pos] != SYNC_BYTE))
+        {
+            // if the packet was bad, and we don't appear to be in sync
+            // on the next packet, then resync.
+            pos -= TSPacket::kSize;
+            resync = true;
+        }
+    }
+
+    return len - pos;
+}
+
+bool StreamHandler::PIDRoutesChanged(void) const
+{
+    for (size_t i = 0; i < m_routeListeners.size(); ++i)
+    {
+        if (m_routeListeners[i]->GetPIDMapGeneration() != m_routeGenerations[i])
+            return true;
+    }
+    return false;
+}
+
+/** \brief Merges the PID interests of all listeners into m_pidRoutes.
+ *  \note The _listener_lock must be held when this is called.
+ */
+void StreamHandler::UpdatePIDRoutes(void)
+{
+    m_routeListeners.clear();
+    m_routeGenerations.clear();
+    m_pidRoutes.fill(0);
+    m_routeAllMask = 0;
+    m_routesDirty = false;
+
+    for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
+    {
+        MPEGStreamData *sd = sit.key();
+        uint idx = m_routeListeners.size();
+        m_routeListeners.push_back(sd);
+        // Read the generation first, so a concurrent change forces a rebuild
+        m_routeGenerations.push_back(sd->GetPIDMapGeneration());
+
+        if (idx >= kMaxRoutedListeners)
+            continue;
+
+        pid_map_t pids;
+        sd->GetPIDs(pids);
+        for (auto it = pids.cbegin(); it != pids.cend(); ++it)
+        {
+            if (it.key() < 0x2000)
+                m_pidRoutes[it.key()] |= (1U << idx);
+            else
+                m_routeAllMask |= (1U << idx);
+        }
+    }
+
+    if (m_routeListeners.size() > kMaxRoutedListeners)
+    {
+        LOG(VB_RECORD, LOG_WARNING, LOC +
+            QString("%1 listeners, not using PID routing")
+                .arg(m_routeListeners.size()));
+    }
+}
+
 void StreamHandler::WriteMPTS(const unsigned char * buffer, uint len)
 {
     if (m_mptsTfw == nullptr)
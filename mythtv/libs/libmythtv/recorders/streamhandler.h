@@ -3,6 +3,7 @@
 #ifndef STREAM_HANDLER_H
 #define STREAM_HANDLER_H
 
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -90,6 +91,10 @@ class StreamHandler : protected MThread, public DeviceReaderCB
 
     PIDPriority GetPIDPriority(uint pid) const;
 
+    int  DemuxData(const unsigned char *buffer, int len);
+    bool PIDRoutesChanged(void) const;
+    void UpdatePIDRoutes(void);
+
     // DeviceReaderCB
     void ReaderPaused(int fd) override { (void) fd; } // DeviceReaderCB
     void PriorityEvent(int fd) override { (void) fd; } // DeviceReaderCB
@@ -140,6 +145,14 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     using StreamDataList = QHash<MPEGStreamData*,QString>;
     mutable QMutex      m_listenerLock         {QMutex::Recursive};
     StreamDataList      m_streamDataList;
+
+    // PID routing table used by DemuxData(), protected by _listener_lock
+    static constexpr uint kMaxRoutedListeners  {32};
+    std::vector<MPEGStreamData*> m_routeListeners;
+    std::vector<uint>   m_routeGenerations;
+    std::array<uint32_t,0x2000> m_pidRoutes    {};
+    uint32_t            m_routeAllMask         {0};
+    bool                m_routesDirty          {true};
 };
 
 #endif // STREAM_HANDLER_H
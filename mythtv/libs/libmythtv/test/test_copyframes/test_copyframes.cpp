@@ -251,4 +251,33 @@ void TestCopyFrames::TestCopy()
     }
 }
 
+void TestCopyFrames::TestCopyLarge()
+{
+    // Large planes are copied in bands - check every row, not just the first
+    for (auto type : { FMT_YV12, FMT_P010 })
+    {
+        auto * from = new MythVideoFrame(type, 3840, 2160);
+        auto * to   = new MythVideoFrame(type, 3840, 2160);
+        QVERIFY(from->m_buffer && to->m_buffer);
+        for (size_t i = 0; i < from->m_bufferSize; ++i)
+            from->m_buffer[i] = MythRandom() & 0xFF;
+
+        QVERIFY(to->CopyFrame(from));
+        uint count = MythVideoFrame::GetNumPlanes(type);
+        for (uint plane = 0; plane < count; ++plane)
+        {
+            int width  = MythVideoFrame::GetPitchForPlane(type, from->m_width, plane);
+            int height = MythVideoFrame::GetHeightForPlane(type, from->m_height, plane);
+            for (int row = 0; row < height; ++row)
+            {
+                QVERIFY(memcmp(to->m_buffer + to->m_offsets[plane] + (row * to->m_pitches[plane]),
+                               from->m_buffer + from->m_offsets[plane] + (row * from->m_pitches[plane]),
+                               static_cast<size_t>(width)) == 0);
+            }
+        }
+        delete from;
+        delete to;
+    }
+}
+
 QTEST_APPLESS_MAIN(TestCopyFrames)
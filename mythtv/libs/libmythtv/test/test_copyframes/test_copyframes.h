@@ -31,4 +31,5 @@ class TestCopyFrames : public QObject
     static void TestInvalidSizes();
     static void TestInvalidBuffers();
     static void TestCopy();
+    static void TestCopyLarge();
 };
@@ -0,0 +1,86 @@
+#include "test_deinterlacer.h"
+#include "mythframe.h"
+#include "mythdeinterlacer.h"
+
+static MythVideoFrame* CreateFrame(VideoFrameType Type, int Width, int Height)
+{
+    size_t size = MythVideoFrame::GetBufferSize(Type, Width, Height);
+    auto *frame = new MythVideoFrame(Type, MythVideoFrame::GetAlignedBuffer(size),
+                                     size, Width, Height);
+    frame->m_deinterlaceAllowed = DEINT_ALL;
+    frame->m_deinterlaceDouble  = DEINT_MEDIUM | DEINT_CPU;
+    return frame;
+}
+
+static void FillFrame(MythVideoFrame *Frame)
+{
+    for (size_t i = 0; i < Frame->m_bufferSize; ++i)
+        Frame->m_buffer[i] = static_cast<uint8_t>((i * 7) ^ (i >> 11));
+}
+
+// Deinterlace both fields, as the player does for double rate
+static void DeinterlaceFields(MythDeinterlacer &Deint, MythVideoFrame *Frame,
+                              MythVideoFrame *First = nullptr)
+{
+    Frame->m_alreadyDeinterlaced = false;
+    Deint.Filter(Frame, kScan_Interlaced, nullptr);
+    if (First)
+        memcpy(First->m_buffer, Frame->m_buffer, Frame->m_bufferSize);
+    Frame->m_alreadyDeinterlaced = false;
+    Deint.Filter(Frame, kScan_Intr2ndField, nullptr);
+}
+
+void TestDeinterlacer::TestSliced()
+{
+    // Slices must produce exactly the same output as a single thread,
+    // including odd plane heights that do not split evenly
+    for (int height : { 1080, 576, 484 })
+    {
+        MythVideoFrame *single  = CreateFrame(FMT_YV12, 720, height);
+        MythVideoFrame *sliced  = CreateFrame(FMT_YV12, 720, height);
+        MythVideoFrame *single1 = CreateFrame(FMT_YV12, 720, height);
+        MythVideoFrame *sliced1 = CreateFrame(FMT_YV12, 720, height);
+        FillFrame(single);
+        FillFrame(sliced);
+
+        MythDeinterlacer deint1(1);
+        MythDeinterlacer deint3(3);
+        DeinterlaceFields(deint1, single, single1);
+        DeinterlaceFields(deint3, sliced, sliced1);
+
+        QVERIFY(memcmp(single1->m_buffer, sliced1->m_buffer, single->m_bufferSize) == 0);
+        QVERIFY(memcmp(single->m_buffer, sliced->m_buffer, single->m_bufferSize) == 0);
+
+        delete single;
+        delete sliced;
+        delete single1;
+        delete sliced1;
+    }
+}
+
+void TestDeinterlacer::BenchmarkBlend_data()
+{
+    QTest::addColumn<uint>("threads");
+    QTest::newRow("1 thread")  << 1U;
+    QTest::newRow("2 threads") << 2U;
+    QTest::newRow("4 threads") << 4U;
+}
+
+void TestDeinterlacer::BenchmarkBlend()
+{
+    QFETCH(uint, threads);
+
+    MythVideoFrame *frame = CreateFrame(FMT_YV12, 1920, 1080);
+    FillFrame(frame);
+    MythDeinterlacer deint(threads);
+
+    // 2x Linearblend of one 1080i frame
+    QBENCHMARK
+    {
+        DeinterlaceFields(deint, frame);
+    }
+
+    delete frame;
+}
+
+QTEST_APPLESS_MAIN(TestDeinterlacer)
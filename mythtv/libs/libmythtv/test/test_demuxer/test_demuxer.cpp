@@ -0,0 +1,208 @@
+#include "test_demuxer.h"
+#include "decoders/mythdemuxer.h"
+
+// Std
+#include <atomic>
+#include <thread>
+
+static constexpr int kPacketSize { 1000 };
+static constexpr std::chrono::milliseconds kPacketDuration { 40ms };
+
+/// Reads numbered packets of kPacketSize bytes and kPacketDuration
+static MythDemuxer::ReadCallback Reader(std::atomic<int> &Count)
+{
+    return [&Count](AVPacket *Packet, std::chrono::milliseconds &Duration)
+    {
+        int result = av_new_packet(Packet, kPacketSize);
+        if (result < 0)
+            return result;
+        Packet->pts = Count++;
+        Packet->stream_index = 0;
+        Duration = kPacketDuration;
+        return 0;
+    };
+}
+
+/// Waits for the demuxer to queue Packets packets
+static bool WaitForQueue(MythDemuxer &Demuxer, size_t Packets)
+{
+    size_t packets = 0;
+    size_t bytes = 0;
+    std::chrono::milliseconds duration = 0ms;
+    for (int i = 0; i < 500; i++)
+    {
+        Demuxer.GetQueueDepth(packets, bytes, duration);
+        if (packets >= Packets)
+            return packets == Packets;
+        std::this_thread::sleep_for(2ms);
+    }
+    return false;
+}
+
+void TestDemuxer::TestLimits()
+{
+    std::atomic<int> count { 0 };
+    AVPacket *packet = av_packet_alloc();
+    bool changed = false;
+
+    // Limited by duration
+    {
+        MythDemuxer demuxer(Reader(count), 100 * kPacketSize, 10 * kPacketDuration);
+        demuxer.start();
+        QVERIFY(WaitForQueue(demuxer, 10));
+        std::this_thread::sleep_for(20ms);
+        QCOMPARE(count.load(), 10);
+
+        QCOMPARE(demuxer.Take(packet, changed), 0);
+        QCOMPARE(packet->pts, static_cast<int64_t>(0));
+        QCOMPARE(packet->size, kPacketSize);
+        QVERIFY(!changed);
+        QVERIFY(WaitForQueue(demuxer, 10));
+        QCOMPARE(count.load(), 11);
+    }
+
+    // Limited by size
+    {
+        count = 0;
+        MythDemuxer demuxer(Reader(count), 5 * kPacketSize, 10s);
+        demuxer.start();
+        QVERIFY(WaitForQueue(demuxer, 5));
+        size_t packets = 0;
+        size_t bytes = 0;
+        std::chrono::milliseconds duration = 0ms;
+        demuxer.GetQueueDepth(packets, bytes, duration);
+        QCOMPARE(bytes, static_cast<size_t>(5 * kPacketSize));
+        QCOMPARE(duration.count(), (5 * kPacketDuration).count());
+    }
+
+    av_packet_free(&packet);
+}
+
+void TestDemuxer::TestFlush()
+{
+    std::atomic<int> count { 0 };
+    AVPacket *packet = av_packet_alloc();
+    bool changed = false;
+
+    MythDemuxer demuxer(Reader(count), 100 * kPacketSize, 10 * kPacketDuration);
+    demuxer.start();
+    QVERIFY(WaitForQueue(demuxer, 10));
+
+    // Nothing is read while paused, and nothing read before the seek is kept
+    demuxer.Pause();
+    int seek = count;
+    demuxer.Flush();
+    std::this_thread::sleep_for(20ms);
+    QCOMPARE(count.load(), seek);
+
+    // Take resumes reading
+    QCOMPARE(demuxer.Take(packet, changed), 0);
+    QCOMPARE(packet->pts, static_cast<int64_t>(seek));
+    QCOMPARE(demuxer.Take(packet, changed), 0);
+    QCOMPARE(packet->pts, static_cast<int64_t>(seek + 1));
+
+    av_packet_free(&packet);
+}
+
+void TestDemuxer::TestStreamChange()
+{
+    std::atomic<int> count { 0 };
+    MythDemuxer *demuxer = nullptr;
+    auto read = [&count, &demuxer, reader = Reader(count)]
+        (AVPacket *Packet, std::chrono::milliseconds &Duration)
+    {
+        if (count == 5)
+            demuxer->StreamsChanged();
+        return reader(Packet, Duration);
+    };
+
+    demuxer = new MythDemuxer(read);
+    demuxer->start();
+
+    AVPacket *packet = av_packet_alloc();
+    bool changed = false;
+    for (int i = 0; i < 5; i++)
+    {
+        QCOMPARE(demuxer->Take(packet, changed), 0);
+        QVERIFY(!changed);
+    }
+
+    // The demuxer stops after the first packet read after the change
+    QCOMPARE(demuxer->Take(packet, changed), 0);
+    QCOMPARE(packet->pts, static_cast<int64_t>(5));
+    QVERIFY(changed);
+    QCOMPARE(demuxer->Take(packet, changed), AVERROR(EAGAIN));
+    QVERIFY(!changed);
+    QCOMPARE(count.load(), 6);
+
+    // Handling the change resumes reading from where it stopped
+    demuxer->ClearStreamChange();
+    QCOMPARE(demuxer->Take(packet, changed), 0);
+    QCOMPARE(packet->pts, static_cast<int64_t>(6));
+    QVERIFY(!changed);
+
+    demuxer->Flush();
+    QCOMPARE(demuxer->Take(packet, changed), 0);
+    QVERIFY(packet->pts > 6);
+    QVERIFY(!changed);
+
+    delete demuxer;
+    av_packet_free(&packet);
+}
+
+void TestDemuxer::TestKeepQueue()
+{
+    std::atomic<int> count { 0 };
+    AVPacket *packet = av_packet_alloc();
+    bool changed = false;
+
+    // A stream change found by the decoder rather than the demuxer keeps
+    // the packets already read
+    MythDemuxer demuxer(Reader(count), 100 * kPacketSize, 10 * kPacketDuration);
+    demuxer.start();
+    QVERIFY(WaitForQueue(demuxer, 10));
+    demuxer.Pause();
+    demuxer.ClearStreamChange();
+    for (int i = 0; i < 12; i++)
+    {
+        QCOMPARE(demuxer.Take(packet, changed), 0);
+        QCOMPARE(packet->pts, static_cast<int64_t>(i));
+    }
+
+    av_packet_free(&packet);
+}
+
+void TestDemuxer::TestError()
+{
+    std::atomic<int> count { 0 };
+    std::atomic<bool> eof { false };
+    auto read = [&eof, reader = Reader(count)]
+        (AVPacket *Packet, std::chrono::milliseconds &Duration)
+    {
+        return eof ? AVERROR_EOF : reader(Packet, Duration);
+    };
+
+    MythDemuxer demuxer(read);
+    AVPacket *packet = av_packet_alloc();
+    bool changed = false;
+
+    // Queued packets are returned before the error
+    demuxer.start();
+    QVERIFY(WaitForQueue(demuxer, static_cast<size_t>(MythDemuxer::kMaxDuration / kPacketDuration)));
+    eof = true;
+    int queued = count;
+    for (int i = 0; i < queued; i++)
+        QCOMPARE(demuxer.Take(packet, changed), 0);
+    QCOMPARE(demuxer.Take(packet, changed), AVERROR_EOF);
+    QCOMPARE(demuxer.Take(packet, changed), AVERROR_EOF);
+
+    // e.g. when a recording has grown
+    eof = false;
+    demuxer.ClearError();
+    QCOMPARE(demuxer.Take(packet, changed), 0);
+    QCOMPARE(packet->pts, static_cast<int64_t>(queued));
+
+    av_packet_free(&packet);
+}
+
+QTEST_APPLESS_MAIN(TestDemuxer)
@@ -0,0 +1,65 @@
+#include "test_mythfilebuffer.h"
+#include "mythcorecontext.h"
+#include "io/mythmediabuffer.h"
+
+// Std
+#include <memory>
+#include <vector>
+
+// Qt
+#include <QTemporaryDir>
+
+static constexpr int kFileSize  { 8 * 1024 * 1024 };
+static constexpr int kReadSize  { 1024 * 1024 };
+
+static char Pattern(int Position)
+{
+    return static_cast<char>(Position % 251);
+}
+
+void TestMythFileBuffer::initTestCase()
+{
+    gCoreContext = new MythCoreContext("bin_version", nullptr);
+    gCoreContext->OverrideSettingForSession("FileBufferMemoryMap", "1");
+}
+
+/*
+ * Cutting a file back underneath the mapping makes the next read fail,
+ * as read() would, instead of killing the player with SIGBUS.
+*/
+void TestMythFileBuffer::TestTruncatedWhileMapped()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString filename = dir.filePath("truncated.ts");
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    std::vector<char> data(kFileSize);
+    for (int i = 0; i < kFileSize; i++)
+        data[static_cast<size_t>(i)] = Pattern(i);
+    QCOMPARE(file.write(data.data(), kFileSize), static_cast<qint64>(kFileSize));
+    QVERIFY(file.flush());
+
+    std::unique_ptr<MythMediaBuffer> buffer(MythMediaBuffer::Create(filename, false));
+    QVERIFY(buffer);
+    QVERIFY(buffer->IsOpen());
+    // a finished recording, so don't wait for it to grow
+    buffer->SetOldFile(true);
+
+    std::vector<char> read(kReadSize);
+    QCOMPARE(buffer->Read(read.data(), kReadSize), kReadSize);
+    for (int i = 0; i < kReadSize; i++)
+        QCOMPARE(read[static_cast<size_t>(i)], Pattern(i));
+
+    QFile maps("/proc/self/maps");
+    if (maps.open(QIODevice::ReadOnly))
+        QVERIFY(maps.readAll().contains(filename.toLocal8Bit()));
+
+    // the rest of the file is still mapped, but no longer there
+    QVERIFY(file.resize(kReadSize));
+    QVERIFY(buffer->Read(read.data(), kReadSize) <= 0);
+    QCOMPARE(buffer->Read(read.data(), kReadSize), 0);
+}
+
+QTEST_APPLESS_MAIN(TestMythFileBuffer)
@@ -0,0 +1,100 @@
+#include "test_playbacktimings.h"
+#include "mythplaybacktimings.h"
+
+// Std
+#include <thread>
+
+void TestPlaybackTimings::TestSummary()
+{
+    MythPlaybackTimings timings;
+    MythPlaybackTimings::Summary summary = timings.GetSummary(MythPlaybackTimings::kSeek);
+    QCOMPARE(summary.m_count, static_cast<size_t>(0));
+
+    timings.Add(MythPlaybackTimings::kSeek, 300ms);
+    timings.Add(MythPlaybackTimings::kSeek, 100ms);
+    timings.Add(MythPlaybackTimings::kSeek, 200ms);
+    summary = timings.GetSummary(MythPlaybackTimings::kSeek);
+    QCOMPARE(summary.m_count, static_cast<size_t>(3));
+    QCOMPARE(summary.m_last.count(), std::chrono::milliseconds(200).count());
+    QCOMPARE(summary.m_min.count(), std::chrono::milliseconds(100).count());
+    QCOMPARE(summary.m_mean.count(), std::chrono::milliseconds(200).count());
+    QCOMPARE(summary.m_max.count(), std::chrono::milliseconds(300).count());
+    QCOMPARE(summary.m_p50.count(), std::chrono::milliseconds(200).count());
+    QCOMPARE(summary.m_p95.count(), std::chrono::milliseconds(300).count());
+
+    // Nothing recorded for start up
+    summary = timings.GetSummary(MythPlaybackTimings::kStartup);
+    QCOMPARE(summary.m_count, static_cast<size_t>(0));
+    QCOMPARE(summary.m_p95.count(), std::chrono::milliseconds(0).count());
+}
+
+void TestPlaybackTimings::TestPercentiles()
+{
+    // Nearest rank, whatever order the times arrive in
+    MythPlaybackTimings timings;
+    for (int i = 100; i > 0; i--)
+        timings.Add(MythPlaybackTimings::kSeek, std::chrono::milliseconds(i));
+    MythPlaybackTimings::Summary summary = timings.GetSummary(MythPlaybackTimings::kSeek);
+    QCOMPARE(summary.m_last.count(), std::chrono::milliseconds(1).count());
+    QCOMPARE(summary.m_p50.count(), std::chrono::milliseconds(50).count());
+    QCOMPARE(summary.m_p90.count(), std::chrono::milliseconds(90).count());
+    QCOMPARE(summary.m_p95.count(), std::chrono::milliseconds(95).count());
+    QCOMPARE(summary.m_max.count(), std::chrono::milliseconds(100).count());
+}
+
+void TestPlaybackTimings::TestHistory()
+{
+    MythPlaybackTimings timings;
+    timings.Add(MythPlaybackTimings::kStartup, 10s);
+    for (size_t i = 0; i < MythPlaybackTimings::kHistory; i++)
+        timings.Add(MythPlaybackTimings::kStartup, 1s);
+
+    // Only the last kHistory are kept
+    MythPlaybackTimings::Summary summary = timings.GetSummary(MythPlaybackTimings::kStartup);
+    QCOMPARE(summary.m_count, MythPlaybackTimings::kHistory);
+    QCOMPARE(summary.m_max.count(), std::chrono::milliseconds(1s).count());
+}
+
+void TestPlaybackTimings::TestStages()
+{
+    MythPlaybackTimings timings;
+
+    // Not timing anything
+    timings.Stage("FileOpened");
+    timings.Displayed();
+    QCOMPARE(timings.GetSummary(MythPlaybackTimings::kStartup).m_count, static_cast<size_t>(0));
+
+    // A seek while starting up is part of the start up
+    timings.Begin(MythPlaybackTimings::kStartup);
+    timings.Stage("FileOpened");
+    timings.Begin(MythPlaybackTimings::kSeek);
+    std::this_thread::sleep_for(20ms);
+    timings.Displayed();
+    timings.Displayed();
+
+    MythPlaybackTimings::Summary summary = timings.GetSummary(MythPlaybackTimings::kStartup);
+    QCOMPARE(summary.m_count, static_cast<size_t>(1));
+    QVERIFY(summary.m_last >= 20ms);
+    QCOMPARE(timings.GetSummary(MythPlaybackTimings::kSeek).m_count, static_cast<size_t>(0));
+
+    auto stages = timings.GetLastStages(MythPlaybackTimings::kStartup);
+    QCOMPARE(stages.size(), static_cast<size_t>(3));
+    QCOMPARE(stages[0].first, QString("FileOpened"));
+    QCOMPARE(stages[1].first, QString("SeekRequested"));
+    QCOMPARE(stages[2].first, QString("FirstFrame"));
+    QVERIFY(stages[2].second >= 20ms);
+    QVERIFY(timings.GetLastStages(MythPlaybackTimings::kSeek).empty());
+
+    // A cancelled seek is not recorded
+    timings.Begin(MythPlaybackTimings::kSeek);
+    timings.Cancel();
+    timings.Displayed();
+    QCOMPARE(timings.GetSummary(MythPlaybackTimings::kSeek).m_count, static_cast<size_t>(0));
+
+    timings.Begin(MythPlaybackTimings::kSeek);
+    timings.Stage("SeekDone");
+    timings.Displayed();
+    QCOMPARE(timings.GetSummary(MythPlaybackTimings::kSeek).m_count, static_cast<size_t>(1));
+}
+
+QTEST_APPLESS_MAIN(TestPlaybackTimings)
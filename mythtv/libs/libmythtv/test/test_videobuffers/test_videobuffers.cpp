@@ -0,0 +1,164 @@
+#include "test_videobuffers.h"
+#include "videobuffers.h"
+
+// Std
+#include <atomic>
+#include <deque>
+#include <thread>
+
+static constexpr uint kNumBuffers { 12 };
+
+static void CreateBuffers(VideoBuffers &Buffers)
+{
+    Buffers.Init(kNumBuffers, 1, 4, 2);
+    QVERIFY(Buffers.CreateBuffers(FMT_YV12, 64, 64, nullptr));
+    QCOMPARE(Buffers.FreeVideoFrames(), kNumBuffers);
+}
+
+void TestVideoBuffers::TestStates()
+{
+    VideoBuffers buffers;
+    CreateBuffers(buffers);
+
+    MythVideoFrame *frame = buffers.GetNextFreeFrame();
+    QVERIFY(frame);
+    frame->m_directRendering = false;
+    QVERIFY(buffers.Contains(kVideoBuffer_limbo, frame));
+    QVERIFY(!buffers.Contains(kVideoBuffer_avail, frame));
+    QCOMPARE(buffers.Size(kVideoBuffer_limbo), 1U);
+    QCOMPARE(buffers.FreeVideoFrames(), kNumBuffers - 1);
+
+    buffers.ReleaseFrame(frame);
+    QVERIFY(buffers.Contains(kVideoBuffer_used, frame));
+    QCOMPARE(buffers.Size(kVideoBuffer_limbo), 0U);
+    QCOMPARE(buffers.ValidVideoFrames(), 1U);
+    QCOMPARE(buffers.GetLastDecodedFrame(), frame);
+
+    buffers.StartDisplayingFrame();
+    QCOMPARE(buffers.GetLastShownFrame(), frame);
+    buffers.DoneDisplayingFrame(frame);
+    QVERIFY(buffers.Contains(kVideoBuffer_avail, frame));
+    QCOMPARE(buffers.ValidVideoFrames(), 0U);
+    QCOMPARE(buffers.FreeVideoFrames(), kNumBuffers);
+
+    // Enqueue moves to the tail, SafeEnqueue also removes from other queues
+    buffers.Enqueue(kVideoBuffer_pause, frame);
+    QVERIFY(buffers.Contains(kVideoBuffer_avail, frame));
+    QVERIFY(buffers.Contains(kVideoBuffer_pause, frame));
+    buffers.SafeEnqueue(kVideoBuffer_pause, frame);
+    QVERIFY(!buffers.Contains(kVideoBuffer_avail, frame));
+    QCOMPARE(buffers.Tail(kVideoBuffer_pause), frame);
+    buffers.DiscardPauseFrames();
+    QCOMPARE(buffers.Size(kVideoBuffer_pause), 0U);
+    QCOMPARE(buffers.Tail(kVideoBuffer_avail), frame);
+    QCOMPARE(buffers.FreeVideoFrames(), kNumBuffers);
+}
+
+void TestVideoBuffers::TestDecoderReferences()
+{
+    VideoBuffers buffers;
+    CreateBuffers(buffers);
+
+    // A frame the decoder still references is not reused until it is released
+    MythVideoFrame *frame = buffers.GetNextFreeFrame();
+    frame->m_directRendering = true;
+    buffers.ReleaseFrame(frame);
+    QVERIFY(buffers.Contains(kVideoBuffer_decode, frame));
+    buffers.DoneDisplayingFrame(frame);
+    QVERIFY(buffers.Contains(kVideoBuffer_finished, frame));
+    QCOMPARE(buffers.FreeVideoFrames(), kNumBuffers - 1);
+
+    buffers.DeLimboFrame(frame);
+    QVERIFY(!buffers.Contains(kVideoBuffer_decode, frame));
+    // ...and returns to available on the next displayed frame
+    MythVideoFrame *next = buffers.GetNextFreeFrame();
+    QVERIFY(next != frame);
+    next->m_directRendering = false;
+    buffers.ReleaseFrame(next);
+    buffers.DoneDisplayingFrame(next);
+    QVERIFY(buffers.Contains(kVideoBuffer_avail, frame));
+    QCOMPARE(buffers.Size(kVideoBuffer_finished), 0U);
+    QCOMPARE(buffers.FreeVideoFrames(), kNumBuffers);
+}
+
+void TestVideoBuffers::TestStress()
+{
+    // Hand frames from a decoder thread to a display thread as fast as
+    // possible, with the decoder holding references to recent frames, and
+    // check that every frame is displayed, in order, and none are lost.
+    static constexpr long long kFrames { 200000 };
+    static constexpr size_t    kReferences { 3 };
+
+    VideoBuffers buffers;
+    CreateBuffers(buffers);
+    for (uint i = 0; i < buffers.Size(); i++)
+        buffers.At(i)->m_frameNumber = -1;
+    std::atomic<bool> failed { false };
+
+    std::thread decoder([&]()
+    {
+        std::deque<MythVideoFrame*> references;
+        for (long long i = 0; i < kFrames && !failed; i++)
+        {
+            while (!buffers.EnoughFreeFrames() && !failed)
+                std::this_thread::yield();
+
+            // A frame is only free once it has been displayed
+            MythVideoFrame *frame = buffers.GetNextFreeFrame();
+            if (!frame || frame->m_frameNumber != -1)
+            {
+                failed = true;
+                break;
+            }
+            frame->m_frameNumber = i;
+            frame->m_directRendering = (i % 2) == 0;
+            buffers.ReleaseFrame(frame);
+
+            if (frame->m_directRendering)
+            {
+                references.push_back(frame);
+                if (references.size() > kReferences)
+                {
+                    buffers.DeLimboFrame(references.front());
+                    references.pop_front();
+                }
+            }
+        }
+        for (auto * frame : references)
+            buffers.DeLimboFrame(frame);
+    });
+
+    long long expected = 0;
+    while (expected < kFrames && !failed)
+    {
+        if (!buffers.ValidVideoFrames())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        buffers.StartDisplayingFrame();
+        MythVideoFrame *frame = buffers.Head(kVideoBuffer_used);
+        if (!frame || frame->m_frameNumber != expected)
+        {
+            failed = true;
+            break;
+        }
+        frame->m_frameNumber = -1;
+        buffers.DoneDisplayingFrame(frame);
+        expected++;
+    }
+
+    decoder.join();
+    QVERIFY(!failed);
+    QCOMPARE(expected, kFrames);
+
+    // Decoder references released after the last frame was displayed are
+    // returned to available on the next DoneDisplayingFrame
+    QCOMPARE(buffers.Size(kVideoBuffer_used), 0U);
+    QCOMPARE(buffers.Size(kVideoBuffer_limbo), 0U);
+    QCOMPARE(buffers.Size(kVideoBuffer_decode), 0U);
+    QCOMPARE(buffers.Size(kVideoBuffer_avail) + buffers.Size(kVideoBuffer_finished), kNumBuffers);
+}
+
+QTEST_APPLESS_MAIN(TestVideoBuffers)
@@ -64,6 +64,7 @@
 #include "io/mythmediabuffer.h"
 #include "mythtvactionutils.h"
 #include "mythcodeccontext.h"
+#include "mythplaybacktimings.h"
 #include "tv_play.h"
 
 // Std
@@ -257,6 +258,7 @@ bool TV::CreatePlayer(TVState State, bool Muted)
     player->SetWatchingRecording(isWatchingRecording);
 
     m_playerContext.SetPlayer(player);
+    MythPlaybackTimings::Instance().Stage("PlayerCreated");
     emit InitialisePlayerState();
     m_player = player;
     return StartPlaying(-1ms);
@@ -274,6 +276,7 @@ bool TV::StartPlaying(std::chrono::milliseconds MaxWait)
 
     if (!m_player->StartPlaying())
     {
+        MythPlaybackTimings::Instance().Cancel();
         LOG(VB_GENERAL, LOG_ERR, LOC + "StartPlaying() Failed to start player");
         // no need to call StopPlaying here as the player context will be deleted
         // later following the error
@@ -291,11 +294,13 @@ bool TV::StartPlaying(std::chrono::milliseconds MaxWait)
 
     if (m_player->IsPlaying())
     {
+        MythPlaybackTimings::Instance().Stage("Playing");
         LOG(VB_PLAYBACK, LOG_INFO, LOC +
             QString("StartPlaying(): took %1 ms to start player.")
                 .arg(t.elapsed().count()));
         return true;
     }
+    MythPlaybackTimings::Instance().Cancel();
     LOG(VB_GENERAL, LOG_ERR, LOC + "StartPlaying() Failed to start player");
     m_playerContext.StopPlaying();
     return false;
@@ -2034,6 +2039,7 @@ void TV::HandleStateChange()
     bool ok = false;
     if (TRANSITION(kState_None, kState_WatchingLiveTV))
     {
+        MythPlaybackTimings::Instance().Begin(MythPlaybackTimings::kStartup);
         m_playerContext.m_lastSignalUIInfo.clear();
 
         m_playerContext.m_recorder->Setup();
@@ -2122,6 +2128,7 @@ void TV::HandleStateChange()
 
             if (m_playerContext.m_buffer)
                 m_playerContext.m_buffer->SetLiveMode(m_playerContext.m_tvchain);
+            MythPlaybackTimings::Instance().Stage("BufferOpened");
         }
 
 
@@ -2131,6 +2138,7 @@ void TV::HandleStateChange()
         }
         if (!ok)
         {
+            MythPlaybackTimings::Instance().Cancel();
             LOG(VB_GENERAL, LOG_ERR, LOC + "LiveTV not successfully started");
             MythMainWindow::RestoreScreensaver();
             m_playerContext.SetRecorder(nullptr);
@@ -2159,11 +2167,13 @@ void TV::HandleStateChange()
              TRANSITION(kState_None, kState_WatchingBD)    ||
              TRANSITION(kState_None, kState_WatchingRecording))
     {
+        MythPlaybackTimings::Instance().Begin(MythPlaybackTimings::kStartup);
         m_playerContext.LockPlayingInfo(__FILE__, __LINE__);
         QString playbackURL = m_playerContext.m_playingInfo->GetPlaybackURL(true);
         m_playerContext.UnlockPlayingInfo(__FILE__, __LINE__);
 
         MythMediaBuffer *buffer = MythMediaBuffer::Create(playbackURL, false);
+        MythPlaybackTimings::Instance().Stage("BufferOpened");
         if (buffer && !buffer->GetLastError().isEmpty())
         {
             ShowNotificationError(tr("Can't start playback"),
@@ -2215,6 +2225,7 @@ void TV::HandleStateChange()
 
         if (!ok)
         {
+            MythPlaybackTimings::Instance().Cancel();
             SET_LAST();
             SetErrored();
             if (m_playerContext.IsPlayerErrored())
@@ -5699,6 +5710,7 @@ void TV::SwitchInputs(uint ChanID, QString ChanNum, uint InputID)
 
         if (!ok)
         {
+            MythPlaybackTimings::Instance().Cancel();
             LOG(VB_GENERAL, LOG_ERR, LOC + "LiveTV not successfully started");
             MythMainWindow::RestoreScreensaver();
             m_playerContext.SetRecorder(nullptr);
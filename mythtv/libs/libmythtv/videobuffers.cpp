@@ -129,6 +129,13 @@ static inline void DoDiscard(const std::vector<AVBufferRef *> &Discards)
  *        decoder (in the decode queue) then it is placed in the finished queue
  *        until the decoder is no longer using it (not in the decode queue).
  *
+ *  Each buffer's state (the set of queues it is in) and the size of each queue
+ *  are also held atomically. Membership tests therefore do not have to search
+ *  the queues, and Contains(), Size() and the EnoughFreeFrames() type checks
+ *  polled by the player do not take the lock at all. The queues themselves are
+ *  only needed for ordering and are only changed, under the lock, by Push()
+ *  and Pull().
+ *
  * \see VideoOutput
  */
 
@@ -179,12 +186,17 @@ void VideoBuffers::Init(uint NumDecode, uint NeedFree,
 
     Reset();
 
+    if (NumDecode > kMaxBuffers)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, QString("Limiting video buffers to %1 (from %2)")
+            .arg(kMaxBuffers).arg(NumDecode));
+        NumDecode = kMaxBuffers;
+    }
+
     // make a big reservation, so that things that depend on
     // pointer to VideoFrames work even after a few push_backs
-    m_buffers.reserve(std::max(NumDecode, 128U));
+    m_buffers.reserve(kMaxBuffers);
     m_buffers.resize(NumDecode);
-    for (uint i = 0; i < NumDecode; i++)
-        m_vbufferMap[At(i)] = i;
 
     m_needFreeFrames            = NeedFree;
     m_needPrebufferFrames       = NeedPrebufferNormal;
@@ -271,7 +283,10 @@ void VideoBuffers::Reset()
     m_decode.clear();
     m_pause.clear();
     m_displayed.clear();
-    m_vbufferMap.clear();
+    for (auto & state : m_states)
+        state = 0;
+    for (auto & size : m_sizes)
+        size = 0;
 }
 
 /**
@@ -288,25 +303,37 @@ MythVideoFrame *VideoBuffers::GetNextFreeFrameInternal(BufferType EnqueueTo)
 {
     QMutexLocker locker(&m_globalLock);
     MythVideoFrame *frame = nullptr;
+    MythVideoFrame *fallback = nullptr;
 
     // Try to get a frame not being used by the decoder
-    for (size_t i = 0; i < m_available.size(); i++)
+    for (size_t i = 0; i < m_available.size(); )
     {
-        frame = m_available.dequeue();
-        if (m_decode.contains(frame))
-            m_available.enqueue(frame);
-        else
+        MythVideoFrame *next = m_available[i];
+        uint state = State(next);
+        if (state & kVideoBuffer_used)
+        {
+            LOG(VB_PLAYBACK, LOG_NOTICE,
+                QString("GetNextFreeFrame() served a busy frame %1. Dropping. %2")
+                    .arg(DebugString(next, true)).arg(GetStatus()));
+            Pull(kVideoBuffer_avail, next);
+            continue;
+        }
+
+        if (!(state & kVideoBuffer_decode))
+        {
+            frame = next;
             break;
-    }
+        }
 
-    while (frame && m_used.contains(frame))
-    {
-        LOG(VB_PLAYBACK, LOG_NOTICE,
-            QString("GetNextFreeFrame() served a busy frame %1. Dropping. %2")
-                .arg(DebugString(frame, true)).arg(GetStatus()));
-        frame = m_available.dequeue();
+        if (!fallback)
+            fallback = next;
+        i++;
     }
 
+    // Otherwise fall back to one the decoder still references
+    if (!frame)
+        frame = fallback;
+
     if (frame)
         SafeEnqueue(EnqueueTo, frame);
     return frame;
@@ -361,12 +388,15 @@ void VideoBuffers::ReleaseFrame(MythVideoFrame *Frame)
 {
     QMutexLocker locker(&m_globalLock);
 
-    m_vpos = m_vbufferMap[Frame];
-    m_limbo.remove(Frame);
+    int index = FrameIndex(Frame);
+    if (index < 0)
+        return;
+    m_vpos = static_cast<uint>(index);
+    Pull(kVideoBuffer_limbo, Frame);
     //non directrendering frames are ffmpeg handled
     if (Frame->m_directRendering)
-        m_decode.enqueue(Frame);
-    m_used.enqueue(Frame);
+        Push(kVideoBuffer_decode, Frame);
+    Push(kVideoBuffer_used, Frame);
 }
 
 /**
@@ -380,20 +410,18 @@ void VideoBuffers::DeLimboFrame(MythVideoFrame *Frame)
 
     m_globalLock.lock();
 
-    if (m_limbo.contains(Frame))
-        m_limbo.remove(Frame);
+    Pull(kVideoBuffer_limbo, Frame);
 
     // if decoder didn't release frame and the buffer is getting released by
     // the decoder assume that the frame is lost and return to available
-    if (!m_decode.contains(Frame))
+    if (!(State(Frame) & kVideoBuffer_decode))
     {
         ReleaseDecoderResources(Frame, discards);
         SafeEnqueue(kVideoBuffer_avail, Frame);
     }
 
     // remove from decode queue since the decoder is finished
-    while (m_decode.contains(Frame))
-        m_decode.remove(Frame);
+    Pull(kVideoBuffer_decode, Frame);
 
     m_globalLock.unlock();
 
@@ -407,7 +435,7 @@ void VideoBuffers::DeLimboFrame(MythVideoFrame *Frame)
 void VideoBuffers::StartDisplayingFrame(void)
 {
     QMutexLocker locker(&m_globalLock);
-    m_rpos = m_vbufferMap[m_used.head()];
+    m_rpos = static_cast<uint>(std::max(FrameIndex(m_used.head()), 0));
 }
 
 /**
@@ -420,21 +448,21 @@ void VideoBuffers::DoneDisplayingFrame(MythVideoFrame *Frame)
 
     m_globalLock.lock();
 
-    if(m_used.contains(Frame))
-        Remove(kVideoBuffer_used, Frame);
-
-    Enqueue(kVideoBuffer_finished, Frame);
+    Pull(kVideoBuffer_used, Frame);
+    Push(kVideoBuffer_finished, Frame);
 
     // check if any finished frames are no longer used by decoder and return to available
-    frame_queue_t ula(m_finished);
-    for (auto & it : ula)
+    for (size_t i = 0; i < m_finished.size(); )
     {
-        if (!m_decode.contains(it))
+        MythVideoFrame *frame = m_finished[i];
+        if (State(frame) & kVideoBuffer_decode)
         {
-            Remove(kVideoBuffer_finished, it);
-            ReleaseDecoderResources(it, discards);
-            Enqueue(kVideoBuffer_avail, it);
+            i++;
+            continue;
         }
+        Pull(kVideoBuffer_finished, frame);
+        ReleaseDecoderResources(frame, discards);
+        Push(kVideoBuffer_avail, frame);
     }
 
     m_globalLock.unlock();
@@ -514,8 +542,7 @@ bool VideoBuffers::DiscardAndRecreate(MythCodecID CodecID, QSize VideoDim, int R
     {
         for (uint i = 0; i < Size(); i++)
         {
-            if (!m_available.contains(At(i)) && !m_pause.contains(At(i)) &&
-                !m_displayed.contains(At(i)))
+            if (!(State(At(i)) & (kVideoBuffer_avail | kVideoBuffer_pause | kVideoBuffer_displayed)))
             {
                 LOG(VB_GENERAL, LOG_INFO,
                     QString("VideoBuffers::DiscardFrames(): %1 (%2) not "
@@ -528,11 +555,14 @@ bool VideoBuffers::DiscardAndRecreate(MythCodecID CodecID, QSize VideoDim, int R
         }
     }
 
-    for (auto & it : m_decode)
+    frame_queue_t decode(m_decode);
+    for (auto & it : decode)
         Remove(kVideoBuffer_all, it);
-    for (auto & it : m_decode)
-        m_available.enqueue(it);
-    m_decode.clear();
+    for (auto & it : decode)
+    {
+        Push(kVideoBuffer_avail, it);
+        Pull(kVideoBuffer_decode, it);
+    }
 
     Reset();
 
@@ -625,6 +655,72 @@ const frame_queue_t *VideoBuffers::Queue(BufferType Type) const
     return queue;
 }
 
+uint VideoBuffers::QueueIndex(BufferType Type)
+{
+    switch (Type)
+    {
+        case kVideoBuffer_avail:     return 0;
+        case kVideoBuffer_limbo:     return 1;
+        case kVideoBuffer_used:      return 2;
+        case kVideoBuffer_pause:     return 3;
+        case kVideoBuffer_displayed: return 4;
+        case kVideoBuffer_finished:  return 5;
+        case kVideoBuffer_decode:    return 6;
+        default: break;
+    }
+    return kNumQueues;
+}
+
+/// \return the index of Frame in m_buffers, or -1 if it is not one of ours
+int VideoBuffers::FrameIndex(const MythVideoFrame *Frame) const
+{
+    if (!Frame || m_buffers.empty())
+        return -1;
+    ptrdiff_t index = Frame - m_buffers.data();
+    if (index < 0 || index >= static_cast<ptrdiff_t>(m_buffers.size()))
+        return -1;
+    return static_cast<int>(index);
+}
+
+/// \return the BufferType bits of the queues Frame is in
+uint VideoBuffers::State(const MythVideoFrame *Frame) const
+{
+    int index = FrameIndex(Frame);
+    return index < 0 ? 0 : m_states[static_cast<uint>(index)].load();
+}
+
+/*! \brief Moves Frame to the tail of the queue for Type.
+ *
+ * \note Only changes the given queue. Call with the lock held.
+*/
+void VideoBuffers::Push(BufferType Type, MythVideoFrame *Frame)
+{
+    int index = FrameIndex(Frame);
+    frame_queue_t *queue = Queue(Type);
+    if (index < 0 || !queue)
+        return;
+    if (m_states[static_cast<uint>(index)] & Type)
+        queue->remove(Frame);
+    queue->enqueue(Frame);
+    m_states[static_cast<uint>(index)] |= Type;
+    m_sizes[QueueIndex(Type)] = static_cast<uint>(queue->size());
+}
+
+/*! \brief Removes Frame from the queue for Type, if it is in it.
+ *
+ * \note Call with the lock held.
+*/
+void VideoBuffers::Pull(BufferType Type, MythVideoFrame *Frame)
+{
+    int index = FrameIndex(Frame);
+    frame_queue_t *queue = Queue(Type);
+    if (index < 0 || !queue || !(m_states[static_cast<uint>(index)] & Type))
+        return;
+    queue->remove(Frame);
+    m_states[static_cast<uint>(index)] &= ~static_cast<uint>(Type);
+    m_sizes[QueueIndex(Type)] = static_cast<uint>(queue->size());
+}
+
 MythVideoFrame* VideoBuffers::At(uint FrameNum)
 {
     return &m_buffers[FrameNum];
@@ -641,7 +737,9 @@ MythVideoFrame *VideoBuffers::Dequeue(BufferType Type)
     frame_queue_t *queue = Queue(Type);
     if (!queue)
         return nullptr;
-    return queue->dequeue();
+    MythVideoFrame *frame = queue->head();
+    Pull(Type, frame);
+    return frame;
 }
 
 MythVideoFrame *VideoBuffers::Head(BufferType Type)
@@ -670,15 +768,10 @@ void VideoBuffers::Enqueue(BufferType Type, MythVideoFrame *Frame)
 {
     if (!Frame)
         return;
-    frame_queue_t *queue = Queue(Type);
-    if (!queue)
-        return;
-    m_globalLock.lock();
-    queue->remove(Frame);
-    queue->enqueue(Frame);
+    QMutexLocker locker(&m_globalLock);
+    Push(Type, Frame);
     if (Type == kVideoBuffer_pause)
         Frame->m_pauseFrame = true;
-    m_globalLock.unlock();
 }
 
 void VideoBuffers::Remove(BufferType Type, MythVideoFrame *Frame)
@@ -687,20 +780,13 @@ void VideoBuffers::Remove(BufferType Type, MythVideoFrame *Frame)
         return;
 
     QMutexLocker locker(&m_globalLock);
-    if ((Type & kVideoBuffer_avail) == kVideoBuffer_avail)
-        m_available.remove(Frame);
-    if ((Type & kVideoBuffer_used) == kVideoBuffer_used)
-        m_used.remove(Frame);
-    if ((Type & kVideoBuffer_displayed) == kVideoBuffer_displayed)
-        m_displayed.remove(Frame);
-    if ((Type & kVideoBuffer_limbo) == kVideoBuffer_limbo)
-        m_limbo.remove(Frame);
-    if ((Type & kVideoBuffer_pause) == kVideoBuffer_pause)
-        m_pause.remove(Frame);
-    if ((Type & kVideoBuffer_decode) == kVideoBuffer_decode)
-        m_decode.remove(Frame);
-    if ((Type & kVideoBuffer_finished) == kVideoBuffer_finished)
-        m_finished.remove(Frame);
+    uint state = State(Frame) & static_cast<uint>(Type);
+    for (uint bit = kVideoBuffer_avail; state; bit <<= 1)
+    {
+        if (state & bit)
+            Pull(static_cast<BufferType>(bit), Frame);
+        state &= ~bit;
+    }
 }
 
 void VideoBuffers::SafeEnqueue(BufferType Type, MythVideoFrame* Frame)
@@ -738,22 +824,17 @@ frame_queue_t::iterator VideoBuffers::End(BufferType Type)
     return (queue ? queue->end() : m_available.end());
 }
 
+/// \note Does not take the lock.
 uint VideoBuffers::Size(BufferType Type) const
 {
-    QMutexLocker locker(&m_globalLock);
-    const frame_queue_t *queue = Queue(Type);
-    if (queue)
-        return queue->size();
-    return 0;
+    uint index = QueueIndex(Type);
+    return index < kNumQueues ? m_sizes[index].load() : 0;
 }
 
+/// \note Does not take the lock.
 bool VideoBuffers::Contains(BufferType Type, MythVideoFrame *Frame) const
 {
-    QMutexLocker locker(&m_globalLock);
-    const frame_queue_t *queue = Queue(Type);
-    if (queue)
-        return queue->contains(Frame);
-    return false;
+    return (State(Frame) & static_cast<uint>(Type)) != 0;
 }
 
 MythVideoFrame* VideoBuffers::GetLastDecodedFrame(void)
@@ -850,8 +931,7 @@ void VideoBuffers::DiscardFrames(bool NextFrameIsKeyFrame)
     {
         for (uint i = 0; i < Size(); i++)
         {
-            if (!m_available.contains(At(i)) && !m_pause.contains(At(i)) &&
-                !m_displayed.contains(At(i)))
+            if (!(State(At(i)) & (kVideoBuffer_avail | kVideoBuffer_pause | kVideoBuffer_displayed)))
             {
                 // This message is DEBUG because it does occur
                 // after Reset is called.
@@ -870,11 +950,14 @@ void VideoBuffers::DiscardFrames(bool NextFrameIsKeyFrame)
 
     // Make sure frames used by decoder are last...
     // This is for libmpeg2 which still uses the frames after a reset.
-    for (it = m_decode.begin(); it != m_decode.end(); ++it)
+    frame_queue_t decode(m_decode);
+    for (it = decode.begin(); it != decode.end(); ++it)
         Remove(kVideoBuffer_all, *it);
-    for (it = m_decode.begin(); it != m_decode.end(); ++it)
-        m_available.enqueue(*it);
-    m_decode.clear();
+    for (it = decode.begin(); it != decode.end(); ++it)
+    {
+        Push(kVideoBuffer_avail, *it);
+        Pull(kVideoBuffer_decode, *it);
+    }
 
     LOG(VB_PLAYBACK, LOG_INFO,
         QString("VideoBuffers::DiscardFrames(%1): %2 -- done")
@@ -904,10 +987,10 @@ void VideoBuffers::ClearAfterSeek(void)
         for (uint i = 0; (i < Size()) && (m_used.count() > 1); i++)
         {
             MythVideoFrame *buffer = At(i);
-            if (m_used.contains(buffer) && !m_decode.contains(buffer))
+            if ((State(buffer) & (kVideoBuffer_used | kVideoBuffer_decode)) == kVideoBuffer_used)
             {
-                m_used.remove(buffer);
-                m_available.enqueue(buffer);
+                Pull(kVideoBuffer_used, buffer);
+                Push(kVideoBuffer_avail, buffer);
                 ReleaseDecoderResources(buffer, discards);
             }
         }
@@ -917,12 +1000,12 @@ void VideoBuffers::ClearAfterSeek(void)
             for (uint i = 0; i < Size(); i++)
             {
                 MythVideoFrame *buffer = At(i);
-                if (m_used.contains(buffer) && !m_decode.contains(buffer))
+                if ((State(buffer) & (kVideoBuffer_used | kVideoBuffer_decode)) == kVideoBuffer_used)
                 {
-                    m_used.remove(buffer);
-                    m_available.enqueue(buffer);
+                    Pull(kVideoBuffer_used, buffer);
+                    Push(kVideoBuffer_avail, buffer);
                     ReleaseDecoderResources(buffer, discards);
-                    m_vpos = m_vbufferMap[buffer];
+                    m_vpos = i;
                     m_rpos = m_vpos;
                     break;
                 }
@@ -13,12 +13,12 @@
 #include "mythcodecid.h"
 
 // Std
+#include <array>
+#include <atomic>
 #include <vector>
-#include <map>
 
 using frame_queue_t  = MythDeque<MythVideoFrame*> ;
 using frame_vector_t = std::vector<MythVideoFrame>;
-using vbuffer_map_t  = std::map<const MythVideoFrame*, uint>;
 
 const QString& DebugString(const MythVideoFrame *Frame, bool Short = false);
 const QString& DebugString(uint  FrameNum, bool Short = false);
@@ -94,8 +94,16 @@ class MTV_PUBLIC VideoBuffers
     QString GetStatus(uint Num = 0) const;
 
   private:
+    static constexpr uint kMaxBuffers { 128 };
+    static constexpr uint kNumQueues  { 7 };
+
     frame_queue_t       *Queue(BufferType Type);
     const frame_queue_t *Queue(BufferType Type) const;
+    static uint          QueueIndex(BufferType Type);
+    int                  FrameIndex(const MythVideoFrame *Frame) const;
+    uint                 State(const MythVideoFrame *Frame) const;
+    void                 Push(BufferType Type, MythVideoFrame *Frame);
+    void                 Pull(BufferType Type, MythVideoFrame *Frame);
     MythVideoFrame      *GetNextFreeFrameInternal(BufferType EnqueueTo);
     static void          SetDeinterlacingFlags(MythVideoFrame &Frame, MythDeintType Single,
                                                MythDeintType Double, MythCodecID CodecID);
@@ -107,8 +115,11 @@ class MTV_PUBLIC VideoBuffers
     frame_queue_t        m_displayed;
     frame_queue_t        m_decode;
     frame_queue_t        m_finished;
-    vbuffer_map_t        m_vbufferMap;
     frame_vector_t       m_buffers;
+    /// BufferType bits for the queues each buffer is in
+    std::array<std::atomic<uint>,kMaxBuffers> m_states {};
+    /// Size of each queue, by QueueIndex
+    std::array<std::atomic<uint>,kNumQueues>  m_sizes  {};
     const VideoFrameTypes* m_renderFormats { nullptr };
 
     uint                 m_needFreeFrames            { 0 };
@@ -5,6 +5,7 @@
 
 #include "filetransfer.h"
 #include "io/mythmediabuffer.h"
+#include "mthread.h"
 #include "mythdate.h"
 #include "mythsocket.h"
 #include "programinfo.h"
@@ -19,7 +20,13 @@ FileTransfer::FileTransfer(QString &filename, MythSocket *remote,
     m_pginfo = new ProgramInfo(filename);
     m_pginfo->MarkAsInUse(true, kFileTransferInUseID);
     if (m_rbuffer && m_rbuffer->IsOpen())
-        m_rbuffer->Start();
+    {
+        // Local files are sent with sendfile(), leaving read ahead to
+        // the kernel, rather than copied through our read ahead buffer.
+        m_sendDirect = m_rbuffer->CanSendDirect();
+        if (!m_sendDirect)
+            m_rbuffer->Start();
+    }
 }
 
 FileTransfer::FileTransfer(QString &filename, MythSocket *remote, bool write) :
@@ -80,6 +87,7 @@ void FileTransfer::Stop(void)
         LOG(VB_FILE, LOG_INFO, "calling StopReads()");
         if (m_rbuffer)
             m_rbuffer->StopReads();
+        StopStream();
         QMutexLocker locker(&m_lock);
         m_readsLocked = true;
     }
@@ -137,26 +145,157 @@ int FileTransfer::RequestBlock(int size)
     {
         int request = size - tot;
 
-        ret = m_rbuffer->Read(buf, request);
+        ret = SendBlock(buf, request);
+
+        if (ret > 0)
+            tot += ret;
 
         if (m_rbuffer->GetStopReads() || ret <= 0)
             break;
 
-        if (m_sock->Write(buf, (uint)ret) != ret)
+        if (ret < request)
+            break; // we hit eof
+    }
+
+    if (m_pginfo)
+        m_pginfo->UpdateInUseMark();
+
+    return (ret < 0) ? -1 : tot;
+}
+
+/** \brief Sends up to size bytes from the current position to the client.
+ *
+ *  Local files go straight from the page cache to the socket, so first
+ *  flush anything still queued in Qt's buffer by MythSocket::Write(),
+ *  which would otherwise arrive after the file data.
+ *
+ *  \param buf scratch buffer of at least size bytes, when copying
+ *  \return bytes sent, 0 at the end of the file or -1 on error
+ */
+int FileTransfer::SendBlock(char *buf, int size)
+{
+    if (m_sendDirect)
+    {
+        if (!m_sock->Flush())
+            return -1;
+        return m_rbuffer->SendDirect(m_sock->GetSocketDescriptor(), size);
+    }
+
+    int ret = m_rbuffer->Read(buf, size);
+    if (ret <= 0 || m_rbuffer->GetStopReads())
+        return std::min(ret, 0);
+
+    if (m_sock->Write(buf, (uint)ret) != ret)
+        return -1;
+
+    return ret;
+}
+
+/** \brief Switches to streaming the file to the client.
+ *
+ *  Rather than waiting for a REQUEST_BLOCK per block, which caps the
+ *  throughput at one block per round trip, a stream thread pushes data
+ *  down the socket from the current position for as long as the client
+ *  has credit, and the client grants more with StreamCredit() as it
+ *  consumes it.
+ *
+ *  \return the window granted, or -1 if the file can not be streamed.
+ */
+int FileTransfer::RequestStream(int window)
+{
+    if (m_writemode || !m_readthreadlive || !m_rbuffer || m_streamThread)
+        return -1;
+
+    window = RemoteStreamWindow::ClampWindow(window);
+    {
+        QMutexLocker locker(&m_streamLock);
+        m_stream.Start(window);
+        m_ateof = false;
+    }
+
+    LOG(VB_FILE, LOG_INFO, QString("Streaming %1 with a %2 KiB window")
+        .arg(GetFileName()).arg(window / 1024));
+
+    m_streaming = true;
+    m_streamThread = new MThread("FileTransferStream", this);
+    m_streamThread->start();
+    return window;
+}
+
+/** \brief Grants the stream size more bytes of credit.
+ *  \param ateof set if the last read hit the end of the file
+ *  \return bytes streamed so far
+ */
+long long FileTransfer::StreamCredit(int size, bool &ateof)
+{
+    QMutexLocker locker(&m_streamLock);
+    m_stream.Grant(std::max(size, 0));
+    m_streamCond.wakeAll();
+    ateof = m_ateof;
+    return m_stream.GetPosition();
+}
+
+void FileTransfer::run(void)
+{
+    std::vector<char> buf(kStreamBlockSize);
+
+    while (m_streaming && m_readthreadlive)
+    {
+        int request = 0;
+        {
+            QMutexLocker locker(&m_streamLock);
+            if (m_stream.Credit() <= 0 || m_ateof)
+                m_streamCond.wait(&m_streamLock, 100 /*ms*/);
+            request = std::min(m_stream.Credit(), kStreamBlockSize);
+        }
+        if (request <= 0)
+            continue;
+
+        // Holding m_lock while sending means a seek, which pauses
+        // first, sees a consistent count of the bytes streamed.
+        QMutexLocker locker(&m_lock);
+        if (m_readsLocked)
+        {
+            m_readsUnlockedCond.wait(&m_lock, 100 /*ms*/);
+            continue;
+        }
+
+        int ret = SendBlock(buf.data(), request);
+        if (ret < 0)
         {
-            tot = -1;
+            LOG(VB_GENERAL, LOG_ERR, QString("Streaming %1 failed")
+                .arg(GetFileName()));
+            m_streaming = false;
             break;
         }
 
-        tot += ret;
-        if (ret < request)
-            break; // we hit eof
+        QMutexLocker slocker(&m_streamLock);
+        if (ret > 0)
+        {
+            m_stream.Advance(ret);
+            m_ateof = false;
+        }
+        else if (!m_rbuffer->GetStopReads())
+        {
+            // Keep polling, a recording in progress may still grow
+            m_ateof = true;
+        }
     }
 
     if (m_pginfo)
         m_pginfo->UpdateInUseMark();
+}
 
-    return (ret < 0) ? -1 : tot;
+void FileTransfer::StopStream(void)
+{
+    if (!m_streamThread)
+        return;
+
+    m_streaming = false;
+    m_streamCond.wakeAll();
+    m_streamThread->wait();
+    delete m_streamThread;
+    m_streamThread = nullptr;
 }
 
 int FileTransfer::WriteBlock(int size)
@@ -220,7 +359,13 @@ int FileTransfer::WriteBlock(int size)
     return (ret < 0) ? -1 : tot;
 }
 
-long long FileTransfer::Seek(long long curpos, long long pos, int whence)
+/** \brief Seeks the file.
+ *  \param streamed when streaming, set to the bytes streamed before the
+ *         seek, which the client must discard. The stream then restarts
+ *         from the new position with a full window of credit.
+ */
+long long FileTransfer::Seek(long long curpos, long long pos, int whence,
+                             long long *streamed)
 {
     if (m_pginfo)
         m_pginfo->UpdateInUseMark();
@@ -230,8 +375,6 @@ long long FileTransfer::Seek(long long curpos, long long pos, int whence)
     if (!m_readthreadlive)
         return -1;
 
-    m_ateof = false;
-
     Pause();
 
     if (whence == SEEK_CUR)
@@ -244,6 +387,17 @@ long long FileTransfer::Seek(long long curpos, long long pos, int whence)
 
     long long ret = m_rbuffer->Seek(pos, whence);
 
+    {
+        QMutexLocker locker(&m_streamLock);
+        m_ateof = false;
+        if (m_streaming)
+        {
+            m_stream.Start(m_stream.GetWindow(), m_stream.GetPosition());
+            if (streamed)
+                *streamed = m_stream.GetPosition();
+        }
+    }
+
     Unpause();
 
     if (m_pginfo)
@@ -7,17 +7,20 @@
 
 // Qt headers
 #include <QMutex>
+#include <QRunnable>
 #include <QWaitCondition>
 
 // MythTV headers
 #include "referencecounter.h"
+#include "remotestreamwindow.h"
 
 class ProgramInfo;
 class MythMediaBuffer;
 class MythSocket;
+class MThread;
 class QString;
 
-class FileTransfer : public ReferenceCounter
+class FileTransfer : public ReferenceCounter, public QRunnable
 {
     friend class QObject; // quiet OSX gcc warning
 
@@ -37,8 +40,11 @@ class FileTransfer : public ReferenceCounter
     void Unpause(void);
     int RequestBlock(int size);
     int WriteBlock(int size);
+    int RequestStream(int window);
+    long long StreamCredit(int size, bool &ateof);
 
-    long long Seek(long long curpos, long long pos, int whence);
+    long long Seek(long long curpos, long long pos, int whence,
+                   long long *streamed = nullptr);
 
     uint64_t GetFileSize(void);
     QString GetFileName(void);
@@ -48,6 +54,12 @@ class FileTransfer : public ReferenceCounter
   private:
    ~FileTransfer() override;
 
+    void run(void) override; // QRunnable
+    int  SendBlock(char *buf, int size);
+    void StopStream(void);
+
+    static constexpr int kStreamBlockSize { 128 * 1024 };
+
     volatile bool   m_readthreadlive    {true};
     bool            m_readsLocked       {false};
     QWaitCondition  m_readsUnlockedCond;
@@ -56,12 +68,20 @@ class FileTransfer : public ReferenceCounter
     MythMediaBuffer* m_rbuffer          {nullptr};
     MythSocket     *m_sock              {nullptr};
     bool            m_ateof             {false};
+    bool            m_sendDirect        {false};
 
     std::vector<char> m_requestBuffer;
 
     QMutex          m_lock              {QMutex::NonRecursive};
 
     bool            m_writemode         {false};
+
+    // Streaming, see RequestStream()
+    MThread        *m_streamThread      {nullptr};
+    volatile bool   m_streaming         {false};
+    QMutex          m_streamLock;
+    QWaitCondition  m_streamCond;
+    RemoteStreamWindow m_stream;        // protected by m_streamLock
 };
 
 #endif
@@ -2491,6 +2491,7 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     nameFilters.push_back(fInfo.fileName() + ".old");
     nameFilters.push_back(fInfo.fileName() + ".map");
     nameFilters.push_back(fInfo.fileName() + ".tmp.map");
+    nameFilters.push_back(fInfo.fileName() + ".seekidx");
     nameFilters.push_back(fInfo.baseName() + ".srt");  // e.g. 1234_20150213165800.srt
 
     QDir dir (fInfo.path());
@@ -7102,14 +7103,31 @@ void MainServer::HandleFileTransferQuery(QStringList &slist,
 
         retlist << QString::number(ft->WriteBlock(size));
     }
+    else if (command == "REQUEST_STREAM")
+    {
+        int window = slist[2].toInt();
+
+        retlist << QString::number(ft->RequestStream(window));
+    }
+    else if (command == "STREAM_CREDIT")
+    {
+        int size = slist[2].toInt();
+        bool ateof = false;
+
+        retlist << QString::number(ft->StreamCredit(size, ateof));
+        retlist << QString::number(static_cast<int>(ateof));
+    }
     else if (command == "SEEK")
     {
         long long pos = slist[2].toLongLong();
         int whence = slist[3].toInt();
         long long curpos = slist[4].toLongLong();
+        long long streamed = -1;
 
-        long long ret = ft->Seek(curpos, pos, whence);
+        long long ret = ft->Seek(curpos, pos, whence, &streamed);
         retlist << QString::number(ret);
+        if (streamed >= 0)
+            retlist << QString::number(streamed);
     }
     else if (command == "IS_OPEN")
     {
@@ -152,11 +152,16 @@ AudioConfigSettings::AudioConfigSettings()
 
     StandardSetting *srcqualityoverride = SRCQualityOverride();
     srcqualityoverride->addTargetedChild("1", SRCQuality());
+    srcqualityoverride->addTargetedChild("1", SRCResampler());
     addChild(srcqualityoverride);
 
     advancedSettings->addChild(Audio48kOverride());
 #if USING_ALSA
     advancedSettings->addChild(SPDIFRateOverride());
+
+    StandardSetting *alsammap = ALSAMMap();
+    alsammap->addTargetedChild("1", ALSALatencyTarget());
+    advancedSettings->addChild(alsammap);
 #endif
 
     advancedSettings->addChild(HBRPassthrough());
@@ -1199,6 +1204,23 @@ HostComboBoxSetting *AudioConfigSettings::SRCQuality()
     return gc;
 }
 
+HostComboBoxSetting *AudioConfigSettings::SRCResampler()
+{
+    auto *gc = new HostComboBoxSetting("SRCResampler", false);
+
+    gc->setLabel(tr("Sample rate converter"));
+
+    gc->addSelection("libsamplerate", "0", true); // default
+    gc->addSelection("FFmpeg swresample", "1");
+
+    gc->setHelpText(tr("Select the library used for audio sample-rate "
+                       "conversion. FFmpeg swresample uses much less CPU, "
+                       "which helps when resampling multichannel or high "
+                       "sample rate audio on low powered systems."));
+
+    return gc;
+}
+
 HostCheckBoxSetting *AudioConfigSettings::Audio48kOverride()
 {
     auto *gc = new HostCheckBoxSetting("Audio48kOverride");
@@ -1265,6 +1287,37 @@ HostCheckBoxSetting *AudioConfigSettings::SPDIFRateOverride()
     return gc;
 }
 
+HostCheckBoxSetting *AudioConfigSettings::ALSAMMap()
+{
+    auto *gc = new HostCheckBoxSetting("ALSAMMap");
+
+    gc->setLabel(tr("ALSA mmap output"));
+
+    gc->setValue(false);
+
+    gc->setHelpText(tr("ALSA only. Write audio directly into the sound "
+                       "card's buffer, one period at a time, with the buffer "
+                       "sized from the latency target below. Lowers latency "
+                       "and CPU use. Devices without mmap support use normal "
+                       "writes. (default is not checked)"));
+    return gc;
+}
+
+HostSpinBoxSetting *AudioConfigSettings::ALSALatencyTarget()
+{
+    auto *gs = new HostSpinBoxSetting("ALSALatencyTarget", 20, 500, 10);
+
+    gs->setLabel(tr("ALSA latency target (ms)"));
+
+    gs->setValue(100);
+
+    gs->setHelpText(tr("Length of the sound card buffer with mmap output. "
+                       "It is split into four periods. Lower values reduce "
+                       "audio latency but may cause dropouts on a busy "
+                       "system. (default is 100)"));
+    return gs;
+}
+
 HostCheckBoxSetting *AudioConfigSettings::HBRPassthrough()
 {
     auto *gc = new HostCheckBoxSetting("HBRPassthru");
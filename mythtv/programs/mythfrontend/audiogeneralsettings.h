@@ -80,10 +80,13 @@ class AudioConfigSettings : public GroupSetting
     static HostCheckBoxSetting *MPCM();
     static HostCheckBoxSetting *SRCQualityOverride();
     static HostComboBoxSetting *SRCQuality();
+    static HostComboBoxSetting *SRCResampler();
     static HostCheckBoxSetting *Audio48kOverride();
     static HostCheckBoxSetting *PassThroughOverride();
     static HostComboBoxSetting *PassThroughOutputDevice();
     static HostCheckBoxSetting *SPDIFRateOverride();
+    static HostCheckBoxSetting *ALSAMMap();
+    static HostSpinBoxSetting  *ALSALatencyTarget();
     static HostCheckBoxSetting *HBRPassthrough();
 
     bool                CheckPassthrough();
@@ -71,6 +71,37 @@ static HostSpinBoxSetting *AudioReadAhead()
     return gc;
 }
 
+static HostCheckBoxSetting *FileBufferMemoryMap()
+{
+    auto *gc = new HostCheckBoxSetting("FileBufferMemoryMap");
+
+    gc->setLabel(PlaybackSettings::tr("Memory map local recordings"));
+
+    gc->setValue(false);
+
+    gc->setHelpText(PlaybackSettings::tr(
+        "Read local files directly from the operating system's file cache "
+        "instead of through the playback read ahead buffer. This saves a "
+        "copy of everything played, but a slow or busy disk may cause "
+        "stuttering. Not used for Live TV."));
+    return gc;
+}
+
+static HostCheckBoxSetting *DecoderDemuxThread()
+{
+    auto *gc = new HostCheckBoxSetting("DecoderDemuxThread");
+
+    gc->setLabel(PlaybackSettings::tr("Read ahead on a separate demux thread"));
+
+    gc->setValue(false);
+
+    gc->setHelpText(PlaybackSettings::tr(
+        "Read and demultiplex the next few seconds of a video on a thread "
+        "of its own, so that slow storage does not hold up decoding. Not "
+        "used for Live TV, DVDs or Blu-rays."));
+    return gc;
+}
+
 static HostComboBoxSetting *ColourPrimaries()
 {
     auto *gc = new HostComboBoxSetting("ColourPrimariesMode");
@@ -4341,6 +4372,8 @@ void PlaybackSettings::Load(void)
     advanced->setLabel(tr("Advanced Playback Settings"));
     advanced->addChild(RealtimePriority());
     advanced->addChild(AudioReadAhead());
+    advanced->addChild(FileBufferMemoryMap());
+    advanced->addChild(DecoderDemuxThread());
     advanced->addChild(ColourPrimaries());
     advanced->addChild(ChromaUpsampling());
 #ifdef USING_VAAPI
@@ -17,6 +17,7 @@
 #include "mythversion.h"
 #include "mythuiactions.h"              // for ACTION_HANDLEMEDIA, etc
 #include "tv_actions.h"                 // for ACTION_JUMPCHAPTER, etc
+#include "mythplaybacktimings.h"
 
 #include "videometadatalistmanager.h"
 #include "videometadata.h"
@@ -253,6 +254,38 @@ QStringList Frontend::GetContextList(void)
     return gActionDescriptions.keys();
 }
 
+DTC::PlaybackTimingList* Frontend::GetPlaybackTimings(void)
+{
+    auto *list = new DTC::PlaybackTimingList();
+    MythPlaybackTimings &timings = MythPlaybackTimings::Instance();
+
+    for (int i = 0; i < MythPlaybackTimings::kEventCount; i++)
+    {
+        auto event = static_cast<MythPlaybackTimings::Event>(i);
+        MythPlaybackTimings::Summary summary = timings.GetSummary(event);
+
+        DTC::PlaybackTiming *timing = list->AddNewPlaybackTiming();
+        timing->setEvent(MythPlaybackTimings::EventToString(event));
+        timing->setCount(static_cast<int>(summary.m_count));
+        timing->setLast(static_cast<int>(summary.m_last.count()));
+        timing->setMin(static_cast<int>(summary.m_min.count()));
+        timing->setMean(static_cast<int>(summary.m_mean.count()));
+        timing->setMax(static_cast<int>(summary.m_max.count()));
+        timing->setP50(static_cast<int>(summary.m_p50.count()));
+        timing->setP90(static_cast<int>(summary.m_p90.count()));
+        timing->setP95(static_cast<int>(summary.m_p95.count()));
+
+        for (const auto & stage : timings.GetLastStages(event))
+        {
+            DTC::LabelValue *value = timing->AddNewStage();
+            value->setLabel(stage.first);
+            value->setValue(QString::number(stage.second.count()));
+        }
+    }
+
+    return list;
+}
+
 DTC::FrontendActionList* Frontend::GetActionList(const QString &lContext)
 {
     auto *list = new DTC::FrontendActionList();
@@ -44,6 +44,7 @@ class Frontend : public FrontendServices
     static bool          IsValidAction(const QString &action);
     static void          InitialiseActions(void);
     bool                 SendKey(const QString &Key) override; // FrontendServices
+    DTC::PlaybackTimingList* GetPlaybackTimings(void) override; // FrontendServices
 
   protected:
     static QStringList gActionList;
@@ -301,6 +301,19 @@ static GlobalSpinBoxSetting *HDRingbufferSize()
     return bs;
 }
 
+static GlobalCheckBoxSetting *SeekIndexDBMirror()
+{
+    auto *gc = new GlobalCheckBoxSetting("SeekIndexDBMirror");
+    gc->setLabel(QObject::tr("Save seek tables to the database"));
+    gc->setValue(true);
+    gc->setHelpText(QObject::tr("Recorders always write a seek index file "
+                    "next to each recording, which local playback reads "
+                    "directly. If enabled, the seek table is also saved to "
+                    "the database, which remote frontends and some tools "
+                    "still require."));
+    return gc;
+}
+
 static GlobalComboBoxSetting *StorageScheduler()
 {
     auto *gc = new GlobalComboBoxSetting("StorageScheduler");
@@ -929,6 +942,7 @@ BackendSettings::BackendSettings()
     fm->addChild(DeletesFollowLinks());
     fm->addChild(TruncateDeletes());
     fm->addChild(HDRingbufferSize());
+    fm->addChild(SeekIndexDBMirror());
     fm->addChild(StorageScheduler());
     group2->addChild(fm);
     auto* upnp = new GroupSetting();
@@ -757,6 +757,7 @@ void strings_null() {
     ThemeUI::tr("Delete Your Hardware Profile");
     ThemeUI::tr("Delete system Profile");
     ThemeUI::tr("Delete your hardware profile");
+    ThemeUI::tr("Demux queue :");
     ThemeUI::tr("Description");
     ThemeUI::tr("Description:");
     ThemeUI::tr("Description: %DESCRIPTION%\nErrata: %ERRATA%");